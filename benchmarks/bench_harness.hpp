@@ -0,0 +1,213 @@
+#pragma once // Zabezpieczenie przed wielokrotnym dołączeniem
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// --- PROSTA UPRZĘŻ POMIAROWA ---
+//
+// Każdy pomiar składa się z rozgrzewki i serii powtórzeń. Jedno powtórzenie wywołuje mierzoną funkcję
+// tyle razy, aby trwało co najmniej `min_sample_ns` (liczba wywołań jest ustalana raz, podczas
+// kalibracji), więc czas pojedynczej operacji nie jest zdominowany przez rozdzielczość zegara.
+// Wyniki są zbierane w serie (ta sama funkcja, rosnący parametr), dla których szacowany jest
+// wykładnik skalowania czasu względem parametru.
+
+namespace bench {
+
+// Zapobiega usunięciu wyniku przez optymalizator
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct Config {
+    int warmup = 2;                   // Liczba powtórzeń rozgrzewkowych (nie wliczane do statystyk)
+    int repetitions = 15;             // Liczba mierzonych powtórzeń
+    double min_sample_ns = 2.0e6;     // Minimalny czas jednego powtórzenia [ns]
+    std::string filter;               // Uruchamiane są tylko serie, których nazwa zawiera ten tekst
+};
+
+struct Measurement {
+    std::string series;               // Nazwa serii (np. "gauss_elimination")
+    std::string parameter;            // Nazwa parametru (np. "n")
+    double value = 0.0;               // Wartość parametru
+    std::int64_t iterations = 0;      // Wywołania w jednym powtórzeniu
+    int repetitions = 0;
+    double min_ns = 0.0;              // Statystyki czasu jednej operacji [ns]
+    double mean_ns = 0.0;
+    double median_ns = 0.0;
+    double p10_ns = 0.0;
+    double p90_ns = 0.0;
+    double max_ns = 0.0;
+};
+
+struct SeriesSummary {
+    std::string series;
+    std::string parameter;
+    double exponent = 0.0;            // Nachylenie log(mediana) względem log(parametr)
+    bool has_exponent = false;        // Co najmniej dwa punkty o różnych parametrach
+};
+
+// Percentyl z interpolacją liniową (dane posortowane rosnąco)
+inline double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    const double pos = q * static_cast<double>(sorted.size() - 1);
+    const std::size_t lo = static_cast<std::size_t>(pos);
+    const std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (pos - static_cast<double>(lo)) * (sorted[hi] - sorted[lo]);
+}
+
+// Wartość parametru bez notacji wykładniczej dla liczb całkowitych
+inline std::string format_value(double value) {
+    std::ostringstream os;
+    os << std::setprecision(12) << value;
+    return os.str();
+}
+
+class Runner {
+public:
+    explicit Runner(Config config) : config_(std::move(config)) {}
+
+    bool enabled(const std::string& series) const {
+        return config_.filter.empty() || series.find(config_.filter) != std::string::npos;
+    }
+
+    // Mierzy `op` (jedno wywołanie = jedna operacja) dla punktu (series, parameter = value)
+    void run(const std::string& series, const std::string& parameter, double value, const std::function<void()>& op) {
+        if (!enabled(series)) return;
+        using clock = std::chrono::steady_clock;
+        auto time_batch = [&op](std::int64_t count) {
+            const auto start = clock::now();
+            for (std::int64_t i = 0; i < count; ++i) op();
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+        };
+
+        // Kalibracja: podwajanie liczby wywołań aż jedno powtórzenie trwa min_sample_ns
+        std::int64_t iterations = 1;
+        double elapsed = time_batch(iterations);
+        while (elapsed < config_.min_sample_ns && iterations < (std::int64_t(1) << 40)) {
+            const double target = elapsed > 0.0 ? config_.min_sample_ns / elapsed * 1.2 : 2.0;
+            iterations = std::max(iterations * 2, static_cast<std::int64_t>(static_cast<double>(iterations) * std::min(target, 100.0)));
+            elapsed = time_batch(iterations);
+        }
+
+        for (int w = 0; w < config_.warmup; ++w) time_batch(iterations);
+        std::vector<double> samples;
+        samples.reserve(static_cast<std::size_t>(config_.repetitions));
+        for (int r = 0; r < config_.repetitions; ++r) {
+            samples.push_back(time_batch(iterations) / static_cast<double>(iterations));
+        }
+        std::sort(samples.begin(), samples.end());
+
+        Measurement m;
+        m.series = series;
+        m.parameter = parameter;
+        m.value = value;
+        m.iterations = iterations;
+        m.repetitions = config_.repetitions;
+        m.min_ns = samples.front();
+        m.max_ns = samples.back();
+        double sum = 0.0;
+        for (double s : samples) sum += s;
+        m.mean_ns = sum / static_cast<double>(samples.size());
+        m.median_ns = percentile(samples, 0.5);
+        m.p10_ns = percentile(samples, 0.1);
+        m.p90_ns = percentile(samples, 0.9);
+        results_.push_back(m);
+
+        std::cerr << std::left << std::setw(34) << series << std::right << std::setw(4) << parameter << " = "
+                  << std::setw(10) << format_value(value) << "  median " << std::setw(14) << std::fixed << std::setprecision(1)
+                  << m.median_ns << " ns/op" << std::defaultfloat << std::endl;
+    }
+
+    const std::vector<Measurement>& results() const { return results_; }
+
+    // Wykładnik skalowania z dopasowania prostej (najmniejsze kwadraty) w skali log-log
+    std::vector<SeriesSummary> summaries() const {
+        std::vector<SeriesSummary> out;
+        for (const Measurement& m : results_) {
+            auto it = std::find_if(out.begin(), out.end(), [&m](const SeriesSummary& s) { return s.series == m.series; });
+            if (it == out.end()) out.push_back({m.series, m.parameter, 0.0, false});
+        }
+        for (SeriesSummary& s : out) {
+            double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+            int count = 0;
+            for (const Measurement& m : results_) {
+                if (m.series != s.series || m.value <= 0.0 || m.median_ns <= 0.0) continue;
+                const double lx = std::log(m.value), ly = std::log(m.median_ns);
+                sx += lx; sy += ly; sxx += lx * lx; sxy += lx * ly;
+                ++count;
+            }
+            const double denom = count * sxx - sx * sx;
+            if (count >= 2 && denom > 1e-12) {
+                s.exponent = (count * sxy - sx * sy) / denom;
+                s.has_exponent = true;
+            }
+        }
+        return out;
+    }
+
+    void write_csv(std::ostream& os) const {
+        os << "series,parameter,value,iterations,repetitions,min_ns,mean_ns,median_ns,p10_ns,p90_ns,max_ns\n";
+        os << std::setprecision(6);
+        for (const Measurement& m : results_) {
+            os << m.series << ',' << m.parameter << ',' << m.value << ',' << m.iterations << ',' << m.repetitions << ','
+               << m.min_ns << ',' << m.mean_ns << ',' << m.median_ns << ',' << m.p10_ns << ',' << m.p90_ns << ','
+               << m.max_ns << '\n';
+        }
+    }
+
+    void write_json(std::ostream& os) const {
+        os << std::setprecision(6) << "{\n  \"benchmarks\": [\n";
+        for (std::size_t i = 0; i < results_.size(); ++i) {
+            const Measurement& m = results_[i];
+            os << "    {\"series\": \"" << m.series << "\", \"parameter\": \"" << m.parameter << "\", \"value\": " << m.value
+               << ", \"iterations\": " << m.iterations << ", \"repetitions\": " << m.repetitions
+               << ", \"min_ns\": " << m.min_ns << ", \"mean_ns\": " << m.mean_ns << ", \"median_ns\": " << m.median_ns
+               << ", \"p10_ns\": " << m.p10_ns << ", \"p90_ns\": " << m.p90_ns << ", \"max_ns\": " << m.max_ns << "}"
+               << (i + 1 < results_.size() ? "," : "") << "\n";
+        }
+        os << "  ],\n  \"scaling\": [\n";
+        const std::vector<SeriesSummary> sums = summaries();
+        for (std::size_t i = 0; i < sums.size(); ++i) {
+            os << "    {\"series\": \"" << sums[i].series << "\", \"parameter\": \"" << sums[i].parameter << "\", \"exponent\": ";
+            if (sums[i].has_exponent) os << sums[i].exponent; else os << "null";
+            os << "}" << (i + 1 < sums.size() ? "," : "") << "\n";
+        }
+        os << "  ]\n}\n";
+    }
+
+    void write_table(std::ostream& os) const {
+        os << std::left << std::setw(34) << "series" << std::right << std::setw(6) << "param" << std::setw(12) << "value"
+           << std::setw(14) << "median[ns]" << std::setw(14) << "p10[ns]" << std::setw(14) << "p90[ns]" << '\n';
+        os << std::fixed << std::setprecision(1);
+        for (const Measurement& m : results_) {
+            os << std::left << std::setw(34) << m.series << std::right << std::setw(6) << m.parameter << std::setw(12)
+               << format_value(m.value) << std::setw(14) << m.median_ns << std::setw(14) << m.p10_ns
+               << std::setw(14) << m.p90_ns << '\n';
+        }
+        os << "\nSkalowanie (czas ~ parametr^k):\n" << std::setprecision(2);
+        for (const SeriesSummary& s : summaries()) {
+            if (s.has_exponent) os << "  " << std::left << std::setw(34) << s.series << " k = " << s.exponent << '\n';
+        }
+        os << std::defaultfloat;
+    }
+
+private:
+    Config config_;
+    std::vector<Measurement> results_;
+};
+
+} // namespace bench
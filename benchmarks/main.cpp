@@ -0,0 +1,239 @@
+#include "bench_harness.hpp" // Uprząż pomiarowa (rozgrzewka, powtórzenia, percentyle)
+
+// Dołączamy nagłówki mierzonych modułów biblioteki
+#include "NumLibCpp/linear_solver.hpp"
+#include "NumLibCpp/interpolation.hpp"
+#include "NumLibCpp/approximation.hpp"
+#include "NumLibCpp/integration.hpp"
+#include "NumLibCpp/differentialEquations_solver.hpp"
+#include "NumLibCpp/nonlinear_solver.hpp"
+#include "NumLibCpp/differentiation.hpp"
+#include "NumLibCpp/eigen_solver.hpp"
+#include "NumLibCpp/finite_difference.hpp"
+#include "NumLibCpp/workspace.hpp"
+#include <cerrno>
+#include <climits>
+#include <cstdlib> // Dla std::strtol
+#include <fstream>
+#include <random>
+
+// Program: numlib_bench [--format=table|csv|json] [--output=PLIK] [--filter=TEKST] [--repetitions=N] [--quick]
+//
+// Postęp jest wypisywany na stderr, a raport (domyślnie tabela) na stdout lub do pliku --output.
+
+namespace {
+
+// Macierz diagonalnie dominująca o ustalonym ziarnie - eliminacja bez problemów z uwarunkowaniem
+std::vector<std::vector<double>> random_matrix(int n, bool symmetric) {
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<std::vector<double>> A(n, std::vector<double>(n));
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) A[i][j] = dist(gen);
+        A[i][i] += n;
+    }
+    if (symmetric) {
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < i; ++j) A[i][j] = A[j][i];
+    }
+    return A;
+}
+
+void register_benchmarks(bench::Runner& runner) {
+    // --- Algebra liniowa ---
+    for (int n : {16, 32, 64, 128, 256}) {
+        const std::vector<std::vector<double>> A = random_matrix(n, false);
+        const std::vector<double> b(n, 1.0);
+        runner.run("gauss_elimination", "n", n, [&] { bench::do_not_optimize(NumLibCpp::gauss_elimination(A, b)); });
+        runner.run("gauss_elimination/Parallel", "n", n, [&] {
+            bench::do_not_optimize(NumLibCpp::gauss_elimination(A, b, NumLibCpp::ExecutionPolicy::Parallel));
+        });
+        NumLibCpp::Workspace ws;
+        std::vector<double> x;
+        runner.run("gauss_elimination/Workspace", "n", n, [&] {
+            NumLibCpp::gauss_elimination(A, b, x, ws);
+            bench::do_not_optimize(x.data());
+        });
+    }
+
+    // --- Interpolacja (węzły Czebyszewa) ---
+    for (int nodes : {4, 8, 16, 32, 64}) {
+        std::vector<double> x(nodes), y(nodes);
+        for (int i = 0; i < nodes; ++i) {
+            x[i] = std::cos(M_PI * (2.0 * i + 1.0) / (2.0 * nodes));
+            y[i] = std::sin(3.0 * x[i]);
+        }
+        double t = 0.123;
+        runner.run("lagrange_interpolate", "n", nodes, [&] {
+            bench::do_not_optimize(NumLibCpp::lagrange_interpolate(x, y, t));
+        });
+        // 10000 punktów naraz (postać barycentryczna) - sekwencyjnie i z wektoryzacją po punktach
+        std::vector<double> points(10000);
+        for (std::size_t i = 0; i < points.size(); ++i) points[i] = -1.0 + 2.0 * i / (points.size() - 1);
+        runner.run("lagrange_batch", "n", nodes, [&] {
+            bench::do_not_optimize(NumLibCpp::lagrange_interpolate(x, y, points));
+        });
+        runner.run("lagrange_batch/ParallelSimd", "n", nodes, [&] {
+            bench::do_not_optimize(NumLibCpp::lagrange_interpolate(x, y, points, NumLibCpp::ExecutionPolicy::ParallelSimd));
+        });
+    }
+
+    // --- Całkowanie ---
+    for (int n : {100, 1000, 10000, 100000}) {
+        runner.run("simpson_integrate", "n", n, [n] {
+            bench::do_not_optimize(NumLibCpp::simpson_integrate([](double x) { return std::exp(-x * x); }, 0.0, 2.0, n));
+        });
+        // Ta sama całka przez wersję z std::function (wywołanie pośrednie na każdą próbkę)
+        const std::function<double(double)> wrapped = [](double x) { return std::exp(-x * x); };
+        runner.run("simpson_integrate/std::function", "n", n, [n, &wrapped] {
+            bench::do_not_optimize(NumLibCpp::simpson_integrate(wrapped, 0.0, 2.0, n));
+        });
+        for (auto policy : {NumLibCpp::ExecutionPolicy::Parallel, NumLibCpp::ExecutionPolicy::ParallelSimd}) {
+            const char* name = policy == NumLibCpp::ExecutionPolicy::Parallel ? "simpson_integrate/Parallel"
+                                                                              : "simpson_integrate/ParallelSimd";
+            runner.run(name, "n", n, [n, policy] {
+                bench::do_not_optimize(
+                    NumLibCpp::simpson_integrate([](double x) { return std::exp(-x * x); }, 0.0, 2.0, n, policy));
+            });
+        }
+    }
+
+    // --- Aproksymacja ---
+    for (int degree : {2, 4, 8, 12}) {
+        runner.run("polynomial_approximation", "deg", degree, [degree] {
+            bench::do_not_optimize(
+                NumLibCpp::polynomial_approximation([](double x) { return std::exp(x); }, -1.0, 1.0, degree, 1000));
+        });
+    }
+
+    // --- Równania różniczkowe ---
+    for (int steps : {100, 1000, 10000, 100000}) {
+        runner.run("rk4_solve", "n", steps, [steps] {
+            bench::do_not_optimize(NumLibCpp::rk4_solve([](double t, double y) { return -y + std::sin(t); }, 0.0, 1.0, 10.0, steps));
+        });
+    }
+
+    // --- Równania nieliniowe (parametr: liczba cyfr tolerancji) ---
+    for (int digits : {4, 8, 12}) {
+        const double tol = std::pow(10.0, -digits);
+        runner.run("secant_method", "tol", digits, [tol] {
+            bench::do_not_optimize(NumLibCpp::secant_method([](double x) { return std::cos(x) - x; }, 0.0, 1.0, tol, 100));
+        });
+        runner.run("brent_method", "tol", digits, [tol] {
+            bench::do_not_optimize(NumLibCpp::brent_method([](double x) { return std::cos(x) - x; }, 0.0, 1.0, tol, 100));
+        });
+    }
+    for (int count : {1000, 10000, 100000}) {
+        std::vector<double> lower(count, 0.0), upper(count, 2.0);
+        std::vector<double> targets(count);
+        for (int i = 0; i < count; ++i) targets[i] = 0.1 + 0.9 * i / count;
+        NumLibCpp::BatchRootFunction f = [&targets](const double* x, const size_t* index, double* fx, size_t m) {
+            for (size_t k = 0; k < m; ++k) fx[k] = x[k] * x[k] * x[k] + x[k] - targets[index[k]];
+        };
+        runner.run("chandrupatla_batch", "n", count, [&] {
+            bench::do_not_optimize(NumLibCpp::chandrupatla_batch(f, lower, upper, NumLibCpp::BatchRootOptions{}));
+        });
+    }
+
+    // --- Różniczkowanie ---
+    {
+        double x = 0.7;
+        runner.run("central_difference", "n", 1, [&x] {
+            bench::do_not_optimize(NumLibCpp::central_difference([](double t) { return std::sin(t) * std::exp(t); }, x, 1e-5));
+        });
+    }
+    for (int n : {1000, 10000, 100000, 1000000}) {
+        NumLibCpp::FiniteDifferenceStencil d2(static_cast<size_t>(n), 1.0 / n, 2, 4);
+        std::vector<double> u(n), out(n);
+        for (int i = 0; i < n; ++i) u[i] = std::sin(static_cast<double>(i) / n);
+        runner.run("FiniteDifferenceStencil::apply", "n", n, [&] {
+            d2.apply(u.data(), out.data());
+            bench::do_not_optimize(out[0]);
+        });
+    }
+
+    // --- Wartości własne ---
+    for (int n : {16, 32, 64, 128}) {
+        const std::vector<std::vector<double>> A = random_matrix(n, true);
+        runner.run("symmetric_eigen", "n", n, [&] { bench::do_not_optimize(NumLibCpp::symmetric_eigen(A)); });
+    }
+}
+
+bool starts_with(const std::string& s, const std::string& prefix) {
+    return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+// Liczba całkowita zajmująca cały napis i mieszcząca się w int; w przeciwnym razie false
+bool parse_int(const std::string& s, int& value) {
+    if (s.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    const long parsed = std::strtol(s.c_str(), &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Config config;
+    std::string format = "table";
+    std::string output;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        int repetitions = 0;
+        if (starts_with(arg, "--format=")) {
+            format = arg.substr(9);
+        } else if (starts_with(arg, "--output=")) {
+            output = arg.substr(9);
+        } else if (starts_with(arg, "--filter=")) {
+            config.filter = arg.substr(9);
+        } else if (starts_with(arg, "--repetitions=") && parse_int(arg.substr(14), repetitions) && repetitions >= 1) {
+            config.repetitions = repetitions;
+        } else if (arg == "--quick") {
+            config.warmup = 1;
+            config.repetitions = 5;
+            config.min_sample_ns = 2.0e5;
+        } else {
+            std::cerr << "Nieznany argument: " << arg << std::endl
+                      << "Uzycie: numlib_bench [--format=table|csv|json] [--output=PLIK] [--filter=TEKST]"
+                         " [--repetitions=N] [--quick]" << std::endl;
+            return 1;
+        }
+    }
+    if (format != "table" && format != "csv" && format != "json") {
+        std::cerr << "Nieznany format: " << format << std::endl;
+        return 1;
+    }
+
+    bench::Runner runner(config);
+    try {
+        register_benchmarks(runner);
+    } catch (const std::exception& e) {
+        std::cerr << "Blad podczas pomiaru: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+        if (!file) {
+            std::cerr << "Nie mozna otworzyc pliku: " << output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = output.empty() ? std::cout : file;
+    if (format == "csv") {
+        runner.write_csv(os);
+    } else if (format == "json") {
+        runner.write_json(os);
+    } else {
+        runner.write_table(os);
+    }
+    return 0;
+}
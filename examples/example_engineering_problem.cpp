@@ -57,5 +57,31 @@ int main() {
     }
     std::cout << std::endl;
 
+    // 2. Przegląd parametrów: wiele par (k, T_env, T0) całkowanych jednocześnie
+    std::cout << "2. Przeglad parametrow chlodzenia (zespol trajektorii):" << std::endl;
+    const std::size_t num_cases = 10000;
+    std::vector<double> k_values(num_cases), T_env_values(num_cases), T0_values(num_cases);
+    for (std::size_t i = 0; i < num_cases; ++i) {
+        k_values[i] = 0.01 + 0.09 * static_cast<double>(i % 100) / 99.0;
+        T_env_values[i] = 10.0 + static_cast<double>((i / 100) % 10) * 2.0;
+        T0_values[i] = 80.0 + static_cast<double>(i / 1000) * 5.0;
+    }
+    auto ensemble_rhs = [&](double t, const double* T, double* dT, std::size_t first, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            dT[i] = cooling_law(t, T[i], k_values[first + i], T_env_values[first + i]);
+        }
+    };
+    try {
+        std::vector<double> T_sweep = NumLibCpp::rk4_solve_ensemble(ensemble_rhs, 0.0, T0_values, time_target, num_steps);
+        std::cout << "   Liczba przypadkow: " << num_cases << std::endl;
+        for (std::size_t i : {std::size_t(0), num_cases / 2, num_cases - 1}) {
+            std::cout << "   k = " << k_values[i] << ", T_env = " << T_env_values[i] << ", T0 = " << T0_values[i]
+                      << " -> T(" << time_target << ") = " << T_sweep[i] << " C" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "   Blad przegladu parametrow: " << e.what() << std::endl;
+    }
+    std::cout << std::endl;
+
     return 0;
 }
@@ -5,6 +5,14 @@
 #include <utility>   // Dla std::pair
 #include <functional> // Dla std::function
 #include <stdexcept> // Dla std::invalid_argument, std::runtime_error
+#include <string>
+#include <cmath>     // Dla std::pow
+#include <type_traits>
+#include "NumLibCpp/execution.hpp"
+#include "NumLibCpp/integration.hpp"   // Dla simpson_integrate
+#include "NumLibCpp/linear_solver.hpp" // Dla gauss_elimination
+#include "NumLibCpp/workspace.hpp"
+#include "NumLibCpp/instrumentation.hpp"
 
 namespace NumLibCpp {
     
@@ -80,6 +88,208 @@ std::vector<double> polynomial_approximation(
     int num_simpson_intervals
 );
 
+/**
+ * @brief Wariant `polynomial_approximation` z wyborem sposobu wykonania.
+ *
+ * W trybach równoległych niezależne całki macierzy A i wektora d są rozdzielane między wątki puli,
+ * a układ równań jest rozwiązywany równoległą eliminacją Gaussa. W trybie `Parallel` każda całka jest
+ * liczona sekwencyjnie, więc wynik jest identyczny z sekwencyjnym; `ParallelSimd` używa wektorowej
+ * wersji sumowania Simpsona. `func_to_approx` musi być bezpieczna przy wywołaniach z wielu wątków.
+ *
+ * @param policy Sposób wykonania (zob. `ExecutionPolicy`).
+ */
+std::vector<double> polynomial_approximation(
+    std::function<double(double)> func_to_approx,
+    double a,
+    double b,
+    int degree,
+    int num_simpson_intervals,
+    ExecutionPolicy policy
+);
+
+/**
+ * @brief Wariant `polynomial_approximation` zapisujący współczynniki do `coeffs`, z układem równań w arenie `workspace`.
+ *
+ * Całki są liczone sekwencyjnie, a układ rozwiązywany przez `gauss_elimination_in_place`, więc wynik
+ * jest identyczny z wersją podstawową. Przy rozgrzanej arenie i wystarczającej pojemności `coeffs`
+ * funkcja nie alokuje pamięci (o ile nie alokuje jej sama `func_to_approx`).
+ *
+ * @param coeffs Wektor wynikowy (rozmiar ustawiany na degree + 1).
+ * @param workspace Arena na macierz i wektor układu równań.
+ */
+void polynomial_approximation(
+    std::function<double(double)> func_to_approx,
+    double a,
+    double b,
+    int degree,
+    int num_simpson_intervals,
+    std::vector<double>& coeffs,
+    Workspace& workspace
+);
+
+namespace detail {
+
+template <typename T>
+void check_approximation_args(T a, T b, int degree) {
+    if (degree < 0) {
+        throw std::invalid_argument("Stopien wielomianu (degree) musi byc nieujemny.");
+    }
+    if (a >= b) { // simpson_integrate obsłuży a > b, ale a == b da 0, co może być problemem dla macierzy
+        throw std::invalid_argument("Dolna granica calkowania 'a' musi byc mniejsza niz gorna granica 'b'.");
+    }
+    // Sprawdzenia dla num_simpson_intervals są wewnątrz simpson_integrate
+}
+
+// Wypełnia układ równań normalnych; A_at(i, j) zwraca referencję do elementu macierzy
+template <typename F, typename T, typename MatrixAt>
+void assemble_normal_equations(F& func_to_approx, T a, T b, int degree, int num_simpson_intervals,
+                               ExecutionPolicy policy, MatrixAt&& A_at, T* d_vector) {
+    int matrix_size = degree + 1;
+
+    // Całki w trybie Parallel liczone sekwencyjnie (równoległość na poziomie całek)
+    const ExecutionPolicy integral_policy =
+        policy == ExecutionPolicy::ParallelSimd ? ExecutionPolicy::ParallelSimd : ExecutionPolicy::Sequential;
+
+    // Całka numer t: najpierw elementy macierzy A (wierszami), potem elementy wektora d
+    auto compute_integral = [&](std::size_t t) {
+        if (t < static_cast<std::size_t>(matrix_size * matrix_size)) {
+            int i = static_cast<int>(t) / matrix_size;
+            int j = static_cast<int>(t) % matrix_size;
+            int power = i + j;
+            auto integrand_A = [power](T x_val) {
+                if (power == 0) return T(1); // x^0 = 1
+                return static_cast<T>(std::pow(x_val, static_cast<T>(power)));
+            };
+            // simpson_integrate rzuci wyjątkiem, jeśli num_simpson_intervals jest niepoprawne
+            A_at(i, j) = detail::simpson_integrate_impl(integrand_A, a, b, num_simpson_intervals, integral_policy);
+        } else {
+            int power = static_cast<int>(t) - matrix_size * matrix_size;
+            auto integrand_d = [&func_to_approx, power](T x_val) -> T {
+                if (power == 0) return func_to_approx(x_val); // f(x) * x^0
+                return func_to_approx(x_val) * std::pow(x_val, static_cast<T>(power));
+            };
+            d_vector[power] = detail::simpson_integrate_impl(integrand_d, a, b, num_simpson_intervals, integral_policy);
+        }
+    };
+
+    const std::size_t num_integrals = static_cast<std::size_t>(matrix_size * matrix_size + matrix_size);
+    if (policy == ExecutionPolicy::Sequential) {
+        for (std::size_t t = 0; t < num_integrals; ++t) {
+            compute_integral(t);
+        }
+    } else {
+        ThreadPool::global().parallel_for(0, num_integrals, 1, [&](std::size_t lo, std::size_t hi) {
+            for (std::size_t t = lo; t < hi; ++t) {
+                compute_integral(t);
+            }
+        });
+    }
+}
+
+template <typename F, typename T>
+std::vector<T> polynomial_approximation_impl(F& func_to_approx, T a, T b, int degree,
+                                             int num_simpson_intervals,
+                                             ExecutionPolicy policy = ExecutionPolicy::Sequential) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("polynomial_approximation");
+    check_approximation_args(a, b, degree);
+
+    int matrix_size = degree + 1;
+    std::vector<std::vector<T>> A_matrix(matrix_size, std::vector<T>(matrix_size));
+    std::vector<T> d_vector(matrix_size);
+    NUMLIBCPP_COUNT(allocations, matrix_size + 1);
+
+    assemble_normal_equations(func_to_approx, a, b, degree, num_simpson_intervals, policy,
+                              [&A_matrix](int i, int j) -> T& { return A_matrix[i][j]; }, d_vector.data());
+
+    // Rozwiązanie układu Ac = d
+    // Funkcja gauss_elimination przyjmuje przez wartość, więc tworzy kopie
+    try {
+        return gauss_elimination(A_matrix, d_vector, policy);
+    } catch (const std::runtime_error& e) {
+        // Przechwycenie błędu z Gaussa (np. macierz osobliwa) i rzucenie dalej
+        // z bardziej kontekstowym komunikatem lub po prostu rzucenie dalej
+        throw std::runtime_error(std::string("Blad podczas rozwiazywania ukladu rownan dla aproksymacji: ") + e.what());
+    }
+}
+
+template <typename F, typename T>
+void polynomial_approximation_into(F& func_to_approx, T a, T b, int degree, int num_simpson_intervals,
+                                   std::vector<T>& coeffs, Workspace& workspace) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("polynomial_approximation");
+    check_approximation_args(a, b, degree);
+
+    const int matrix_size = degree + 1;
+    Workspace::Frame frame(workspace);
+    T* A_matrix = workspace.allocate<T>(static_cast<std::size_t>(matrix_size) * matrix_size);
+    T* d_vector = workspace.allocate<T>(static_cast<std::size_t>(matrix_size));
+
+    assemble_normal_equations(func_to_approx, a, b, degree, num_simpson_intervals, ExecutionPolicy::Sequential,
+                              [A_matrix, matrix_size](int i, int j) -> T& { return A_matrix[i * matrix_size + j]; },
+                              d_vector);
+    try {
+        gauss_elimination_in_place(A_matrix, d_vector, matrix_size);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(std::string("Blad podczas rozwiazywania ukladu rownan dla aproksymacji: ") + e.what());
+    }
+    coeffs.assign(d_vector, d_vector + matrix_size);
+}
+
+} // namespace detail
+
+/**
+ * @brief Wariant `polynomial_approximation` dla dowolnego obiektu wywoływalnego.
+ *
+ * Funkcja i całkowane iloczyny f(x) * x^i są przekazywane do całkowania Simpsona bez `std::function`,
+ * więc kompilator może je wstawić w pętle kwadratury. Obiekt `std::function` trafia do wersji nieszablonowej.
+ */
+template <typename F, std::enable_if_t<std::is_invocable_r_v<double, F&, double>, int> = 0>
+std::vector<double> polynomial_approximation(F&& func_to_approx, double a, double b, int degree,
+                                             int num_simpson_intervals) {
+    return detail::polynomial_approximation_impl(func_to_approx, a, b, degree, num_simpson_intervals);
+}
+
+/**
+ * @brief Wariant szablonowy `polynomial_approximation` z wyborem sposobu wykonania.
+ */
+template <typename F, std::enable_if_t<std::is_invocable_r_v<double, F&, double>, int> = 0>
+std::vector<double> polynomial_approximation(F&& func_to_approx, double a, double b, int degree,
+                                             int num_simpson_intervals, ExecutionPolicy policy) {
+    return detail::polynomial_approximation_impl(func_to_approx, a, b, degree, num_simpson_intervals, policy);
+}
+
+/**
+ * @brief Wariant szablonowy `polynomial_approximation` z wynikiem w `coeffs` i pamięcią roboczą z areny.
+ */
+template <typename F, std::enable_if_t<std::is_invocable_r_v<double, F&, double>, int> = 0>
+void polynomial_approximation(F&& func_to_approx, double a, double b, int degree, int num_simpson_intervals,
+                              std::vector<double>& coeffs, Workspace& workspace) {
+    detail::polynomial_approximation_into(func_to_approx, a, b, degree, num_simpson_intervals, coeffs, workspace);
+}
+
+/**
+ * @brief Wariant `polynomial_approximation` dla typów `float` i `long double` (typ współczynników jak typ granic).
+ *
+ * Całki i układ równań są liczone w typie `T`; `long double` pomaga przy wysokich stopniach, gdy macierz
+ * Grama (zbliżona do macierzy Hilberta) jest źle uwarunkowana. Wywołania z granicami typu `double`
+ * trafiają do wersji powyżej.
+ */
+template <typename F, typename T,
+          std::enable_if_t<detail::is_alternate_scalar_v<T> && std::is_invocable_r_v<T, F&, T>, int> = 0>
+std::vector<T> polynomial_approximation(F&& func_to_approx, T a, T b, int degree, int num_simpson_intervals,
+                                        ExecutionPolicy policy = ExecutionPolicy::Sequential) {
+    return detail::polynomial_approximation_impl(func_to_approx, a, b, degree, num_simpson_intervals, policy);
+}
+
+/**
+ * @brief Wariant `polynomial_approximation` z wynikiem w `coeffs` dla typów `float` i `long double`.
+ */
+template <typename F, typename T,
+          std::enable_if_t<detail::is_alternate_scalar_v<T> && std::is_invocable_r_v<T, F&, T>, int> = 0>
+void polynomial_approximation(F&& func_to_approx, T a, T b, int degree, int num_simpson_intervals,
+                              std::vector<T>& coeffs, Workspace& workspace) {
+    detail::polynomial_approximation_into(func_to_approx, a, b, degree, num_simpson_intervals, coeffs, workspace);
+}
+
 } // namespace NumLibCpp
 
 #endif //NUMLIBCPP_APPROXIMATION_H
@@ -0,0 +1,487 @@
+#ifndef NUMLIBCPP_AUTODIFF_HPP
+#define NUMLIBCPP_AUTODIFF_HPP
+
+#include <algorithm> // Dla std::min
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits> // Dla std::decay_t
+#include <vector>
+#include <stdexcept> // Dla std::invalid_argument, std::runtime_error
+
+#include "NumLibCpp/nonlinear_solver.hpp"
+#include "NumLibCpp/differentialEquations_solver.hpp"
+
+namespace NumLibCpp {
+
+/**
+ * @brief Liczba dualna z N składowymi pochodnej (automatyczne różniczkowanie w przód).
+ *
+ * Reprezentuje wartość a + sum_k g_k eps_k, gdzie eps_k eps_l = 0. Każda operacja arytmetyczna
+ * i funkcja matematyczna przenosi pochodne regułą łańcuchową, więc jedno wywołanie funkcji
+ * szablonowej na `GradientDual<N>` daje jej wartość i N pochodnych kierunkowych dokładnie
+ * (z dokładnością zaokrągleń), bez wybierania kroku h. `Dual` (N = 1) daje pochodną funkcji
+ * jednej zmiennej.
+ *
+ * Funkcje użytkownika powinny być szablonami typu skalarnego i wywoływać funkcje matematyczne
+ * bez kwalifikacji (`using std::exp; exp(x)`), aby wybrać przeciążenia z tego nagłówka.
+ *
+ * @tparam N Liczba składowych pochodnej.
+ */
+template <std::size_t N>
+struct GradientDual {
+    double value = 0.0;              ///< Wartość funkcji.
+    std::array<double, N> grad{};    ///< Pochodne względem N kierunków.
+
+    constexpr GradientDual() = default;
+    constexpr GradientDual(double v) : value(v) {} // Stała: zerowe pochodne
+    constexpr GradientDual(double v, const std::array<double, N>& g) : value(v), grad(g) {}
+
+    GradientDual& operator+=(const GradientDual& b) { return *this = *this + b; }
+    GradientDual& operator-=(const GradientDual& b) { return *this = *this - b; }
+    GradientDual& operator*=(const GradientDual& b) { return *this = *this * b; }
+    GradientDual& operator/=(const GradientDual& b) { return *this = *this / b; }
+
+    friend GradientDual operator+(const GradientDual& a) { return a; }
+    friend GradientDual operator-(const GradientDual& a) {
+        GradientDual r(-a.value);
+        for (std::size_t k = 0; k < N; ++k) r.grad[k] = -a.grad[k];
+        return r;
+    }
+    friend GradientDual operator+(const GradientDual& a, const GradientDual& b) {
+        GradientDual r(a.value + b.value);
+        for (std::size_t k = 0; k < N; ++k) r.grad[k] = a.grad[k] + b.grad[k];
+        return r;
+    }
+    friend GradientDual operator+(const GradientDual& a, double b) { return GradientDual(a.value + b, a.grad); }
+    friend GradientDual operator+(double a, const GradientDual& b) { return GradientDual(a + b.value, b.grad); }
+    friend GradientDual operator-(const GradientDual& a, const GradientDual& b) {
+        GradientDual r(a.value - b.value);
+        for (std::size_t k = 0; k < N; ++k) r.grad[k] = a.grad[k] - b.grad[k];
+        return r;
+    }
+    friend GradientDual operator-(const GradientDual& a, double b) { return GradientDual(a.value - b, a.grad); }
+    friend GradientDual operator-(double a, const GradientDual& b) { return -(b - a); }
+    friend GradientDual operator*(const GradientDual& a, const GradientDual& b) {
+        GradientDual r(a.value * b.value);
+        for (std::size_t k = 0; k < N; ++k) r.grad[k] = a.grad[k] * b.value + a.value * b.grad[k];
+        return r;
+    }
+    friend GradientDual operator*(const GradientDual& a, double b) {
+        GradientDual r(a.value * b);
+        for (std::size_t k = 0; k < N; ++k) r.grad[k] = a.grad[k] * b;
+        return r;
+    }
+    friend GradientDual operator*(double a, const GradientDual& b) { return b * a; }
+    friend GradientDual operator/(const GradientDual& a, const GradientDual& b) {
+        const double inv = 1.0 / b.value;
+        const double q = a.value * inv;
+        GradientDual r(q);
+        for (std::size_t k = 0; k < N; ++k) r.grad[k] = (a.grad[k] - q * b.grad[k]) * inv;
+        return r;
+    }
+    friend GradientDual operator/(const GradientDual& a, double b) { return a * (1.0 / b); }
+    friend GradientDual operator/(double a, const GradientDual& b) {
+        const double inv = 1.0 / b.value;
+        GradientDual r(a * inv);
+        const double d = -a * inv * inv;
+        for (std::size_t k = 0; k < N; ++k) r.grad[k] = d * b.grad[k];
+        return r;
+    }
+
+    // Porównania dotyczą tylko wartości (gałęzie w funkcji użytkownika wybierają się jak dla double)
+    friend bool operator<(const GradientDual& a, const GradientDual& b) { return a.value < b.value; }
+    friend bool operator>(const GradientDual& a, const GradientDual& b) { return a.value > b.value; }
+    friend bool operator<=(const GradientDual& a, const GradientDual& b) { return a.value <= b.value; }
+    friend bool operator>=(const GradientDual& a, const GradientDual& b) { return a.value >= b.value; }
+    friend bool operator==(const GradientDual& a, const GradientDual& b) { return a.value == b.value; }
+    friend bool operator!=(const GradientDual& a, const GradientDual& b) { return a.value != b.value; }
+};
+
+/// Liczba dualna z jedną pochodną.
+using Dual = GradientDual<1>;
+
+/**
+ * @brief Liczba hiperdualna a + b eps1 + c eps2 + d eps1 eps2 (eps1^2 = eps2^2 = 0, eps1 eps2 != 0).
+ *
+ * Dla x = HyperDual(x0, 1, 1, 0) składowa `e12` wyniku f(x) jest dokładną drugą pochodną f''(x0);
+ * przy ziarnach w dwóch różnych kierunkach daje mieszaną pochodną cząstkową. Obsługuje te same
+ * operacje i funkcje co `GradientDual`.
+ */
+struct HyperDual {
+    double value = 0.0;  ///< Wartość funkcji.
+    double e1 = 0.0;     ///< Pochodna w kierunku eps1.
+    double e2 = 0.0;     ///< Pochodna w kierunku eps2.
+    double e12 = 0.0;    ///< Druga pochodna mieszana (eps1 eps2).
+
+    constexpr HyperDual() = default;
+    constexpr HyperDual(double v) : value(v) {}
+    constexpr HyperDual(double v, double d1, double d2, double d12) : value(v), e1(d1), e2(d2), e12(d12) {}
+
+    HyperDual& operator+=(const HyperDual& b) { return *this = *this + b; }
+    HyperDual& operator-=(const HyperDual& b) { return *this = *this - b; }
+    HyperDual& operator*=(const HyperDual& b) { return *this = *this * b; }
+    HyperDual& operator/=(const HyperDual& b) { return *this = *this / b; }
+
+    friend HyperDual operator+(const HyperDual& a) { return a; }
+    friend HyperDual operator-(const HyperDual& a) { return HyperDual(-a.value, -a.e1, -a.e2, -a.e12); }
+    friend HyperDual operator+(const HyperDual& a, const HyperDual& b) {
+        return HyperDual(a.value + b.value, a.e1 + b.e1, a.e2 + b.e2, a.e12 + b.e12);
+    }
+    friend HyperDual operator+(const HyperDual& a, double b) { return HyperDual(a.value + b, a.e1, a.e2, a.e12); }
+    friend HyperDual operator+(double a, const HyperDual& b) { return b + a; }
+    friend HyperDual operator-(const HyperDual& a, const HyperDual& b) {
+        return HyperDual(a.value - b.value, a.e1 - b.e1, a.e2 - b.e2, a.e12 - b.e12);
+    }
+    friend HyperDual operator-(const HyperDual& a, double b) { return HyperDual(a.value - b, a.e1, a.e2, a.e12); }
+    friend HyperDual operator-(double a, const HyperDual& b) { return -(b - a); }
+    friend HyperDual operator*(const HyperDual& a, const HyperDual& b) {
+        return HyperDual(a.value * b.value, a.e1 * b.value + a.value * b.e1, a.e2 * b.value + a.value * b.e2,
+                         a.e12 * b.value + a.e1 * b.e2 + a.e2 * b.e1 + a.value * b.e12);
+    }
+    friend HyperDual operator*(const HyperDual& a, double b) { return HyperDual(a.value * b, a.e1 * b, a.e2 * b, a.e12 * b); }
+    friend HyperDual operator*(double a, const HyperDual& b) { return b * a; }
+    friend HyperDual operator/(const HyperDual& a, const HyperDual& b) {
+        const double inv = 1.0 / b.value;
+        // 1/b: f' = -1/b^2, f'' = 2/b^3
+        const HyperDual r(inv, -inv * inv * b.e1, -inv * inv * b.e2,
+                          -inv * inv * b.e12 + 2.0 * inv * inv * inv * b.e1 * b.e2);
+        return a * r;
+    }
+    friend HyperDual operator/(const HyperDual& a, double b) { return a * (1.0 / b); }
+    friend HyperDual operator/(double a, const HyperDual& b) { return HyperDual(a) / b; }
+
+    friend bool operator<(const HyperDual& a, const HyperDual& b) { return a.value < b.value; }
+    friend bool operator>(const HyperDual& a, const HyperDual& b) { return a.value > b.value; }
+    friend bool operator<=(const HyperDual& a, const HyperDual& b) { return a.value <= b.value; }
+    friend bool operator>=(const HyperDual& a, const HyperDual& b) { return a.value >= b.value; }
+    friend bool operator==(const HyperDual& a, const HyperDual& b) { return a.value == b.value; }
+    friend bool operator!=(const HyperDual& a, const HyperDual& b) { return a.value != b.value; }
+};
+
+namespace detail {
+
+// Reguła łańcuchowa dla funkcji jednej zmiennej: f(a), f'(a) (oraz f''(a) dla liczb hiperdualnych)
+template <std::size_t N>
+inline GradientDual<N> ad_chain(const GradientDual<N>& a, double f, double df, double /*d2f*/) {
+    GradientDual<N> r(f);
+    for (std::size_t k = 0; k < N; ++k) r.grad[k] = df * a.grad[k];
+    return r;
+}
+
+inline HyperDual ad_chain(const HyperDual& a, double f, double df, double d2f) {
+    return HyperDual(f, df * a.e1, df * a.e2, df * a.e12 + d2f * a.e1 * a.e2);
+}
+
+} // namespace detail
+
+// Funkcje matematyczne dla GradientDual i HyperDual (dobierane przez ADL)
+#define NUMLIBCPP_AD_UNARY(name, F, DF, D2F)                                         \
+    template <std::size_t N>                                                         \
+    inline GradientDual<N> name(const GradientDual<N>& a) {                          \
+        const double x = a.value;                                                    \
+        (void)x;                                                                     \
+        return detail::ad_chain(a, (F), (DF), 0.0);                                  \
+    }                                                                                \
+    inline HyperDual name(const HyperDual& a) {                                      \
+        const double x = a.value;                                                    \
+        (void)x;                                                                     \
+        return detail::ad_chain(a, (F), (DF), (D2F));                                \
+    }
+
+NUMLIBCPP_AD_UNARY(sqrt, std::sqrt(x), 0.5 / std::sqrt(x), -0.25 / (x * std::sqrt(x)))
+NUMLIBCPP_AD_UNARY(cbrt, std::cbrt(x), 1.0 / (3.0 * std::cbrt(x) * std::cbrt(x)),
+                   -2.0 / (9.0 * x * std::cbrt(x) * std::cbrt(x)))
+NUMLIBCPP_AD_UNARY(exp, std::exp(x), std::exp(x), std::exp(x))
+NUMLIBCPP_AD_UNARY(log, std::log(x), 1.0 / x, -1.0 / (x * x))
+NUMLIBCPP_AD_UNARY(log10, std::log10(x), 1.0 / (x * std::log(10.0)), -1.0 / (x * x * std::log(10.0)))
+NUMLIBCPP_AD_UNARY(sin, std::sin(x), std::cos(x), -std::sin(x))
+NUMLIBCPP_AD_UNARY(cos, std::cos(x), -std::sin(x), -std::cos(x))
+NUMLIBCPP_AD_UNARY(tan, std::tan(x), 1.0 / (std::cos(x) * std::cos(x)),
+                   2.0 * std::tan(x) / (std::cos(x) * std::cos(x)))
+NUMLIBCPP_AD_UNARY(asin, std::asin(x), 1.0 / std::sqrt(1.0 - x * x), x / ((1.0 - x * x) * std::sqrt(1.0 - x * x)))
+NUMLIBCPP_AD_UNARY(acos, std::acos(x), -1.0 / std::sqrt(1.0 - x * x), -x / ((1.0 - x * x) * std::sqrt(1.0 - x * x)))
+NUMLIBCPP_AD_UNARY(atan, std::atan(x), 1.0 / (1.0 + x * x), -2.0 * x / ((1.0 + x * x) * (1.0 + x * x)))
+NUMLIBCPP_AD_UNARY(sinh, std::sinh(x), std::cosh(x), std::sinh(x))
+NUMLIBCPP_AD_UNARY(cosh, std::cosh(x), std::sinh(x), std::cosh(x))
+NUMLIBCPP_AD_UNARY(tanh, std::tanh(x), 1.0 - std::tanh(x) * std::tanh(x),
+                   -2.0 * std::tanh(x) * (1.0 - std::tanh(x) * std::tanh(x)))
+NUMLIBCPP_AD_UNARY(abs, std::abs(x), (x < 0.0 ? -1.0 : 1.0), 0.0)
+NUMLIBCPP_AD_UNARY(fabs, std::abs(x), (x < 0.0 ? -1.0 : 1.0), 0.0)
+
+#undef NUMLIBCPP_AD_UNARY
+
+template <std::size_t N>
+inline GradientDual<N> pow(const GradientDual<N>& a, double p) {
+    return detail::ad_chain(a, std::pow(a.value, p), p * std::pow(a.value, p - 1.0), 0.0);
+}
+inline HyperDual pow(const HyperDual& a, double p) {
+    return detail::ad_chain(a, std::pow(a.value, p), p * std::pow(a.value, p - 1.0),
+                            p * (p - 1.0) * std::pow(a.value, p - 2.0));
+}
+template <std::size_t N>
+inline GradientDual<N> pow(const GradientDual<N>& a, const GradientDual<N>& b) { return exp(b * log(a)); }
+template <std::size_t N>
+inline GradientDual<N> pow(double a, const GradientDual<N>& b) { return exp(b * std::log(a)); }
+inline HyperDual pow(const HyperDual& a, const HyperDual& b) { return exp(b * log(a)); }
+inline HyperDual pow(double a, const HyperDual& b) { return exp(b * std::log(a)); }
+
+template <std::size_t N>
+inline GradientDual<N> atan2(const GradientDual<N>& y, const GradientDual<N>& x) {
+    const double r2 = x.value * x.value + y.value * y.value;
+    GradientDual<N> r(std::atan2(y.value, x.value));
+    for (std::size_t k = 0; k < N; ++k) r.grad[k] = (x.value * y.grad[k] - y.value * x.grad[k]) / r2;
+    return r;
+}
+
+/**
+ * @brief Pochodna f'(x) funkcji jednej zmiennej obliczona automatycznie (jedno wywołanie `f` na `Dual`).
+ *
+ * @param f Funkcja szablonowa, wywoływana jako `f(Dual)` i zwracająca `Dual`.
+ * @param x Punkt, w którym liczona jest pochodna.
+ * @return double Dokładna pochodna f'(x).
+ *
+ * @example
+ * @code
+ * auto f = [](auto x) { using std::sin; return x * sin(x); };
+ * double df = NumLibCpp::derivative(f, 1.0); // sin(1) + cos(1)
+ * @endcode
+ */
+template <typename F>
+double derivative(F f, double x) {
+    return f(Dual(x, {1.0})).grad[0];
+}
+
+/**
+ * @brief Druga pochodna f''(x) funkcji jednej zmiennej obliczona liczbami hiperdualnymi.
+ *
+ * @param f Funkcja szablonowa, wywoływana jako `f(HyperDual)` i zwracająca `HyperDual`.
+ * @param x Punkt, w którym liczona jest pochodna.
+ * @return double Dokładna druga pochodna f''(x).
+ */
+template <typename F>
+double second_derivative(F f, double x) {
+    return f(HyperDual(x, 1.0, 1.0, 0.0)).e12;
+}
+
+/// Liczba kierunków różniczkowanych jednocześnie w `gradient_ad` i `jacobian_ad`.
+constexpr std::size_t ad_chunk_size = 8;
+
+/**
+ * @brief Macierz Jacobiego funkcji F: R^n -> R^m obliczona automatycznie w trybie w przód.
+ *
+ * Kolumny są liczone paczkami po `ad_chunk_size`: każde wywołanie `f` na
+ * `std::vector<GradientDual<ad_chunk_size>>` daje jednocześnie 8 kolumn, więc cały jakobian
+ * wymaga ceil(n / 8) wywołań (różnice centralne - 2n), a pętle po składowych pochodnej mają
+ * stałą długość i mogą być wektoryzowane.
+ *
+ * @param f Funkcja szablonowa `std::vector<T> f(const std::vector<T>&)`.
+ * @param x Punkt, w którym obliczana jest macierz Jacobiego (niepusty).
+ * @return std::vector<std::vector<double>> Macierz Jacobiego m x n.
+ * @throws std::invalid_argument Jeśli `x` jest pusty.
+ *
+ * @example
+ * @code
+ * auto F = [](const auto& v) {
+ *     using std::exp;
+ *     using T = typename std::decay_t<decltype(v)>::value_type;
+ *     return std::vector<T>{v[0] * v[0] + v[1] * v[1] - 4.0, exp(v[0]) + v[1] - 1.0};
+ * };
+ * auto J = NumLibCpp::jacobian_ad(F, {1.0, -1.0});
+ * @endcode
+ */
+template <typename F>
+std::vector<std::vector<double>> jacobian_ad(F f, const std::vector<double>& x) {
+    if (x.empty()) {
+        throw std::invalid_argument("Wektor x nie moze byc pusty.");
+    }
+    using D = GradientDual<ad_chunk_size>;
+    const std::size_t n = x.size();
+    std::vector<D> xd(n);
+    for (std::size_t j = 0; j < n; ++j) xd[j] = D(x[j]);
+
+    std::vector<std::vector<double>> J;
+    for (std::size_t first = 0; first < n; first += ad_chunk_size) {
+        const std::size_t count = std::min(ad_chunk_size, n - first);
+        for (std::size_t k = 0; k < count; ++k) xd[first + k].grad[k] = 1.0;
+        std::vector<D> fx = f(xd);
+        for (std::size_t k = 0; k < count; ++k) xd[first + k].grad[k] = 0.0;
+
+        if (J.empty()) {
+            J.assign(fx.size(), std::vector<double>(n, 0.0));
+        }
+        for (std::size_t i = 0; i < fx.size(); ++i) {
+            for (std::size_t k = 0; k < count; ++k) J[i][first + k] = fx[i].grad[k];
+        }
+    }
+    return J;
+}
+
+/**
+ * @brief Gradient funkcji f: R^n -> R obliczony automatycznie (ceil(n / 8) wywołań `f`).
+ *
+ * @param f Funkcja szablonowa `T f(const std::vector<T>&)`.
+ * @param x Punkt, w którym liczony jest gradient (niepusty).
+ * @return std::vector<double> Gradient (rozmiar n).
+ * @throws std::invalid_argument Jeśli `x` jest pusty.
+ */
+template <typename F>
+std::vector<double> gradient_ad(F f, const std::vector<double>& x) {
+    auto wrapped = [&f](const auto& v) {
+        using T = typename std::decay_t<decltype(v)>::value_type;
+        return std::vector<T>{f(v)};
+    };
+    return jacobian_ad(wrapped, x)[0];
+}
+
+/**
+ * @brief Macierz Hessego funkcji f: R^n -> R obliczona liczbami hiperdualnymi.
+ *
+ * Element (i, j) wymaga jednego wywołania `f` z ziarnami eps1 w kierunku i oraz eps2 w kierunku j;
+ * z symetrii liczony jest tylko trójkąt dolny (n(n+1)/2 wywołań).
+ *
+ * @param f Funkcja szablonowa `T f(const std::vector<T>&)`.
+ * @param x Punkt (niepusty).
+ * @return std::vector<std::vector<double>> Symetryczna macierz Hessego n x n.
+ * @throws std::invalid_argument Jeśli `x` jest pusty.
+ */
+template <typename F>
+std::vector<std::vector<double>> hessian_ad(F f, const std::vector<double>& x) {
+    if (x.empty()) {
+        throw std::invalid_argument("Wektor x nie moze byc pusty.");
+    }
+    const std::size_t n = x.size();
+    std::vector<HyperDual> xd(x.begin(), x.end());
+    std::vector<std::vector<double>> H(n, std::vector<double>(n, 0.0));
+    for (std::size_t i = 0; i < n; ++i) {
+        xd[i].e1 = 1.0;
+        for (std::size_t j = 0; j <= i; ++j) {
+            xd[j].e2 = 1.0;
+            H[i][j] = H[j][i] = f(xd).e12;
+            xd[j].e2 = 0.0;
+        }
+        xd[i].e1 = 0.0;
+    }
+    return H;
+}
+
+/**
+ * @brief Znajduje pierwiastek równania f(x) = 0 metodą Newtona z pochodną liczoną automatycznie.
+ *
+ * Każda iteracja wywołuje `f` raz na `Dual`, otrzymując jednocześnie f(x) i dokładne f'(x);
+ * w przeciwieństwie do `secant_method` zbieżność jest kwadratowa, a żaden krok różniczkowania
+ * nie jest potrzebny.
+ *
+ * @param f Funkcja szablonowa wywoływana jako `f(Dual)`.
+ * @param x0 Przybliżenie początkowe.
+ * @param tol Tolerancja (|dx| < tol lub |f(x)| < tol).
+ * @param max_iter Maksymalna liczba iteracji.
+ * @return double Przybliżona wartość pierwiastka.
+ * @throws std::invalid_argument Jeśli `tol <= 0` lub `max_iter <= 0`.
+ * @throws std::runtime_error Jeśli pochodna jest zerowa lub metoda nie zbiegnie w `max_iter` iteracjach.
+ */
+template <typename F>
+double newton_method_ad(F f, double x0, double tol, int max_iter) {
+    if (tol <= 0.0) {
+        throw std::invalid_argument("Tolerancja musi byc dodatnia.");
+    }
+    if (max_iter <= 0) {
+        throw std::invalid_argument("Maksymalna liczba iteracji musi byc dodatnia.");
+    }
+    double x = x0;
+    for (int i = 0; i < max_iter; ++i) {
+        const Dual fx = f(Dual(x, {1.0}));
+        if (std::abs(fx.value) < tol) {
+            return x;
+        }
+        if (fx.grad[0] == 0.0) {
+            throw std::runtime_error("Pochodna rowna zeru - metoda Newtona nie moze kontynuowac.");
+        }
+        const double dx = fx.value / fx.grad[0];
+        x -= dx;
+        if (std::abs(dx) < tol) {
+            return x;
+        }
+    }
+    throw std::runtime_error("Metoda Newtona nie zbiegla w maksymalnej liczbie iteracji.");
+}
+
+/**
+ * @brief `newton_system` z jakobianem liczonym automatycznie (`jacobian_ad`).
+ *
+ * @param f Funkcja szablonowa `std::vector<T> f(const std::vector<T>&)`.
+ * @param x0 Przybliżenie początkowe.
+ * @param options Parametry solvera; pole `jacobian` jest zastępowane jakobianem AD.
+ * @return NonlinearSystemResult Jak w `newton_system` (`function_evaluations` nie obejmuje wywołań na liczbach dualnych).
+ */
+template <typename F>
+NonlinearSystemResult newton_system_ad(F f, const std::vector<double>& x0,
+                                       NonlinearSystemOptions options = NonlinearSystemOptions()) {
+    options.jacobian = [f](const std::vector<double>& x) { return jacobian_ad(f, x); };
+    return newton_system([f](const std::vector<double>& x) { return f(x); }, x0, options);
+}
+
+/**
+ * @brief `broyden_system` z jakobianem początkowym liczonym automatycznie (`jacobian_ad`).
+ */
+template <typename F>
+NonlinearSystemResult broyden_system_ad(F f, const std::vector<double>& x0,
+                                        NonlinearSystemOptions options = NonlinearSystemOptions()) {
+    options.jacobian = [f](const std::vector<double>& x) { return jacobian_ad(f, x); };
+    return broyden_system([f](const std::vector<double>& x) { return f(x); }, x0, options);
+}
+
+/**
+ * @brief Tworzy `OdeJacobian` dla prawej strony f(x, y) szablonowej względem typu stanu.
+ *
+ * @param f Funkcja szablonowa `std::vector<T> f(double x, const std::vector<T>& y)`.
+ * @return OdeJacobian Jakobian df/dy liczony przez `jacobian_ad`.
+ */
+template <typename F>
+OdeJacobian make_ode_jacobian_ad(F f) {
+    return [f](double x, const std::vector<double>& y) {
+        return jacobian_ad([&f, x](const auto& v) { return f(x, v); }, y);
+    };
+}
+
+/**
+ * @brief `bdf_solve` z dokładnym jakobianem df/dy liczonym automatycznie.
+ *
+ * @param f Funkcja szablonowa `std::vector<T> f(double x, const std::vector<T>& y)`.
+ * @param options Parametry solvera; pole `jacobian` jest zastępowane jakobianem AD.
+ *
+ * @example
+ * @code
+ * auto robertson = [](double, const auto& y) {
+ *     using T = typename std::decay_t<decltype(y)>::value_type;
+ *     return std::vector<T>{-0.04 * y[0] + 1e4 * y[1] * y[2],
+ *                           0.04 * y[0] - 1e4 * y[1] * y[2] - 3e7 * y[1] * y[1],
+ *                           3e7 * y[1] * y[1]};
+ * };
+ * auto res = NumLibCpp::bdf_solve_ad(robertson, 0.0, {1.0, 0.0, 0.0}, 40.0);
+ * @endcode
+ */
+template <typename F>
+StiffSolverResult bdf_solve_ad(F f, double x0, const std::vector<double>& y0, double x_target,
+                               StiffSolverOptions options = StiffSolverOptions()) {
+    options.jacobian = make_ode_jacobian_ad(f);
+    return bdf_solve([f](double x, const std::vector<double>& y) { return f(x, y); }, x0, y0, x_target, options);
+}
+
+/**
+ * @brief `rosenbrock_solve` z dokładnym jakobianem df/dy liczonym automatycznie.
+ *
+ * @param f Funkcja szablonowa `std::vector<T> f(double x, const std::vector<T>& y)`.
+ * @param options Parametry solvera; pole `jacobian` jest zastępowane jakobianem AD.
+ */
+template <typename F>
+StiffSolverResult rosenbrock_solve_ad(F f, double x0, const std::vector<double>& y0, double x_target,
+                                      StiffSolverOptions options = StiffSolverOptions()) {
+    options.jacobian = make_ode_jacobian_ad(f);
+    return rosenbrock_solve([f](double x, const std::vector<double>& y) { return f(x, y); }, x0, y0, x_target,
+                            options);
+}
+
+} // namespace NumLibCpp
+
+#endif // NUMLIBCPP_AUTODIFF_HPP
@@ -4,6 +4,11 @@
 #include <functional>
 #include <vector>
 #include <stdexcept> // Dla std::invalid_argument
+#include <cstddef>   // Dla std::size_t
+#include <type_traits>
+#include "NumLibCpp/execution.hpp"
+#include "NumLibCpp/instrumentation.hpp"
+#include "NumLibCpp/scalar_traits.hpp"
 
 namespace NumLibCpp {
 
@@ -45,6 +50,335 @@ namespace NumLibCpp {
  */
 double rk4_solve(std::function<double(double, double)> f, double x0, double y0, double x_target, int num_steps);
 
+/**
+ * @brief Obserwator trajektorii równania skalarnego, wywoływany z parą (x, y(x)).
+ */
+using StepObserver = std::function<void(double x, double y)>;
+
+/**
+ * @brief Wariant `rk4_solve` przekazujący całą trajektorię do obserwatora.
+ *
+ * Obserwator jest wywoływany dla punktu początkowego (x0, y0) oraz po każdym kroku RK4,
+ * więc pełna trajektoria kosztuje tyle samo co jedno wywołanie `rk4_solve`, a pamięć nie rośnie
+ * z liczbą kroków (np. w połączeniu z `TrajectoryWriter`).
+ *
+ * @param f Funkcja f(x, y) definiująca równanie różniczkowe.
+ * @param x0 Początkowa wartość x.
+ * @param y0 Początkowa wartość y.
+ * @param x_target Wartość x, dla której szukane jest rozwiązanie y.
+ * @param num_steps Liczba kroków całkowania (musi być dodatnia).
+ * @param observer Funkcja wywoływana w punkcie początkowym i po każdym kroku.
+ * @return double Wartość y w punkcie x_target.
+ * @throws std::invalid_argument Jeśli `num_steps <= 0`.
+ *
+ * @example
+ * @code
+ * std::vector<std::pair<double, double>> trajectory;
+ * NumLibCpp::rk4_solve(f_exp, 0.0, 1.0, 1.0, 100,
+ *     [&](double x, double y) { trajectory.emplace_back(x, y); }); // 101 punktów
+ * @endcode
+ */
+double rk4_solve(std::function<double(double, double)> f, double x0, double y0, double x_target, int num_steps,
+                 const StepObserver& observer);
+
+namespace detail {
+
+template <typename F, typename T>
+T rk4_solve_impl(F& f, T x0, T y0, T x_target, int num_steps) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("rk4_solve");
+    if (num_steps <= 0) {
+        throw std::invalid_argument("Liczba krokow musi byc dodatnia.");
+    }
+
+    T h = (x_target - x0) / num_steps;
+    T x = x0;
+    T y = y0;
+
+    for (int i = 0; i < num_steps; ++i) {
+        T k1 = h * f(x, y);
+        T k2 = h * f(x + T(0.5) * h, y + T(0.5) * k1);
+        T k3 = h * f(x + T(0.5) * h, y + T(0.5) * k2);
+        T k4 = h * f(x + h, y + k3);
+
+        y = y + (k1 + 2 * k2 + 2 * k3 + k4) / 6;
+        x = x + h; // lub x = x0 + (i+1)*h dla większej precyzji
+    }
+    NUMLIBCPP_COUNT(iterations, num_steps);
+    NUMLIBCPP_COUNT(function_evaluations, 4 * static_cast<std::uint64_t>(num_steps));
+    return y;
+}
+
+template <typename F, typename T, typename Observer>
+T rk4_solve_observed_impl(F& f, T x0, T y0, T x_target, int num_steps, Observer& observer) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("rk4_solve");
+    if (num_steps <= 0) {
+        throw std::invalid_argument("Liczba krokow musi byc dodatnia.");
+    }
+
+    T h = (x_target - x0) / num_steps;
+    T x = x0;
+    T y = y0;
+    observer(x, y);
+
+    for (int i = 0; i < num_steps; ++i) {
+        T k1 = h * f(x, y);
+        T k2 = h * f(x + T(0.5) * h, y + T(0.5) * k1);
+        T k3 = h * f(x + T(0.5) * h, y + T(0.5) * k2);
+        T k4 = h * f(x + h, y + k3);
+
+        y = y + (k1 + 2 * k2 + 2 * k3 + k4) / 6;
+        x = x + h;
+        observer(x, y);
+    }
+    NUMLIBCPP_COUNT(iterations, num_steps);
+    NUMLIBCPP_COUNT(function_evaluations, 4 * static_cast<std::uint64_t>(num_steps));
+    return y;
+}
+
+} // namespace detail
+
+/**
+ * @brief Wariant `rk4_solve` dla dowolnego obiektu wywoływalnego f(x, y).
+ *
+ * Cztery wywołania `f` na krok są bezpośrednie, więc prosta prawa strona może zostać wstawiona
+ * w pętlę kroków. Obiekt `std::function` trafia do wersji nieszablonowej.
+ */
+template <typename F, std::enable_if_t<std::is_invocable_r_v<double, F&, double, double>, int> = 0>
+double rk4_solve(F&& f, double x0, double y0, double x_target, int num_steps) {
+    return detail::rk4_solve_impl(f, x0, y0, x_target, num_steps);
+}
+
+/**
+ * @brief Wariant `rk4_solve` z obserwatorem dla dowolnych obiektów wywoływalnych `f` i `observer`.
+ */
+template <typename F, typename Observer,
+          std::enable_if_t<std::is_invocable_r_v<double, F&, double, double> &&
+                           std::is_invocable_v<Observer&, double, double>, int> = 0>
+double rk4_solve(F&& f, double x0, double y0, double x_target, int num_steps, Observer&& observer) {
+    return detail::rk4_solve_observed_impl(f, x0, y0, x_target, num_steps, observer);
+}
+
+/**
+ * @brief Wariant `rk4_solve` dla typów `float` i `long double` (typ wyznaczany z argumentów).
+ *
+ * Przy argumentach różnych typów (np. `float` i `double`) wywoływana jest wersja dla `double`.
+ */
+template <typename F, typename T,
+          std::enable_if_t<detail::is_alternate_scalar_v<T> && std::is_invocable_r_v<T, F&, T, T>, int> = 0>
+T rk4_solve(F&& f, T x0, T y0, T x_target, int num_steps) {
+    return detail::rk4_solve_impl(f, x0, y0, x_target, num_steps);
+}
+
+/**
+ * @brief Wariant `rk4_solve` raportujący rozwiązanie w zadanych punktach `output_points`.
+ *
+ * Kroki całkowania są takie same jak w `rk4_solve`, a wartości w punktach pośrednich są
+ * wyznaczane interpolacją Hermite'a trzeciego stopnia z wartości y i f(x, y) na końcach kroku,
+ * bez dodatkowych wywołań `f` (poza jednym na końcu przedziału).
+ *
+ * @param f Funkcja f(x, y) definiująca równanie różniczkowe.
+ * @param x0 Początkowa wartość x.
+ * @param y0 Początkowa wartość y.
+ * @param x_target Wartość x, dla której szukane jest rozwiązanie y.
+ * @param num_steps Liczba kroków całkowania (musi być dodatnia).
+ * @param output_points Punkty wyjściowe uporządkowane od x0 w stronę x_target, leżące w przedziale [x0, x_target].
+ * @param observer Funkcja wywoływana kolejno dla każdego punktu z `output_points`.
+ * @return double Wartość y w punkcie x_target.
+ * @throws std::invalid_argument Jeśli `num_steps <= 0` lub `output_points` nie są uporządkowane albo wychodzą poza przedział.
+ */
+double rk4_solve(std::function<double(double, double)> f, double x0, double y0, double x_target, int num_steps,
+                 const std::vector<double>& output_points, const StepObserver& observer);
+
+/**
+ * @brief Prawa strona równania y' = f(x, y) liczona jednocześnie dla bloku trajektorii zespołu.
+ *
+ * Wywołanie `f(x, y, dydx, first, count)` ma zapisać w `dydx[i]` wartość f(x, y[i]) dla trajektorii
+ * o globalnym indeksie `first + i`, i = 0..count-1. Indeks pozwala odczytać parametry danej trajektorii
+ * (np. stałą chłodzenia k) z tablicy użytkownika. Funkcja może być wywoływana współbieżnie z wielu wątków
+ * dla rozłącznych bloków.
+ */
+template <typename T>
+using BasicEnsembleRhs = std::function<void(T x, const T* y, T* dydx, std::size_t first, std::size_t count)>;
+
+using EnsembleRhs = BasicEnsembleRhs<double>;
+
+/**
+ * @brief Całkuje metodą RK4 zespół N niezależnych trajektorii tego samego równania y' = f(x, y).
+ *
+ * Stany trajektorii są przechowywane w układzie struktura-tablic (SoA): każdy etap RK4 przetwarza
+ * ciągły blok trajektorii jedną pętlą, którą kompilator może zwektoryzować, a prawa strona jest
+ * wywoływana raz na blok zamiast raz na trajektorię. Bloki są rozdzielane między wątki globalnej
+ * puli `ThreadPool::global()`.
+ *
+ * @param f Prawa strona równania liczona dla bloku trajektorii (patrz `EnsembleRhs`).
+ * @param x0 Początkowa wartość x (wspólna dla wszystkich trajektorii).
+ * @param y0 Warunki początkowe y_i(x0) kolejnych trajektorii.
+ * @param x_target Wartość x, dla której szukane są rozwiązania.
+ * @param num_steps Liczba kroków całkowania (musi być dodatnia).
+ * @return std::vector<double> Ciągła tablica wartości y_i(x_target), w tej samej kolejności co `y0`.
+ * @throws std::invalid_argument Jeśli `num_steps <= 0`.
+ *
+ * @example
+ * @code
+ * // Chłodzenie Newtona dla wielu par (k, T_env): dT/dt = -k_i * (T - T_env_i)
+ * std::vector<double> k = ..., T_env = ..., T0 = ...;
+ * auto rhs = [&](double, const double* T, double* dT, std::size_t first, std::size_t count) {
+ *     for (std::size_t i = 0; i < count; ++i) {
+ *         dT[i] = -k[first + i] * (T[i] - T_env[first + i]);
+ *     }
+ * };
+ * std::vector<double> T_final = NumLibCpp::rk4_solve_ensemble(rhs, 0.0, T0, 10.0, 100);
+ * @endcode
+ */
+std::vector<double> rk4_solve_ensemble(const EnsembleRhs& f, double x0, const std::vector<double>& y0,
+                                       double x_target, int num_steps);
+
+/**
+ * @brief Wariant `rk4_solve_ensemble` z wyborem sposobu wykonania.
+ *
+ * Wersja bez argumentu `policy` odpowiada `ExecutionPolicy::Parallel`. W trybie `Sequential` wszystkie
+ * bloki są całkowane w wątku wywołującym. Etapy RK4 działają na blokach w układzie SoA w każdym trybie,
+ * dlatego `ParallelSimd` działa tu jak `Parallel`. Wynik nie zależy od sposobu wykonania.
+ *
+ * @param policy Sposób wykonania (zob. `ExecutionPolicy`).
+ */
+std::vector<double> rk4_solve_ensemble(const EnsembleRhs& f, double x0, const std::vector<double>& y0,
+                                       double x_target, int num_steps, ExecutionPolicy policy);
+
+/**
+ * @brief Wariant `rk4_solve_ensemble` całkujący zespół w miejscu: `y` zawiera na wejściu y_i(x0), a na wyjściu y_i(x_target).
+ *
+ * Bufory etapów RK4 leżą na stosie, więc w trybie `Sequential` funkcja nie alokuje pamięci
+ * (ścieżki równoległe alokują zadania puli wątków).
+ *
+ * @throws std::invalid_argument Jeśli `num_steps <= 0`.
+ */
+void rk4_solve_ensemble_in_place(const EnsembleRhs& f, double x0, std::vector<double>& y, double x_target, int num_steps,
+                                 ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
+/**
+ * @brief Warianty `rk4_solve_ensemble` dla dowolnego typu skalarnego (`float`, `double`, `long double`).
+ *
+ * Typ jest wyznaczany z wektora stanów; stany `float` zajmują połowę pamięci i przepustowości,
+ * a pętle etapów przetwarzają dwukrotnie więcej trajektorii na instrukcję wektorową. Biblioteka
+ * zawiera jawne konkretyzacje dla trzech typów zmiennoprzecinkowych.
+ *
+ * @example
+ * @code
+ * std::vector<float> T0(100000, 90.0f);
+ * auto rhs = [](float, const float* T, float* dT, std::size_t, std::size_t count) {
+ *     for (std::size_t i = 0; i < count; ++i) dT[i] = -0.1f * (T[i] - 20.0f);
+ * };
+ * std::vector<float> T_final = NumLibCpp::rk4_solve_ensemble(rhs, 0.0f, T0, 10.0f, 100);
+ * @endcode
+ */
+template <typename T>
+std::vector<T> rk4_solve_ensemble(const BasicEnsembleRhs<detail::type_identity_t<T>>& f, detail::type_identity_t<T> x0,
+                                  const std::vector<T>& y0, detail::type_identity_t<T> x_target, int num_steps,
+                                  ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
+template <typename T>
+void rk4_solve_ensemble_in_place(const BasicEnsembleRhs<detail::type_identity_t<T>>& f, detail::type_identity_t<T> x0,
+                                 std::vector<T>& y, detail::type_identity_t<T> x_target, int num_steps,
+                                 ExecutionPolicy policy = ExecutionPolicy::Parallel);
+
+/**
+ * @brief Prawa strona układu równań różniczkowych y' = f(x, y), gdzie y jest wektorem.
+ */
+using OdeSystem = std::function<std::vector<double>(double x, const std::vector<double>& y)>;
+
+/**
+ * @brief Macierz Jacobiego J_ij = df_i/dy_j prawej strony układu w punkcie (x, y).
+ */
+using OdeJacobian = std::function<std::vector<std::vector<double>>(double x, const std::vector<double>& y)>;
+
+/**
+ * @brief Obserwator trajektorii układu równań, wywoływany z parą (x, y(x)).
+ */
+using SystemObserver = std::function<void(double x, const std::vector<double>& y)>;
+
+/**
+ * @brief Parametry niejawnych (sztywnych) solverów `bdf_solve` i `rosenbrock_solve`.
+ */
+struct StiffSolverOptions {
+    double rtol = 1e-6;          ///< Tolerancja względna błędu lokalnego.
+    double atol = 1e-9;          ///< Tolerancja bezwzględna błędu lokalnego.
+    double initial_step = 0.0;   ///< Krok początkowy; 0 oznacza wybór automatyczny.
+    double max_step = 0.0;       ///< Maksymalny krok; 0 oznacza brak ograniczenia.
+    int max_steps = 100000;      ///< Maksymalna liczba kroków (przyjętych i odrzuconych).
+    OdeJacobian jacobian;        ///< Jakobian użytkownika; pusty oznacza różnice skończone (`numerical_jacobian`).
+    SystemObserver observer;     ///< Wywoływany dla punktu początkowego i po każdym przyjętym kroku (opcjonalny).
+};
+
+/**
+ * @brief Wynik sztywnego solvera wraz ze statystykami wykonanej pracy.
+ */
+struct StiffSolverResult {
+    std::vector<double> y;            ///< Rozwiązanie y(x_target).
+    int steps = 0;                    ///< Liczba przyjętych kroków.
+    int rejected_steps = 0;           ///< Liczba odrzuconych kroków.
+    int function_evaluations = 0;     ///< Liczba wywołań f (bez wywołań wewnątrz jakobianu numerycznego).
+    int jacobian_evaluations = 0;     ///< Liczba obliczeń macierzy Jacobiego.
+    int lu_decompositions = 0;        ///< Liczba rozkładów LU macierzy iteracji.
+};
+
+/**
+ * @brief Rozwiązuje sztywny układ y' = f(x, y) metodą BDF o zmiennym rzędzie (1-5) i zmiennym kroku.
+ *
+ * Metoda różnic wstecznych w postaci z tablicą różnic (jak w solverach typu NDF/BDF) dobiera
+ * rząd i krok na podstawie estymaty błędu lokalnego. Równania niejawne są rozwiązywane metodą
+ * Newtona z macierzą iteracji (I - c*J), c = h / alpha_k. Rozkład LU tej macierzy jest
+ * używany ponownie w kolejnych krokach, dopóki krok się nie zmienia; jakobian jest liczony
+ * ponownie dopiero wtedy, gdy iteracja Newtona przestaje zbiegać.
+ *
+ * @param f Prawa strona układu.
+ * @param x0 Początkowa wartość x.
+ * @param y0 Warunek początkowy y(x0) (niepusty).
+ * @param x_target Wartość x, dla której szukane jest rozwiązanie.
+ * @param options Tolerancje, ograniczenia kroku i opcjonalny jakobian.
+ * @return StiffSolverResult Rozwiązanie y(x_target) i statystyki.
+ * @throws std::invalid_argument Jeśli `y0` jest pusty lub tolerancje/ograniczenia są niepoprawne.
+ * @throws std::runtime_error Jeśli krok spadnie poniżej dokładności maszynowej lub przekroczono `max_steps`.
+ *
+ * @example
+ * @code
+ * // Sztywny układ Robertsona (kinetyka chemiczna)
+ * auto f = [](double, const std::vector<double>& y) {
+ *     return std::vector<double>{
+ *         -0.04 * y[0] + 1e4 * y[1] * y[2],
+ *          0.04 * y[0] - 1e4 * y[1] * y[2] - 3e7 * y[1] * y[1],
+ *          3e7 * y[1] * y[1]};
+ * };
+ * NumLibCpp::StiffSolverOptions opts;
+ * opts.rtol = 1e-6; opts.atol = 1e-10;
+ * auto res = NumLibCpp::bdf_solve(f, 0.0, {1.0, 0.0, 0.0}, 40.0, opts);
+ * std::cout << res.y[0] << " (kroki: " << res.steps << ")" << std::endl;
+ * @endcode
+ */
+StiffSolverResult bdf_solve(const OdeSystem& f, double x0, const std::vector<double>& y0, double x_target,
+                            const StiffSolverOptions& options = StiffSolverOptions());
+
+/**
+ * @brief Rozwiązuje sztywny układ y' = f(x, y) metodą Rosenbrocka 2(3) (Shampine, Reichelt 1997).
+ *
+ * Metoda liniowo-niejawna rzędu 2 (L-stabilna) z wbudowaną estymatą błędu rzędu 3; nie wymaga
+ * iteracji Newtona. Każdy krok korzysta z jednego rozkładu LU macierzy (I - d*h*J),
+ * d = 1/(2 + sqrt(2)), dla trzech prawych stron. Jakobian i pochodna df/dx są liczone raz na
+ * przyjęty krok; po odrzuceniu kroku są używane ponownie (ten sam punkt), a liczony jest
+ * tylko nowy rozkład LU. Ostatnie wywołanie f w kroku jest pierwszym w następnym (FSAL).
+ *
+ * @param f Prawa strona układu.
+ * @param x0 Początkowa wartość x.
+ * @param y0 Warunek początkowy y(x0) (niepusty).
+ * @param x_target Wartość x, dla której szukane jest rozwiązanie.
+ * @param options Tolerancje, ograniczenia kroku i opcjonalny jakobian.
+ * @return StiffSolverResult Rozwiązanie y(x_target) i statystyki.
+ * @throws std::invalid_argument Jeśli `y0` jest pusty lub tolerancje/ograniczenia są niepoprawne.
+ * @throws std::runtime_error Jeśli krok spadnie poniżej dokładności maszynowej lub przekroczono `max_steps`.
+ */
+StiffSolverResult rosenbrock_solve(const OdeSystem& f, double x0, const std::vector<double>& y0, double x_target,
+                                   const StiffSolverOptions& options = StiffSolverOptions());
+
 } // namespace NumLibCpp
 
 #endif //NUMLIBCPP_ODE_SOLVER_H
\ No newline at end of file
@@ -1,8 +1,13 @@
 #ifndef NUMLIBCPP_DIFFERENTIATION_H
 #define NUMLIBCPP_DIFFERENTIATION_H
 
+#include <complex>
 #include <functional>
+#include <vector>
 #include <stdexcept> // Dla std::invalid_argument
+#include <type_traits>
+#include "NumLibCpp/instrumentation.hpp"
+#include "NumLibCpp/scalar_traits.hpp"
 
 namespace NumLibCpp {
 
@@ -14,6 +19,7 @@ namespace NumLibCpp {
  * @param func Funkcja do zróżniczkowania, przyjmująca `double` i zwracająca `double`.
  * @param x Punkt, w którym obliczana jest pochodna.
  * @param h Mały krok (szerokość przedziału różniczkowania). Powinien być mały, ale nie za mały, aby uniknąć błędów numerycznych.
+ *          Domyślnie `default_difference_step<double>()` (około 6e-6), co równoważy błąd obcięcia i zaokrągleń.
  * @return double Przybliżona wartość pochodnej.
  * @throws std::invalid_argument Jeśli `h <= 0`.
  *
@@ -42,8 +48,203 @@ namespace NumLibCpp {
  * }
  * @endcode
  */
-double central_difference(std::function<double(double)> func, double x, double h);
+double central_difference(std::function<double(double)> func, double x, double h = default_difference_step<double>());
+
+namespace detail {
+
+template <typename F, typename T>
+T central_difference_impl(F& func, T x, T h) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("central_difference");
+    if (h <= 0) {
+        throw std::invalid_argument("Krok h musi byc dodatni.");
+    }
+    // Dla bardzo małych h, (x+h) może być równe x numerycznie.
+    // Zabezpieczenie przed tym jest skomplikowane i zależy od precyzji double.
+    // Tutaj zakładamy, że h jest "rozsądnie" małe.
+    NUMLIBCPP_COUNT(function_evaluations, 2);
+    return (func(x + h) - func(x - h)) / (2 * h);
+}
+
+} // namespace detail
+
+/**
+ * @brief Wariant `central_difference` dla dowolnego obiektu wywoływalnego; `func` może zostać wstawiona w miejscu wywołania.
+ */
+template <typename F, std::enable_if_t<std::is_invocable_r_v<double, F&, double>, int> = 0>
+double central_difference(F&& func, double x, double h = default_difference_step<double>()) {
+    return detail::central_difference_impl(func, x, h);
+}
+
+/**
+ * @brief Wariant `central_difference` dla typów `float` i `long double` (typ wyznaczany z `x`).
+ *
+ * Domyślny krok `default_difference_step<T>()` jest dopasowany do precyzji typu: około 5e-3 dla `float`,
+ * gdzie krok 1e-5 dawałby wynik zdominowany przez błędy zaokrągleń. Przy argumentach różnych typów
+ * (np. `float` i `double`) wywoływana jest wersja dla `double`.
+ */
+template <typename F, typename T,
+          std::enable_if_t<detail::is_alternate_scalar_v<T> && std::is_invocable_r_v<T, F&, T>, int> = 0>
+T central_difference(F&& func, T x, T h = default_difference_step<T>()) {
+    return detail::central_difference_impl(func, x, h);
+}
+
+/**
+ * @brief Oblicza numerycznie macierz Jacobiego J_ij = dF_i/dx_j funkcji wektorowej F: R^n -> R^m.
+ *
+ * Każda kolumna jest liczona różnicą centralną jak w `central_difference`, z krokiem
+ * względnym h_j = h * max(1, |x_j|), co wymaga 2n wywołań `func`.
+ *
+ * @param func Funkcja wektorowa F(x).
+ * @param x Punkt, w którym obliczana jest macierz Jacobiego.
+ * @param h Względny krok różniczkowania (musi być dodatni).
+ * @return std::vector<std::vector<double>> Macierz Jacobiego o wymiarach m x n.
+ * @throws std::invalid_argument Jeśli `h <= 0`, `x` jest pusty lub `func` zwraca wektory o różnych rozmiarach.
+ *
+ * @example
+ * @code
+ * auto F = [](const std::vector<double>& v) { return std::vector<double>{v[0] * v[1], v[0] + v[1]}; };
+ * auto J = NumLibCpp::numerical_jacobian(F, {2.0, 3.0}, 1e-6); // {{3, 2}, {1, 1}}
+ * @endcode
+ */
+std::vector<std::vector<double>> numerical_jacobian(
+    const std::function<std::vector<double>(const std::vector<double>&)>& func,
+    const std::vector<double>& x,
+    double h);
+
+/**
+ * @brief Wariant `numerical_jacobian` dla rzadkiej macierzy Jacobiego o znanym wzorcu niezerowych elementów.
+ *
+ * Kolumny, które nie mają niezerowych elementów we wspólnym wierszu, są grupowane zachłannie
+ * (metoda Curtisa-Powella-Reida) i różniczkowane jednym wspólnym przesunięciem. Koszt wynosi
+ * 2 * (liczba grup) wywołań `func` zamiast 2n; dla macierzy pasmowej o szerokości w liczba grup to w.
+ *
+ * @param func Funkcja wektorowa F(x).
+ * @param x Punkt, w którym obliczana jest macierz Jacobiego.
+ * @param h Względny krok różniczkowania (musi być dodatni).
+ * @param sparsity Wzorzec: sparsity[i] zawiera indeksy kolumn niezerowych w wierszu i (rozmiar m).
+ * @return std::vector<std::vector<double>> Macierz Jacobiego m x n (elementy spoza wzorca są zerowe).
+ * @throws std::invalid_argument Jeśli `h <= 0`, `x` jest pusty, wzorzec ma inną liczbę wierszy niż F
+ *         lub zawiera indeks kolumny spoza zakresu.
+ */
+std::vector<std::vector<double>> numerical_jacobian(
+    const std::function<std::vector<double>(const std::vector<double>&)>& func,
+    const std::vector<double>& x,
+    double h,
+    const std::vector<std::vector<int>>& sparsity);
+
+/**
+ * @brief Schemat różnicowy używany przez `numerical_gradient`, `numerical_jacobian` i `numerical_hessian`.
+ */
+enum class DifferenceStencil {
+    Forward,     ///< (f(x+h) - f(x)) / h; błąd O(h), 1 wywołanie na kolumnę (f(x) wspólne dla wszystkich kolumn).
+    Central,     ///< (f(x+h) - f(x-h)) / 2h; błąd O(h^2), 2 wywołania na kolumnę.
+    FivePoint,   ///< (-f(x+2h) + 8f(x+h) - 8f(x-h) + f(x-2h)) / 12h; błąd O(h^4), 4 wywołania na kolumnę.
+    Richardson   ///< Ekstrapolacja Richardsona różnic centralnych z krokami h i h/2; błąd O(h^4), 4 wywołania na kolumnę.
+};
+
+/**
+ * @brief Parametry numerycznego gradientu, jakobianu i hesjanu.
+ */
+struct DifferenceOptions {
+    DifferenceStencil stencil = DifferenceStencil::Central;
+    double step = 0.0;       ///< Względny krok h (h_j = step * max(1, |x_j|)); 0 oznacza wybór automatyczny.
+    bool parallel = true;    ///< Czy rozdzielać kolumny między wątki `ThreadPool::global()` (funkcja musi być bezpieczna wątkowo).
+};
+
+/**
+ * @brief Oblicza gradient funkcji f: R^n -> R różnicami skończonymi.
+ *
+ * Przy `step = 0` krok jest dobierany tak, aby zrównoważyć błąd obcięcia schematu i błąd zaokrągleń
+ * rzędu eps * |f|: h = eps^(1/2) dla schematu w przód, eps^(1/3) dla centralnego i eps^(1/5) dla
+ * schematów rzędu 4, skalowany przez max(1, |x_j|). Krok jest następnie zaokrąglany tak, by x_j + h
+ * było dokładnie reprezentowalne, co usuwa błąd reprezentacji z mianownika. Wartość f(x) jest
+ * liczona raz i używana dla wszystkich kolumn schematu w przód; kolumny są liczone równolegle.
+ *
+ * @param func Funkcja f(x).
+ * @param x Punkt (niepusty).
+ * @param options Schemat, krok i tryb równoległy.
+ * @return std::vector<double> Gradient (rozmiar n).
+ * @throws std::invalid_argument Jeśli `x` jest pusty lub `step < 0`.
+ *
+ * @example
+ * @code
+ * auto rosen = [](const std::vector<double>& v) {
+ *     return (1 - v[0]) * (1 - v[0]) + 100 * (v[1] - v[0] * v[0]) * (v[1] - v[0] * v[0]);
+ * };
+ * NumLibCpp::DifferenceOptions opts;
+ * opts.stencil = NumLibCpp::DifferenceStencil::Richardson;
+ * std::vector<double> g = NumLibCpp::numerical_gradient(rosen, {1.5, 2.0}, opts);
+ * @endcode
+ */
+std::vector<double> numerical_gradient(const std::function<double(const std::vector<double>&)>& func,
+                                       const std::vector<double>& x,
+                                       const DifferenceOptions& options = DifferenceOptions());
+
+/**
+ * @brief Wariant `numerical_jacobian` z wyborem schematu, automatycznym krokiem i obliczeniami równoległymi.
+ *
+ * Krok i schematy jak w `numerical_gradient`. Dla schematu w przód F(x) jest liczone raz
+ * (n + 1 wywołań zamiast 2n).
+ *
+ * @param func Funkcja wektorowa F(x).
+ * @param x Punkt (niepusty).
+ * @param options Schemat, krok i tryb równoległy.
+ * @return std::vector<std::vector<double>> Macierz Jacobiego m x n.
+ * @throws std::invalid_argument Jeśli `x` jest pusty, `step < 0` lub `func` zwraca wektory o różnych rozmiarach.
+ */
+std::vector<std::vector<double>> numerical_jacobian(
+    const std::function<std::vector<double>(const std::vector<double>&)>& func,
+    const std::vector<double>& x,
+    const DifferenceOptions& options);
+
+/**
+ * @brief Oblicza macierz Hessego funkcji f: R^n -> R różnicami skończonymi drugiego rzędu.
+ *
+ * Obsługiwane są schematy `Forward` (f(x), f(x + h_i e_i) i f(x + h_i e_i + h_j e_j); 1 + n + n(n+1)/2
+ * wywołań, wartości f(x) i f(x + h_i e_i) są wspólne dla wszystkich par) oraz `Central` (4 wywołania
+ * na element pozadiagonalny, 2 na diagonalny i wspólne f(x)). Krok automatyczny: eps^(1/3) dla
+ * schematu w przód, eps^(1/4) dla centralnego. Wiersze trójkąta dolnego są liczone równolegle.
+ *
+ * @param func Funkcja f(x).
+ * @param x Punkt (niepusty).
+ * @param options Schemat (`Forward` lub `Central`), krok i tryb równoległy.
+ * @return std::vector<std::vector<double>> Symetryczna macierz Hessego n x n.
+ * @throws std::invalid_argument Jeśli `x` jest pusty, `step < 0` lub wybrano schemat inny niż `Forward`/`Central`.
+ */
+std::vector<std::vector<double>> numerical_hessian(const std::function<double(const std::vector<double>&)>& func,
+                                                   const std::vector<double>& x,
+                                                   const DifferenceOptions& options = DifferenceOptions());
+
+/**
+ * @brief Gradient funkcji analitycznej metodą kroku zespolonego: df/dx_j = Im f(x + i h e_j) / h.
+ *
+ * Brak odejmowania bliskich wartości sprawia, że wynik jest dokładny do precyzji maszynowej
+ * przy h = 1e-20 (bez doboru kroku). Wymaga implementacji f dla argumentów zespolonych,
+ * w której nie występują abs, porównania ani części rzeczywiste/urojone argumentu.
+ *
+ * @param func Funkcja f(z) dla z ∈ C^n, zwracająca liczbę zespoloną.
+ * @param x Punkt (niepusty).
+ * @param parallel Czy rozdzielać kolumny między wątki `ThreadPool::global()`.
+ * @return std::vector<double> Gradient (rozmiar n).
+ * @throws std::invalid_argument Jeśli `x` jest pusty.
+ */
+std::vector<double> complex_step_gradient(
+    const std::function<std::complex<double>(const std::vector<std::complex<double>>&)>& func,
+    const std::vector<double>& x, bool parallel = true);
+
+/**
+ * @brief Macierz Jacobiego funkcji analitycznej F: C^n -> C^m metodą kroku zespolonego.
+ *
+ * @param func Funkcja F(z) zwracająca wektor zespolony (rozmiar m).
+ * @param x Punkt (niepusty).
+ * @param parallel Czy rozdzielać kolumny między wątki `ThreadPool::global()`.
+ * @return std::vector<std::vector<double>> Macierz Jacobiego m x n.
+ * @throws std::invalid_argument Jeśli `x` jest pusty lub `func` zwraca wektory o różnych rozmiarach.
+ */
+std::vector<std::vector<double>> complex_step_jacobian(
+    const std::function<std::vector<std::complex<double>>(const std::vector<std::complex<double>>&)>& func,
+    const std::vector<double>& x, bool parallel = true);
 
 } // namespace NumLibCpp
 
-#endif //NUMLIBCPP_DIFFERENTIATION_H
\ No newline at end of file
+#endif //NUMLIBCPP_DIFFERENTIATION_H
@@ -0,0 +1,94 @@
+#ifndef NUMLIBCPP_EIGEN_SOLVER_HPP
+#define NUMLIBCPP_EIGEN_SOLVER_HPP
+
+#include <complex>
+#include <vector>
+#include <stdexcept> // Dla std::runtime_error, std::invalid_argument
+
+namespace NumLibCpp {
+
+/**
+ * @brief Wartości i wektory własne macierzy symetrycznej.
+ *
+ * Wektory własne są przechowywane w jednej ciągłej tablicy: wektor odpowiadający `values[k]`
+ * zajmuje indeksy [k*n, (k+1)*n) i ma normę euklidesową 1.
+ */
+struct SymmetricEigenResult {
+    int n = 0;                    ///< Rozmiar macierzy.
+    std::vector<double> values;   ///< Wartości własne w kolejności rosnącej.
+    std::vector<double> vectors;  ///< Wektory własne (puste, jeśli nie były liczone).
+};
+
+/**
+ * @brief Oblicza wartości (i opcjonalnie wektory) własne macierzy symetrycznej.
+ *
+ * Macierz jest sprowadzana do postaci trójdiagonalnej odbiciami Householdera, a następnie
+ * diagonalizowana niejawną metodą QL z przesunięciem Wilkinsona. Obliczenia odbywają się na kopii
+ * macierzy w ciągłej tablicy; obroty QL działają na wierszach macierzy wektorów własnych,
+ * więc każdy obrót przetwarza dwa ciągłe fragmenty pamięci. Koszt: ok. 4/3 n^3 (redukcja)
+ * plus ok. 3 n^3 (wektory własne) operacji.
+ *
+ * Używany jest tylko trójkąt dolny macierzy A.
+ *
+ * @param A Kwadratowa macierz symetryczna (NxN).
+ * @param compute_vectors Czy obliczać wektory własne.
+ * @return SymmetricEigenResult Wartości własne rosnąco i odpowiadające im wektory.
+ * @throws std::invalid_argument Jeśli macierz A jest pusta lub nie jest kwadratowa.
+ * @throws std::runtime_error Jeśli iteracja QL nie zbiegnie (w praktyce nie występuje dla skończonych danych).
+ *
+ * @example
+ * @code
+ * // Drgania własne łańcucha trzech mas: K = [[2,-1,0],[-1,2,-1],[0,-1,2]]
+ * NumLibCpp::SymmetricEigenResult modes = NumLibCpp::symmetric_eigen({{2, -1, 0}, {-1, 2, -1}, {0, -1, 2}});
+ * // modes.values = {2 - sqrt(2), 2, 2 + sqrt(2)}
+ * @endcode
+ */
+SymmetricEigenResult symmetric_eigen(const std::vector<std::vector<double>>& A, bool compute_vectors = true);
+
+/**
+ * @brief Oblicza wszystkie wartości własne ogólnej (niesymetrycznej) macierzy rzeczywistej.
+ *
+ * Macierz jest równoważona (skalowanie potęgami 2 poprawiające dokładność), sprowadzana do postaci
+ * Hessenberga odbiciami Householdera i rozwiązywana podwójnie przesuniętą metodą QR Francisa.
+ * Zespolone wartości własne występują w parach sprzężonych.
+ *
+ * @param A Kwadratowa macierz (NxN).
+ * @return std::vector<std::complex<double>> Wartości własne uporządkowane według części rzeczywistej, a następnie urojonej.
+ * @throws std::invalid_argument Jeśli macierz A jest pusta lub nie jest kwadratowa.
+ * @throws std::runtime_error Jeśli iteracja QR nie zbiegnie.
+ */
+std::vector<std::complex<double>> general_eigenvalues(const std::vector<std::vector<double>>& A);
+
+/**
+ * @brief Znajduje wszystkie pierwiastki wielomianu P(x) = c_0 + c_1*x + ... + c_n*x^n.
+ *
+ * Pierwiastki są wartościami własnymi macierzy stowarzyszonej (companion matrix), która ma już
+ * postać Hessenberga, więc wystarcza równoważenie i metoda QR z `general_eigenvalues`.
+ * Opcjonalnie każdy pierwiastek jest poprawiany kilkoma krokami metody Newtona na oryginalnym
+ * wielomianie (krok jest przyjmowany tylko wtedy, gdy zmniejsza |P(x)|).
+ *
+ * Współczynniki mają tę samą kolejność co wynik `polynomial_approximation`. Zerowe współczynniki
+ * najwyższych stopni są pomijane.
+ *
+ * @param coeffs Współczynniki [c_0, c_1, ..., c_n].
+ * @param polish Czy poprawiać pierwiastki metodą Newtona.
+ * @return std::vector<std::complex<double>> Pierwiastki (z krotnościami) uporządkowane według części rzeczywistej, a następnie urojonej.
+ * @throws std::invalid_argument Jeśli `coeffs` jest pusty lub wszystkie współczynniki są zerowe.
+ * @throws std::runtime_error Jeśli iteracja QR nie zbiegnie.
+ *
+ * @example
+ * @code
+ * // Ekstrema dopasowanego wielomianu: pierwiastki pochodnej
+ * std::vector<double> c = NumLibCpp::polynomial_approximation(my_func, -1.0, 2.0, 5, 100);
+ * std::vector<double> dc;
+ * for (size_t i = 1; i < c.size(); ++i) dc.push_back(i * c[i]);
+ * for (const auto& r : NumLibCpp::polynomial_roots(dc)) {
+ *     if (std::abs(r.imag()) < 1e-12) std::cout << "Ekstremum w x = " << r.real() << std::endl;
+ * }
+ * @endcode
+ */
+std::vector<std::complex<double>> polynomial_roots(const std::vector<double>& coeffs, bool polish = true);
+
+} // namespace NumLibCpp
+
+#endif // NUMLIBCPP_EIGEN_SOLVER_HPP
@@ -0,0 +1,30 @@
+#ifndef NUMLIBCPP_EXECUTION_HPP
+#define NUMLIBCPP_EXECUTION_HPP
+
+#include "thread_pool.hpp"
+
+namespace NumLibCpp {
+
+/**
+ * @brief Sposób wykonania obliczeń przyjmowany przez funkcje z argumentem `policy`.
+ *
+ * Ścieżki równoległe korzystają wyłącznie z globalnej puli (`ThreadPool::global()`). Wywołanie
+ * równoległe zagnieżdżone w zadaniu puli (np. całki liczone wewnątrz równoległej aproksymacji)
+ * wykonuje się w bieżącym wątku, więc liczba aktywnych wątków nigdy nie przekracza rozmiaru puli.
+ *
+ * Wyniki nie zależą od liczby wątków: podział pracy na fragmenty jest stały, a sumy częściowe są
+ * łączone w ustalonej kolejności. Mogą natomiast różnić się od wyniku sekwencyjnego na poziomie
+ * błędów zaokrągleń, jeśli dana funkcja zmienia kolejność sumowania (opisano to przy funkcji).
+ *
+ * Funkcje użytkownika przekazywane w trybach równoległych muszą być bezpieczne przy wywołaniach
+ * z wielu wątków jednocześnie.
+ */
+enum class ExecutionPolicy {
+    Sequential,   ///< Całość w wątku wywołującym.
+    Parallel,     ///< Podział pracy między wątki globalnej puli.
+    ParallelSimd  ///< Jak `Parallel`, a wewnątrz fragmentów pętle ułożone pod wektoryzację (kilka niezależnych akumulatorów).
+};
+
+} // namespace NumLibCpp
+
+#endif // NUMLIBCPP_EXECUTION_HPP
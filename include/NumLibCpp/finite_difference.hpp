@@ -0,0 +1,178 @@
+#ifndef NUMLIBCPP_FINITE_DIFFERENCE_HPP
+#define NUMLIBCPP_FINITE_DIFFERENCE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <stdexcept> // Dla std::invalid_argument
+
+namespace NumLibCpp {
+
+/**
+ * @brief Oblicza wagi różnicowe algorytmem Fornberga (1988) dla dowolnie rozmieszczonych węzłów.
+ *
+ * Zwraca wagi w_j takie, że f^(m)(x0) ≈ sum_j w_j f(nodes_j); przy q węzłach przybliżenie
+ * jest dokładne dla wielomianów stopnia q - 1 (rząd dokładności co najmniej q - m).
+ *
+ * @param x0 Punkt, w którym przybliżana jest pochodna.
+ * @param nodes Różne węzły (co najmniej derivative + 1).
+ * @param derivative Rząd pochodnej m (>= 0).
+ * @return std::vector<double> Wagi dla kolejnych węzłów.
+ * @throws std::invalid_argument Jeśli `derivative < 0` lub węzłów jest za mało.
+ *
+ * @example
+ * @code
+ * auto w = NumLibCpp::fornberg_weights(0.0, {-1.0, 0.0, 1.0}, 2); // {1, -2, 1}
+ * @endcode
+ */
+std::vector<double> fornberg_weights(double x0, const std::vector<double>& nodes, int derivative);
+
+/**
+ * @brief Operator różnicowy pochodnej m-tego rzędu na siatce 1-D, stosowany do całych tablic wartości.
+ *
+ * Wagi są liczone raz w konstruktorze (algorytm Fornberga) i używane dla wszystkich wywołań `apply`.
+ * Na siatce równomiernej wnętrze korzysta z symetrycznego szablonu centralnego o wspólnych wagach,
+ * a na siatce nierównomiernej z szablonu o m + accuracy węzłach z wagami zapisanymi kolumnami
+ * (osobna tablica dla każdego przesunięcia). W obu przypadkach pętla wewnętrzna przebiega po
+ * kolejnych punktach siatki bez rozgałęzień, więc kompilator może ją zwektoryzować, a punkty są
+ * przetwarzane blokami mieszczącymi się w pamięci podręcznej. Przy brzegach używane są szablony
+ * jednostronne o m + accuracy węzłach, zachowujące rząd dokładności.
+ *
+ * @example
+ * @code
+ * // Druga pochodna 4. rzędu z 1001 próbek na [0, 1]
+ * NumLibCpp::FiniteDifferenceStencil d2(1001, 1e-3, 2, 4);
+ * std::vector<double> u = samples();
+ * d2.apply(u.data(), u.data()); // W miejscu
+ * @endcode
+ */
+class FiniteDifferenceStencil {
+public:
+    /**
+     * @brief Tworzy operator dla siatki równomiernej o n węzłach i kroku dx.
+     *
+     * @param n Liczba węzłów.
+     * @param dx Odstęp węzłów (dodatni).
+     * @param derivative Rząd pochodnej (>= 1).
+     * @param accuracy Rząd dokładności (parzysty, >= 2).
+     * @throws std::invalid_argument Przy niepoprawnych parametrach lub gdy n jest mniejsze od liczby węzłów szablonu.
+     */
+    FiniteDifferenceStencil(std::size_t n, double dx, int derivative, int accuracy = 2);
+
+    /**
+     * @brief Tworzy operator dla siatki nierównomiernej o węzłach x (ściśle rosnących).
+     *
+     * @param x Węzły siatki.
+     * @param derivative Rząd pochodnej (>= 1).
+     * @param accuracy Rząd dokładności (parzysty, >= 2).
+     * @throws std::invalid_argument Przy niepoprawnych parametrach, nierosnących węzłach lub zbyt małej liczbie węzłów.
+     */
+    FiniteDifferenceStencil(const std::vector<double>& x, int derivative, int accuracy = 2);
+
+    /**
+     * @brief Liczba węzłów siatki.
+     */
+    std::size_t size() const { return n_; }
+
+    /**
+     * @brief Zapisuje pochodną wartości f (n elementów) do out (n elementów).
+     *
+     * `out` może być równe `f` (obliczenie w miejscu); inne częściowe nakładanie się tablic nie jest dozwolone.
+     */
+    void apply(const double* f, double* out) const;
+
+    /**
+     * @brief Zwraca pochodną wartości f.
+     * @throws std::invalid_argument Jeśli `f.size()` jest różne od liczby węzłów.
+     */
+    std::vector<double> apply(const std::vector<double>& f) const;
+
+    /**
+     * @brief Stosuje operator wzdłuż osi o kroku pamięci `stride` dla `width` sąsiednich linii.
+     *
+     * Element (i, t) ma indeks i * stride + t dla i = 0..n-1, t = 0..width-1. Pętla wewnętrzna
+     * przebiega po t (ciągły fragment pamięci). Tablice `f` i `out` nie mogą się nakładać.
+     */
+    void apply_lines(const double* f, std::size_t f_stride, double* out, std::size_t out_stride,
+                     std::size_t width) const;
+
+private:
+    void build_boundary(const std::vector<double>& x, int derivative, double scale);
+    void apply_row(const double* f, double* out) const;
+
+    std::size_t n_ = 0;
+    std::size_t interior_points_ = 0;        // Liczba węzłów szablonu wewnętrznego
+    std::size_t interior_offset_ = 0;        // Węzeł początkowy szablonu dla punktu i: i - interior_offset_
+    std::size_t interior_begin_ = 0;         // Punkty wewnętrzne: [interior_begin_, interior_end_)
+    std::size_t interior_end_ = 0;
+    std::vector<double> uniform_weights_;    // Wspólne wagi (siatka równomierna)
+    std::vector<double> interior_table_;     // Wagi kolumnami: [k * (liczba punktów wewn.) + i] (siatka nierównomierna)
+    std::size_t boundary_points_ = 0;        // Liczba węzłów szablonu brzegowego
+    std::vector<std::size_t> boundary_index_; // Punkty brzegowe
+    std::vector<std::size_t> boundary_start_; // Pierwszy węzeł szablonu punktu brzegowego
+    std::vector<double> boundary_weights_;   // Wagi punktów brzegowych (boundary_points_ na punkt)
+};
+
+/**
+ * @brief Pochodna na siatce równomiernej 1-D (wygodny wariant `FiniteDifferenceStencil`).
+ *
+ * @param f Wartości w węzłach (co najmniej derivative + accuracy).
+ * @param dx Odstęp węzłów (dodatni).
+ * @param derivative Rząd pochodnej (>= 1).
+ * @param accuracy Rząd dokładności (parzysty, >= 2).
+ * @return std::vector<double> Pochodna we wszystkich węzłach.
+ * @throws std::invalid_argument Przy niepoprawnych parametrach.
+ */
+std::vector<double> grid_derivative(const std::vector<double>& f, double dx, int derivative, int accuracy = 2);
+
+/**
+ * @brief Pochodna na siatce nierównomiernej 1-D o węzłach x.
+ *
+ * @param f Wartości w węzłach (rozmiar równy `x`).
+ * @param x Węzły siatki (ściśle rosnące).
+ * @param derivative Rząd pochodnej (>= 1).
+ * @param accuracy Rząd dokładności (parzysty, >= 2).
+ * @return std::vector<double> Pochodna we wszystkich węzłach.
+ * @throws std::invalid_argument Przy niepoprawnych parametrach lub niezgodnych rozmiarach.
+ */
+std::vector<double> grid_derivative(const std::vector<double>& f, const std::vector<double>& x, int derivative,
+                                    int accuracy = 2);
+
+/**
+ * @brief Pochodna cząstkowa wzdłuż osi `axis` tablicy 2-D (układ wierszami: indeks j * nx + i).
+ *
+ * Dla osi x (axis = 0) każdy wiersz jest przetwarzany jak tablica 1-D; dla osi y (axis = 1)
+ * kolumny są przetwarzane paczkami sąsiednich kolumn, tak aby pętla wewnętrzna przebiegała po
+ * ciągłej pamięci. Wiersze i paczki są rozdzielane między wątki `ThreadPool::global()`.
+ * `out` może być równe `f` (obliczenie w miejscu).
+ *
+ * @param stencil Operator o rozmiarze równym długości osi (nx lub ny).
+ * @param f Wartości (nx * ny elementów).
+ * @param out Wynik (nx * ny elementów).
+ * @param nx Liczba węzłów w kierunku x.
+ * @param ny Liczba węzłów w kierunku y.
+ * @param axis 0 - pochodna po x, 1 - pochodna po y.
+ * @throws std::invalid_argument Jeśli `axis` jest niepoprawna lub rozmiar operatora nie odpowiada osi.
+ */
+void grid_derivative_2d(const FiniteDifferenceStencil& stencil, const double* f, double* out,
+                        std::size_t nx, std::size_t ny, int axis);
+
+/**
+ * @brief Pochodna cząstkowa wzdłuż osi `axis` tablicy 3-D (indeks (k * ny + j) * nx + i).
+ *
+ * Działa jak `grid_derivative_2d`; dla osi z (axis = 2) paczki obejmują sąsiednie elementy płaszczyzn xy.
+ *
+ * @param stencil Operator o rozmiarze równym długości osi (nx, ny lub nz).
+ * @param f Wartości (nx * ny * nz elementów).
+ * @param out Wynik (może być równy `f`).
+ * @param nx Liczba węzłów w kierunku x.
+ * @param ny Liczba węzłów w kierunku y.
+ * @param nz Liczba węzłów w kierunku z.
+ * @param axis 0, 1 lub 2 (x, y, z).
+ * @throws std::invalid_argument Jeśli `axis` jest niepoprawna lub rozmiar operatora nie odpowiada osi.
+ */
+void grid_derivative_3d(const FiniteDifferenceStencil& stencil, const double* f, double* out,
+                        std::size_t nx, std::size_t ny, std::size_t nz, int axis);
+
+} // namespace NumLibCpp
+
+#endif // NUMLIBCPP_FINITE_DIFFERENCE_HPP
@@ -0,0 +1,155 @@
+#ifndef NUMLIBCPP_INSTRUMENTATION_HPP
+#define NUMLIBCPP_INSTRUMENTATION_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <stdexcept> // Dla std::runtime_error
+
+// Włączane opcją CMake NUMLIBCPP_ENABLE_INSTRUMENTATION (definicja NUMLIBCPP_INSTRUMENTATION=1).
+// Przy wyłączonej instrumentacji makra NUMLIBCPP_INSTRUMENT_SCOPE i NUMLIBCPP_COUNT nie generują kodu.
+#ifndef NUMLIBCPP_INSTRUMENTATION
+#define NUMLIBCPP_INSTRUMENTATION 0
+#endif
+
+namespace NumLibCpp {
+
+/// Czy biblioteka została zbudowana z instrumentacją.
+constexpr bool instrumentation_enabled = NUMLIBCPP_INSTRUMENTATION != 0;
+
+/**
+ * @brief Liczniki pracy jednego punktu wejścia API (np. "simpson_integrate").
+ *
+ * Liczniki są przypisywane do najbardziej wewnętrznego aktywnego zakresu w danym wątku, np. wywołania
+ * funkcji użytkownika wykonane przez `simpson_integrate` wewnątrz `polynomial_approximation` są
+ * liczone dla `simpson_integrate`. Czas `wall_time_ns` obejmuje zagnieżdżone wywołania.
+ */
+struct EntryPointStats {
+    std::string name;                       ///< Nazwa punktu wejścia.
+    std::uint64_t calls = 0;                ///< Liczba wywołań.
+    std::uint64_t function_evaluations = 0; ///< Wywołania funkcji użytkownika.
+    std::uint64_t iterations = 0;           ///< Iteracje (kroki całkowania, kolumny eliminacji, ...).
+    std::uint64_t pivots = 0;               ///< Zamiany wierszy przy wyborze elementu głównego.
+    std::uint64_t allocations = 0;          ///< Alokacje buforów roboczych.
+    std::uint64_t wall_time_ns = 0;         ///< Łączny czas wywołań [ns].
+};
+
+/**
+ * @brief Stan liczników zsumowany po wszystkich wątkach.
+ */
+struct InstrumentationSnapshot {
+    std::vector<EntryPointStats> entries; ///< Punkty wejścia uporządkowane według nazwy.
+
+    /// Zwraca liczniki punktu wejścia `name` lub nullptr, jeśli nie był wywołany.
+    const EntryPointStats* find(const std::string& name) const;
+};
+
+/**
+ * @brief Zwraca sumę liczników ze wszystkich wątków (także zakończonych).
+ *
+ * Każdy wątek zapisuje wyłącznie własne liczniki, więc instrumentacja nie wprowadza rywalizacji
+ * o pamięć. Migawka wykonana w trakcie pracy innych wątków może nie zawierać ich najnowszych zdarzeń.
+ * Bez instrumentacji zwraca pustą migawkę.
+ *
+ * @example
+ * @code
+ * NumLibCpp::instrumentation_reset();
+ * NumLibCpp::polynomial_approximation(f, 0.0, 1.0, 4, 1000);
+ * for (const auto& e : NumLibCpp::instrumentation_snapshot().entries) {
+ *     std::cout << e.name << ": " << e.function_evaluations << " wywolan f, " << e.wall_time_ns << " ns" << std::endl;
+ * }
+ * @endcode
+ */
+InstrumentationSnapshot instrumentation_snapshot();
+
+/**
+ * @brief Zeruje liczniki we wszystkich wątkach.
+ */
+void instrumentation_reset();
+
+/**
+ * @brief Zapis przebiegu wywołań w formacie Chrome Trace Event (chrome://tracing, Perfetto).
+ *
+ * Dopóki obiekt istnieje, każdy instrumentowany zakres jest zapisywany jako zdarzenie "X"
+ * (początek i czas trwania w mikrosekundach, identyfikator wątku). Jednocześnie może istnieć
+ * tylko jedna sesja. Jeśli podano ścieżkę, plik jest zapisywany w destruktorze.
+ *
+ * @example
+ * @code
+ * {
+ *     NumLibCpp::TraceSession trace("numlib_trace.json");
+ *     NumLibCpp::bdf_solve(f, 0.0, y0, 40.0, options);
+ * } // Plik zapisany - otworzyć w chrome://tracing
+ * @endcode
+ */
+class TraceSession {
+public:
+    /**
+     * @param path Plik zapisywany w destruktorze (pusty - brak automatycznego zapisu).
+     * @throws std::runtime_error Jeśli inna sesja jest już aktywna.
+     */
+    explicit TraceSession(std::string path = "");
+    ~TraceSession();
+
+    TraceSession(const TraceSession&) = delete;
+    TraceSession& operator=(const TraceSession&) = delete;
+
+    /// Kończy zbieranie zdarzeń (wywoływane też przez destruktor).
+    void stop();
+
+    /// Zapisuje zebrane zdarzenia jako JSON.
+    void write(std::ostream& os) const;
+
+    /**
+     * @brief Zapisuje zebrane zdarzenia do pliku.
+     * @throws std::runtime_error Jeśli pliku nie można otworzyć.
+     */
+    void write(const std::string& path) const;
+
+private:
+    std::string path_;
+    bool active_ = false;
+};
+
+namespace detail {
+
+enum class Counter { function_evaluations, iterations, pivots, allocations };
+
+struct EntryPointSlot;
+
+/// Zakres punktu wejścia: zlicza wywołanie i czas, kieruje liczniki wątku do swojego punktu wejścia.
+class InstrumentScope {
+public:
+    explicit InstrumentScope(const char* name);
+    ~InstrumentScope();
+
+    InstrumentScope(const InstrumentScope&) = delete;
+    InstrumentScope& operator=(const InstrumentScope&) = delete;
+
+private:
+    EntryPointSlot* slot_;
+    EntryPointSlot* parent_;
+    std::int64_t start_ns_;
+};
+
+/// Dodaje `amount` do licznika bieżącego zakresu wątku.
+void instrument_count(Counter counter, std::uint64_t amount);
+
+} // namespace detail
+
+} // namespace NumLibCpp
+
+#if NUMLIBCPP_INSTRUMENTATION
+#define NUMLIBCPP_INSTRUMENT_CONCAT_(a, b) a##b
+#define NUMLIBCPP_INSTRUMENT_NAME_(line) NUMLIBCPP_INSTRUMENT_CONCAT_(numlibcpp_instrument_scope_, line)
+#define NUMLIBCPP_INSTRUMENT_SCOPE(name) \
+    ::NumLibCpp::detail::InstrumentScope NUMLIBCPP_INSTRUMENT_NAME_(__LINE__)(name)
+#define NUMLIBCPP_COUNT(counter, amount) \
+    ::NumLibCpp::detail::instrument_count(::NumLibCpp::detail::Counter::counter, static_cast<std::uint64_t>(amount))
+#else
+#define NUMLIBCPP_INSTRUMENT_SCOPE(name) ((void)0)
+#define NUMLIBCPP_COUNT(counter, amount) ((void)0)
+#endif
+
+#endif // NUMLIBCPP_INSTRUMENTATION_HPP
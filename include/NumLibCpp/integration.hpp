@@ -1,8 +1,15 @@
 #ifndef NUMLIBCPP_INTEGRATION_H
 #define NUMLIBCPP_INTEGRATION_H
 
+#include <algorithm> // Dla std::min
 #include <functional>
 #include <stdexcept> // Dla std::invalid_argument
+#include <type_traits>
+#include <utility>   // Dla std::swap
+#include <vector>
+#include "NumLibCpp/execution.hpp"
+#include "NumLibCpp/instrumentation.hpp"
+#include "NumLibCpp/scalar_traits.hpp"
 
 namespace NumLibCpp {
 
@@ -43,6 +50,164 @@ namespace NumLibCpp {
  */
 double simpson_integrate(std::function<double(double)> func, double a, double b, int n);
 
+/**
+ * @brief Wariant `simpson_integrate` z wyborem sposobu wykonania.
+ *
+ * W trybach równoległych węzły x_1 ... x_{n-1} są dzielone na fragmenty o stałej długości, a sumy
+ * fragmentów dodawane w kolejności, więc wynik nie zależy od liczby wątków (od wyniku sekwencyjnego
+ * może różnić się o błąd zaokrągleń). `ParallelSimd` najpierw wyznacza wartości funkcji dla bloku
+ * węzłów, a następnie sumuje je w czterech niezależnych akumulatorach. `func` musi być bezpieczna
+ * przy wywołaniach z wielu wątków.
+ *
+ * @param policy Sposób wykonania (zob. `ExecutionPolicy`).
+ */
+double simpson_integrate(std::function<double(double)> func, double a, double b, int n, ExecutionPolicy policy);
+
+namespace detail {
+
+// Liczba węzłów w jednym fragmencie ścieżki równoległej (parzysta - fragment zaczyna się od węzła nieparzystego)
+constexpr int simpson_chunk = 4096;
+
+// Suma ważona 4*f(x_i) (i nieparzyste) + 2*f(x_i) (i parzyste) dla i w [i0, i1)
+template <typename F, typename T>
+T simpson_partial_sum(F& func, T a, T h, int i0, int i1) {
+    T sum = 0;
+    for (int i = i0; i < i1; ++i) {
+        T x = a + i * h;
+        if (i % 2 == 1) {
+            sum += 4 * func(x);
+        } else {
+            sum += 2 * func(x);
+        }
+    }
+    return sum;
+}
+
+// Jak simpson_partial_sum, ale wartości funkcji trafiają najpierw do bufora, a sumowanie odbywa się
+// w czterech akumulatorach (dwa dla wag 4, dwa dla wag 2), co pozwala wektoryzować redukcję.
+// Wymaga nieparzystego i0.
+template <typename F, typename T>
+T simpson_partial_sum_simd(F& func, T a, T h, int i0, int i1) {
+    constexpr int block = 256;
+    T fx[block];
+    T odd0 = 0, odd1 = 0, even0 = 0, even1 = 0;
+    for (int start = i0; start < i1; start += block) {
+        const int m = std::min(block, i1 - start);
+        for (int k = 0; k < m; ++k) {
+            fx[k] = func(a + (start + k) * h);
+        }
+        int k = 0;
+        for (; k + 4 <= m; k += 4) { // start nieparzysty: fx[k], fx[k+2] - węzły nieparzyste
+            odd0 += fx[k];
+            even0 += fx[k + 1];
+            odd1 += fx[k + 2];
+            even1 += fx[k + 3];
+        }
+        for (; k < m; ++k) {
+            if (k % 2 == 0) odd0 += fx[k]; else even0 += fx[k];
+        }
+    }
+    return 4 * (odd0 + odd1) + 2 * (even0 + even1);
+}
+
+// Wspólna implementacja wersji z std::function i wersji szablonowej
+template <typename F, typename T>
+T simpson_integrate_impl(F& func, T a, T b, int n, ExecutionPolicy policy = ExecutionPolicy::Sequential) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("simpson_integrate");
+    if (n <= 0) {
+        throw std::invalid_argument("Liczba podprzedzialow n musi byc dodatnia.");
+    }
+    if (n % 2 != 0) {
+        throw std::invalid_argument("Liczba podprzedzialow n musi byc parzysta dla metody Simpsona.");
+    }
+    if (a == b) { // Całka po punkcie jest 0
+        return 0;
+    }
+    T sign = 1;
+    if (a > b) { // Odwracamy granice i znak
+        std::swap(a, b);
+        sign = -1.0;
+    }
+
+
+    T h = (b - a) / n;
+    T sum = func(a) + func(b); // f(x_0) + f(x_n)
+
+    if (policy == ExecutionPolicy::Sequential) {
+        for (int i = 1; i < n; ++i) {
+            T x = a + i * h;
+            if (i % 2 == 1) { // Nieparzyste indeksy (x_1, x_3, ...)
+                sum += 4 * func(x);
+            } else { // Parzyste indeksy (x_2, x_4, ...)
+                sum += 2 * func(x);
+            }
+        }
+    } else {
+        // Stały podział na fragmenty i sumowanie w kolejności - wynik niezależny od liczby wątków
+        const std::size_t chunks = static_cast<std::size_t>((n - 1 + simpson_chunk - 1) / simpson_chunk);
+        std::vector<T> partial(chunks, T(0));
+        ThreadPool::global().parallel_for(0, chunks, 1, [&](std::size_t lo, std::size_t hi) {
+            for (std::size_t c = lo; c < hi; ++c) {
+                const int i0 = 1 + static_cast<int>(c) * simpson_chunk;
+                const int i1 = std::min(i0 + simpson_chunk, n);
+                partial[c] = policy == ExecutionPolicy::ParallelSimd ? simpson_partial_sum_simd(func, a, h, i0, i1)
+                                                                     : simpson_partial_sum(func, a, h, i0, i1);
+            }
+        });
+        for (T p : partial) {
+            sum += p;
+        }
+    }
+
+    NUMLIBCPP_COUNT(function_evaluations, n + 1);
+    return sign * sum * h / 3;
+}
+
+} // namespace detail
+
+/**
+ * @brief Wariant `simpson_integrate` dla dowolnego obiektu wywoływalnego (lambda, funktor, wskaźnik do funkcji).
+ *
+ * Typ integrandu jest znany w miejscu wywołania, więc kompilator może wstawić go w pętlę sumowania
+ * zamiast wywołania pośredniego przez `std::function` (bez alokacji dla dużych domknięć).
+ * Obiekt `std::function` nadal trafia do wersji nieszablonowej, zachowanej dla zgodności binarnej.
+ *
+ * @example
+ * @code
+ * double k = 3.0;
+ * double I = NumLibCpp::simpson_integrate([k](double x) { return std::exp(-k * x * x); }, 0.0, 1.0, 1000);
+ * @endcode
+ */
+template <typename F, std::enable_if_t<std::is_invocable_r_v<double, F&, double>, int> = 0>
+double simpson_integrate(F&& func, double a, double b, int n) {
+    return detail::simpson_integrate_impl(func, a, b, n);
+}
+
+/**
+ * @brief Wariant szablonowy `simpson_integrate` z wyborem sposobu wykonania.
+ */
+template <typename F, std::enable_if_t<std::is_invocable_r_v<double, F&, double>, int> = 0>
+double simpson_integrate(F&& func, double a, double b, int n, ExecutionPolicy policy) {
+    return detail::simpson_integrate_impl(func, a, b, n, policy);
+}
+
+/**
+ * @brief Wariant `simpson_integrate` dla typów `float` i `long double` (typ wyniku jak typ granic).
+ *
+ * Sumowanie odbywa się w typie `T`, więc dla `float` pętle wektoryzują się na dwukrotnie większej liczbie
+ * elementów niż dla `double`. Wywołania z granicami typu `double` trafiają do wersji powyżej.
+ *
+ * @example
+ * @code
+ * float I = NumLibCpp::simpson_integrate([](float x) { return std::exp(-x * x); }, 0.0f, 2.0f, 1000);
+ * @endcode
+ */
+template <typename F, typename T,
+          std::enable_if_t<detail::is_alternate_scalar_v<T> && std::is_invocable_r_v<T, F&, T>, int> = 0>
+T simpson_integrate(F&& func, T a, T b, int n, ExecutionPolicy policy = ExecutionPolicy::Sequential) {
+    return detail::simpson_integrate_impl(func, a, b, n, policy);
+}
+
 } // namespace NumLibCpp
 
 #endif //NUMLIBCPP_INTEGRATION_H
\ No newline at end of file
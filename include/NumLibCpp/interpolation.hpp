@@ -3,6 +3,9 @@
 
 #include <vector>
 #include <stdexcept> // Dla std::invalid_argument
+#include "NumLibCpp/execution.hpp"
+#include "NumLibCpp/scalar_traits.hpp"
+#include "NumLibCpp/workspace.hpp"
 
 namespace NumLibCpp {
 
@@ -36,6 +39,69 @@ namespace NumLibCpp {
  */
 double lagrange_interpolate(const std::vector<double>& x_nodes, const std::vector<double>& y_nodes, double x_interp);
 
+/**
+ * @brief Oblicza wartości wielomianu interpolacyjnego Lagrange'a w wielu punktach naraz.
+ *
+ * Wielomian jest wyznaczany w postaci barycentrycznej: wagi węzłów są liczone raz (O(N^2)),
+ * a każdy punkt kosztuje O(N) zamiast O(N^2) jak przy wielokrotnym wywołaniu wersji punktowej.
+ * Wyniki różnią się od wersji punktowej tylko błędami zaokrągleń; w węzłach zwracane są dokładnie `y_nodes`.
+ * W trybie `ParallelSimd` punkty są przetwarzane blokami, a pętla po punktach bloku jest wektoryzowana.
+ * Wynik nie zależy od sposobu wykonania.
+ *
+ * @param x_nodes Wektor współrzędnych x węzłów. Muszą być unikalne.
+ * @param y_nodes Wektor współrzędnych y węzłów.
+ * @param x_interp Punkty, w których mają być obliczone wartości.
+ * @param policy Sposób wykonania (zob. `ExecutionPolicy`).
+ * @return std::vector<double> Wartości interpolowane w kolejności `x_interp`.
+ * @throws std::invalid_argument W tych samych przypadkach co wersja punktowa.
+ *
+ * @example
+ * @code
+ * std::vector<double> xs(1000);
+ * for (size_t i = 0; i < xs.size(); ++i) xs[i] = 2.0 * i / (xs.size() - 1);
+ * std::vector<double> ys = NumLibCpp::lagrange_interpolate(x_nodes, y_nodes, xs, NumLibCpp::ExecutionPolicy::Parallel);
+ * @endcode
+ */
+std::vector<double> lagrange_interpolate(const std::vector<double>& x_nodes, const std::vector<double>& y_nodes,
+                                         const std::vector<double>& x_interp,
+                                         ExecutionPolicy policy = ExecutionPolicy::Sequential);
+
+/**
+ * @brief Wariant wsadowy zapisujący wyniki do `out`, z wagami barycentrycznymi w arenie `workspace`.
+ *
+ * W trybie `Sequential`, przy rozgrzanej arenie i wystarczającej pojemności `out`, nie alokuje pamięci.
+ *
+ * @param out Wektor wynikowy (rozmiar ustawiany na rozmiar `x_interp`).
+ * @param workspace Arena na wagi węzłów.
+ */
+void lagrange_interpolate(const std::vector<double>& x_nodes, const std::vector<double>& y_nodes,
+                          const std::vector<double>& x_interp, std::vector<double>& out, Workspace& workspace,
+                          ExecutionPolicy policy = ExecutionPolicy::Sequential);
+
+/**
+ * @brief Warianty `lagrange_interpolate` dla dowolnego typu skalarnego (`float`, `double`, `long double`).
+ *
+ * Typ jest wyznaczany z wektorów węzłów. Biblioteka zawiera jawne konkretyzacje dla trzech typów
+ * zmiennoprzecinkowych; wersje dla `double` powyżej dają wyniki identyczne z `lagrange_interpolate<double>`.
+ *
+ * @example
+ * @code
+ * std::vector<float> xs = {0.0f, 1.0f, 2.0f}, ys = {0.0f, 1.0f, 4.0f};
+ * float y = NumLibCpp::lagrange_interpolate(xs, ys, 1.5f); // 2.25f
+ * @endcode
+ */
+template <typename T>
+T lagrange_interpolate(const std::vector<T>& x_nodes, const std::vector<T>& y_nodes, detail::type_identity_t<T> x_interp);
+
+template <typename T>
+std::vector<T> lagrange_interpolate(const std::vector<T>& x_nodes, const std::vector<T>& y_nodes,
+                                    const std::vector<T>& x_interp, ExecutionPolicy policy = ExecutionPolicy::Sequential);
+
+template <typename T>
+void lagrange_interpolate(const std::vector<T>& x_nodes, const std::vector<T>& y_nodes,
+                          const std::vector<T>& x_interp, std::vector<T>& out, Workspace& workspace,
+                          ExecutionPolicy policy = ExecutionPolicy::Sequential);
+
 } // namespace NumLibCpp
 
 #endif //NUMLIBCPP_INTERPOLATION_H
\ No newline at end of file
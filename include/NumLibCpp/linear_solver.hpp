@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <stdexcept> // Dla std::runtime_error, std::invalid_argument
+#include "NumLibCpp/execution.hpp"
+#include "NumLibCpp/workspace.hpp"
 
 namespace NumLibCpp {
 
@@ -20,6 +22,154 @@ namespace NumLibCpp {
  */
 std::vector<double> gauss_elimination(std::vector<std::vector<double>> A, std::vector<double> b);
 
+/**
+ * @brief Wariant `gauss_elimination` z wyborem sposobu wykonania.
+ *
+ * W trybach równoległych (dla N >= 64) eliminacja w każdej kolumnie jest rozdzielana między wątki puli
+ * blokami wierszy. Każdy wiersz jest przetwarzany w tej samej kolejności działań co sekwencyjnie,
+ * więc wynik jest identyczny z wynikiem sekwencyjnym. Pętla wewnętrzna działa na ciągłym wierszu
+ * i jest wektoryzowana przez kompilator także w trybie `Sequential`, dlatego `ParallelSimd` działa tu jak `Parallel`.
+ *
+ * @param policy Sposób wykonania (zob. `ExecutionPolicy`).
+ */
+std::vector<double> gauss_elimination(std::vector<std::vector<double>> A, std::vector<double> b, ExecutionPolicy policy);
+
+/**
+ * @brief Eliminacja Gaussa-Jordana w miejscu, bez alokacji pamięci.
+ *
+ * Działania są wykonywane w tej samej kolejności co w `gauss_elimination`, więc wynik jest identyczny.
+ *
+ * @param A Macierz NxN zapisana wierszami (element (i, j) pod indeksem i*n + j); po wywołaniu nieokreślona.
+ * @param b Wektor wyrazów wolnych (N); po wywołaniu zawiera rozwiązanie x.
+ * @param n Rozmiar układu (musi być dodatni).
+ * @throws std::invalid_argument Jeśli `n <= 0`.
+ * @throws std::runtime_error Jeśli macierz A jest osobliwa (nieodwracalna).
+ */
+void gauss_elimination_in_place(double* A, double* b, int n);
+
+/**
+ * @brief Wariant `gauss_elimination` zapisujący rozwiązanie do `x`, z kopią roboczą macierzy w arenie `workspace`.
+ *
+ * Gdy `x` ma już wystarczającą pojemność, a arena została rozgrzana poprzednim wywołaniem
+ * dla układu tego samego rozmiaru, funkcja nie alokuje pamięci.
+ *
+ * @param x Wektor wynikowy (rozmiar ustawiany na N).
+ * @param workspace Arena na kopię roboczą macierzy A.
+ * @throws std::invalid_argument, std::runtime_error Jak w `gauss_elimination`.
+ */
+void gauss_elimination(const std::vector<std::vector<double>>& A, const std::vector<double>& b, std::vector<double>& x,
+                       Workspace& workspace);
+
+/**
+ * @brief Warianty `gauss_elimination` dla dowolnego typu skalarnego (`float`, `double`, `long double`).
+ *
+ * Kryterium osobliwości to `std::numeric_limits<T>::epsilon()`. Definicje znajdują się w bibliotece,
+ * która zawiera jawne konkretyzacje dla trzech typów zmiennoprzecinkowych; wersje dla `double`
+ * powyżej dają wyniki identyczne z `gauss_elimination<double>`.
+ *
+ * @example
+ * @code
+ * std::vector<std::vector<float>> A = {{2.0f, 1.0f}, {1.0f, 3.0f}};
+ * std::vector<float> x = NumLibCpp::gauss_elimination<float>(A, {3.0f, 5.0f});
+ * @endcode
+ */
+template <typename T>
+std::vector<T> gauss_elimination(std::vector<std::vector<T>> A, std::vector<T> b,
+                                 ExecutionPolicy policy = ExecutionPolicy::Sequential);
+
+template <typename T>
+void gauss_elimination_in_place(T* A, T* b, int n);
+
+template <typename T>
+void gauss_elimination(const std::vector<std::vector<T>>& A, const std::vector<T>& b, std::vector<T>& x,
+                       Workspace& workspace);
+
+/**
+ * @brief Rozkład LU macierzy kwadratowej z częściowym wyborem elementu głównego (PA = LU).
+ *
+ * Czynniki L (z jedynkami na diagonali, niezapisywanymi) oraz U są przechowywane razem
+ * w jednej ciągłej tablicy wierszami. Raz obliczony rozkład można wielokrotnie wykorzystać
+ * w `lu_solve` dla różnych prawych stron, co jest tańsze niż ponowna eliminacja Gaussa.
+ */
+struct LUDecomposition {
+    int n = 0;                 ///< Rozmiar macierzy.
+    std::vector<double> lu;    ///< Czynniki L i U, element (i, j) pod indeksem i*n + j.
+    std::vector<int> pivots;   ///< pivots[i] - wiersz zamieniony z wierszem i w kroku i.
+};
+
+/**
+ * @brief Oblicza rozkład LU macierzy A z częściowym wyborem elementu głównego.
+ *
+ * @param A Kwadratowa macierz (NxN).
+ * @return LUDecomposition Rozkład gotowy do użycia w `lu_solve`.
+ * @throws std::invalid_argument Jeśli macierz A jest pusta lub nie jest kwadratowa.
+ * @throws std::runtime_error Jeśli macierz A jest osobliwa (nieodwracalna).
+ */
+LUDecomposition lu_decompose(const std::vector<std::vector<double>>& A);
+
+/**
+ * @brief Rozwiązuje układ Ax = b na podstawie wcześniej obliczonego rozkładu LU macierzy A.
+ *
+ * @param lu Rozkład LU zwrócony przez `lu_decompose`.
+ * @param b Wektor wyrazów wolnych (N).
+ * @return Wektor x będący rozwiązaniem układu równań.
+ * @throws std::invalid_argument Jeśli rozmiar `b` jest niezgodny z rozmiarem rozkładu.
+ *
+ * @example
+ * @code
+ * auto lu = NumLibCpp::lu_decompose({{4, 3}, {6, 3}});
+ * std::vector<double> x1 = NumLibCpp::lu_solve(lu, {10, 12}); // {1, 2}
+ * std::vector<double> x2 = NumLibCpp::lu_solve(lu, {7, 9});   // Ten sam rozkład, inna prawa strona
+ * @endcode
+ */
+std::vector<double> lu_solve(const LUDecomposition& lu, std::vector<double> b);
+
+/**
+ * @brief Rozkład macierzy trójdiagonalnej dla algorytmu Thomasa (bez wyboru elementu głównego).
+ *
+ * Przechowuje zmodyfikowane współczynniki nad diagonalą i odwrotności mianowników, dzięki czemu
+ * każde kolejne rozwiązanie kosztuje O(n) bez dzieleń przez elementy diagonali.
+ */
+struct TridiagonalDecomposition {
+    std::vector<double> lower;      ///< Elementy pod diagonalą, lower[0] nieużywany.
+    std::vector<double> c_prime;    ///< Zmodyfikowane elementy nad diagonalą.
+    std::vector<double> inv_denom;  ///< Odwrotności mianowników eliminacji.
+};
+
+/**
+ * @brief Oblicza rozkład macierzy trójdiagonalnej (algorytm Thomasa).
+ *
+ * Algorytm nie wybiera elementu głównego, więc jest przeznaczony dla macierzy diagonalnie
+ * dominujących (np. z dyskretyzacji równania dyfuzji).
+ *
+ * @param lower Elementy pod diagonalą (rozmiar n, lower[0] jest ignorowany).
+ * @param diag Elementy diagonali (rozmiar n).
+ * @param upper Elementy nad diagonalą (rozmiar n, upper[n-1] jest ignorowany).
+ * @return TridiagonalDecomposition Rozkład gotowy do użycia w `tridiagonal_solve`.
+ * @throws std::invalid_argument Jeśli wektory są puste lub mają różne rozmiary.
+ * @throws std::runtime_error Jeśli w trakcie eliminacji pojawi się zerowy mianownik.
+ */
+TridiagonalDecomposition tridiagonal_decompose(const std::vector<double>& lower,
+                                               const std::vector<double>& diag,
+                                               const std::vector<double>& upper);
+
+/**
+ * @brief Rozwiązuje układ trójdiagonalny na podstawie rozkładu z `tridiagonal_decompose`.
+ *
+ * @param decomposition Rozkład macierzy.
+ * @param d Wektor wyrazów wolnych (rozmiar n).
+ * @return Wektor rozwiązania.
+ * @throws std::invalid_argument Jeśli rozmiar `d` jest niezgodny z rozkładem.
+ *
+ * @example
+ * @code
+ * // -u'' = 1 na 3 węzłach wewnętrznych
+ * auto tri = NumLibCpp::tridiagonal_decompose({0, -1, -1}, {2, 2, 2}, {-1, -1, 0});
+ * std::vector<double> u = NumLibCpp::tridiagonal_solve(tri, {1, 1, 1}); // {1.5, 2, 1.5}
+ * @endcode
+ */
+std::vector<double> tridiagonal_solve(const TridiagonalDecomposition& decomposition, std::vector<double> d);
+
 } // namespace NumLibCpp
 
 #endif // NUMLIBCPP_LINEAR_SOLVER_HPP
@@ -1,9 +1,17 @@
 #ifndef NUMLIBCPP_NONLINEAR_SOLVER_H
 #define NUMLIBCPP_NONLINEAR_SOLVER_H
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <vector>
 #include <stdexcept> // Dla std::runtime_error, std::invalid_argument
 #include <limits>    // Dla std::numeric_limits
+#include <algorithm> // Dla std::min
+#include <cmath>     // Dla std::abs
+#include <type_traits>
+#include "NumLibCpp/instrumentation.hpp"
+#include "NumLibCpp/scalar_traits.hpp"
 
 namespace NumLibCpp {
 
@@ -49,6 +57,417 @@ namespace NumLibCpp {
  */
 double secant_method(std::function<double(double)> func, double x0, double x1, double tol, int max_iter);
 
+/**
+ * @brief Wariant `secant_method` zwracający liczbę wywołań funkcji.
+ *
+ * Każda iteracja wywołuje `func` dokładnie raz; wartość w nowym punkcie jest zapamiętywana
+ * i używana zarówno w teście zbieżności, jak i w kolejnej iteracji.
+ *
+ * @param num_evaluations [out] Liczba wywołań `func` (ustawiana także przy zgłoszeniu wyjątku).
+ */
+double secant_method(std::function<double(double)> func, double x0, double x1, double tol, int max_iter,
+                     int& num_evaluations);
+
+/**
+ * @brief Znajduje pierwiastek równania f(x) = 0 w przedziale [a, b] metodą Brenta.
+ *
+ * Metoda łączy bisekcję, sieczne i odwrotną interpolację kwadratową. Przedział zawierający
+ * zmianę znaku jest zawężany w każdej iteracji, a krok bisekcji jest wymuszany, gdy interpolacja
+ * nie zmniejsza go dostatecznie szybko, więc zbieżność jest gwarantowana (co najwyżej ok.
+ * log2((b - a) / tol)^2 iteracji), a dla gładkich funkcji jest nadliniowa. Każda iteracja
+ * wywołuje `func` dokładnie raz.
+ *
+ * @param func Funkcja f(x), ciągła na [a, b].
+ * @param a Lewy koniec przedziału.
+ * @param b Prawy koniec przedziału; f(a) i f(b) muszą mieć przeciwne znaki (lub jedno z nich być zerem).
+ * @param tol Tolerancja: zwracany x leży w odległości co najwyżej ok. tol od pierwiastka.
+ * @param max_iter Maksymalna liczba iteracji.
+ * @return double Przybliżona wartość pierwiastka.
+ * @throws std::invalid_argument Jeśli `tol <= 0`, `max_iter <= 0` lub f(a) i f(b) mają ten sam znak.
+ * @throws std::runtime_error Jeśli metoda nie zbiegnie w `max_iter` iteracjach.
+ *
+ * @example
+ * @code
+ * double root = NumLibCpp::brent_method([](double x) { return std::cos(x) - x; }, 0.0, 1.0, 1e-12, 100);
+ * // root ~ 0.739085133215
+ * @endcode
+ */
+double brent_method(std::function<double(double)> func, double a, double b, double tol, int max_iter);
+
+/**
+ * @brief Wariant `brent_method` zwracający liczbę wywołań funkcji.
+ *
+ * @param num_evaluations [out] Liczba wywołań `func` (ustawiana także przy zgłoszeniu wyjątku).
+ */
+double brent_method(std::function<double(double)> func, double a, double b, double tol, int max_iter,
+                    int& num_evaluations);
+
+namespace detail {
+
+template <typename F, typename T>
+T secant_method_impl(F& func, T x0, T x1, T tol, int max_iter, int& num_evaluations) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("secant_method");
+    num_evaluations = 0;
+    if (tol <= 0) {
+        throw std::invalid_argument("Tolerancja musi byc dodatnia.");
+    }
+    if (max_iter <= 0) {
+        throw std::invalid_argument("Maksymalna liczba iteracji musi byc dodatnia.");
+    }
+    if (std::abs(x0 - x1) < std::numeric_limits<T>::epsilon()) {
+         throw std::invalid_argument("Poczatkowe przyblizenia x0 i x1 musza byc rozne.");
+    }
+
+
+    T fx0 = func(x0);
+    T fx1 = func(x1);
+    num_evaluations = 2;
+    NUMLIBCPP_COUNT(function_evaluations, 2);
+
+    for (int i = 0; i < max_iter; ++i) {
+        if (std::abs(fx1 - fx0) < std::numeric_limits<T>::epsilon() * 100) { // Mnożnik dla bezpieczeństwa
+            // To może oznaczać, że f(x1) i f(x0) są bardzo blisko,
+            // co może prowadzić do dzielenia przez bardzo małą liczbę, lub
+            // że znaleźliśmy płaski region funkcji.
+            // Jeśli fx1 jest bliskie 0, to x1 jest prawdopodobnie pierwiastkiem.
+            if (std::abs(fx1) < tol) return x1;
+            throw std::runtime_error("Dzielenie przez wartosc bliska zeru (fx1 - fx0). Funkcja moze byc plaska w poblizu przyblizen.");
+        }
+
+        T x_next = x1 - fx1 * (x1 - x0) / (fx1 - fx0);
+        T fx_next = func(x_next); // Jedno wywołanie na iterację - wartość trafia do kolejnej iteracji
+        ++num_evaluations;
+        NUMLIBCPP_COUNT(function_evaluations, 1);
+        NUMLIBCPP_COUNT(iterations, 1);
+
+        if (std::abs(x_next - x1) < tol || std::abs(fx_next) < tol) {
+            return x_next;
+        }
+
+        x0 = x1;
+        fx0 = fx1;
+        x1 = x_next;
+        fx1 = fx_next;
+    }
+
+    throw std::runtime_error("Metoda siecznych nie zbiegla w maksymalnej liczbie iteracji.");
+}
+
+template <typename F, typename T>
+T brent_method_impl(F& func, T a, T b, T tol, int max_iter, int& num_evaluations) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("brent_method");
+    num_evaluations = 0;
+    if (tol <= 0) {
+        throw std::invalid_argument("Tolerancja musi byc dodatnia.");
+    }
+    if (max_iter <= 0) {
+        throw std::invalid_argument("Maksymalna liczba iteracji musi byc dodatnia.");
+    }
+
+    T fa = func(a);
+    T fb = func(b);
+    num_evaluations = 2;
+    NUMLIBCPP_COUNT(function_evaluations, 2);
+    if (fa == 0) return a;
+    if (fb == 0) return b;
+    if ((fa > 0) == (fb > 0)) {
+        throw std::invalid_argument("Wartosci f(a) i f(b) musza miec przeciwne znaki.");
+    }
+
+    // b - najlepsze przybliżenie, c - punkt z przeciwnym znakiem, a - poprzednie b
+    T c = a, fc = fa;
+    T d = b - a, e = d;
+    const T eps = std::numeric_limits<T>::epsilon();
+
+    for (int i = 0; i < max_iter; ++i) {
+        if ((fb > 0) == (fc > 0)) {
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+        if (std::abs(fc) < std::abs(fb)) {
+            a = b; b = c; c = a;
+            fa = fb; fb = fc; fc = fa;
+        }
+
+        const T tol1 = 2 * eps * std::abs(b) + T(0.5) * tol;
+        const T m = T(0.5) * (c - b);
+        if (std::abs(m) <= tol1 || fb == 0) {
+            return b;
+        }
+
+        if (std::abs(e) >= tol1 && std::abs(fa) > std::abs(fb)) {
+            // Interpolacja: sieczna (a == c) lub odwrotna interpolacja kwadratowa
+            T p, q;
+            const T s = fb / fa;
+            if (a == c) {
+                p = 2 * m * s;
+                q = 1 - s;
+            } else {
+                const T r = fb / fc;
+                const T t = fa / fc;
+                p = s * (2 * m * t * (t - r) - (b - a) * (r - 1));
+                q = (t - 1) * (r - 1) * (s - 1);
+            }
+            if (p > 0) {
+                q = -q;
+            } else {
+                p = -p;
+            }
+            // Krok interpolacji przyjmowany tylko, gdy mieści się w przedziale i maleje dostatecznie szybko
+            if (2 * p < std::min(3 * m * q - std::abs(tol1 * q), std::abs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = m;
+                e = d;
+            }
+        } else {
+            d = m; // Bisekcja
+            e = d;
+        }
+
+        a = b;
+        fa = fb;
+        b += std::abs(d) > tol1 ? d : (m > 0 ? tol1 : -tol1);
+        fb = func(b);
+        ++num_evaluations;
+        NUMLIBCPP_COUNT(function_evaluations, 1);
+        NUMLIBCPP_COUNT(iterations, 1);
+    }
+
+    throw std::runtime_error("Metoda Brenta nie zbiegla w maksymalnej liczbie iteracji.");
+}
+
+template <typename F>
+using enable_if_scalar_function = std::enable_if_t<std::is_invocable_r_v<double, F&, double>, int>;
+
+template <typename F, typename T>
+using enable_if_alternate_scalar_function =
+    std::enable_if_t<is_alternate_scalar_v<T> && std::is_invocable_r_v<T, F&, T>, int>;
+
+} // namespace detail
+
+/**
+ * @brief Warianty `secant_method` i `brent_method` dla dowolnego obiektu wywoływalnego.
+ *
+ * Funkcja jest wywoływana bezpośrednio (bez `std::function`), więc tanie funkcje mogą zostać
+ * wstawione w pętlę iteracji. Obiekty `std::function` trafiają do wersji nieszablonowych.
+ */
+template <typename F, detail::enable_if_scalar_function<F> = 0>
+double secant_method(F&& func, double x0, double x1, double tol, int max_iter, int& num_evaluations) {
+    return detail::secant_method_impl(func, x0, x1, tol, max_iter, num_evaluations);
+}
+
+template <typename F, detail::enable_if_scalar_function<F> = 0>
+double secant_method(F&& func, double x0, double x1, double tol, int max_iter) {
+    int num_evaluations = 0;
+    return detail::secant_method_impl(func, x0, x1, tol, max_iter, num_evaluations);
+}
+
+template <typename F, detail::enable_if_scalar_function<F> = 0>
+double brent_method(F&& func, double a, double b, double tol, int max_iter, int& num_evaluations) {
+    return detail::brent_method_impl(func, a, b, tol, max_iter, num_evaluations);
+}
+
+template <typename F, detail::enable_if_scalar_function<F> = 0>
+double brent_method(F&& func, double a, double b, double tol, int max_iter) {
+    int num_evaluations = 0;
+    return detail::brent_method_impl(func, a, b, tol, max_iter, num_evaluations);
+}
+
+/**
+ * @brief Warianty `secant_method` i `brent_method` dla typów `float` i `long double` (typ wyznaczany z argumentów).
+ *
+ * Domyślna tolerancja `default_tolerance<T>()` (około 6e-6 dla `float`, 6e-15 dla `long double`) jest osiągalna
+ * w precyzji typu; kryteria osobliwości i krok minimalny metody Brenta używają `std::numeric_limits<T>::epsilon()`.
+ * Przy argumentach różnych typów (np. `float` i `double`) wywoływana jest wersja dla `double`.
+ *
+ * @example
+ * @code
+ * float root = NumLibCpp::brent_method([](float x) { return x * x - 2.0f; }, 0.0f, 2.0f); // ~1.4142135f
+ * @endcode
+ */
+template <typename F, typename T, detail::enable_if_alternate_scalar_function<F, T> = 0>
+T secant_method(F&& func, T x0, T x1, T tol, int max_iter, int& num_evaluations) {
+    return detail::secant_method_impl(func, x0, x1, tol, max_iter, num_evaluations);
+}
+
+template <typename F, typename T, detail::enable_if_alternate_scalar_function<F, T> = 0>
+T secant_method(F&& func, T x0, T x1, T tol = default_tolerance<T>(), int max_iter = 100) {
+    int num_evaluations = 0;
+    return detail::secant_method_impl(func, x0, x1, tol, max_iter, num_evaluations);
+}
+
+template <typename F, typename T, detail::enable_if_alternate_scalar_function<F, T> = 0>
+T brent_method(F&& func, T a, T b, T tol, int max_iter, int& num_evaluations) {
+    return detail::brent_method_impl(func, a, b, tol, max_iter, num_evaluations);
+}
+
+template <typename F, typename T, detail::enable_if_alternate_scalar_function<F, T> = 0>
+T brent_method(F&& func, T a, T b, T tol = default_tolerance<T>(), int max_iter = 100) {
+    int num_evaluations = 0;
+    return detail::brent_method_impl(func, a, b, tol, max_iter, num_evaluations);
+}
+
+/**
+ * @brief Funkcja f liczona jednocześnie dla bloku równań w `chandrupatla_batch`.
+ *
+ * Wywołanie `f(x, index, fx, count)` ma zapisać w `fx[k]` wartość f_{index[k]}(x[k]), k = 0..count-1,
+ * gdzie `index[k]` jest indeksem równania w całym zestawie (np. komórki siatki, której parametry
+ * należy odczytać). Indeksy nie muszą być ciągłe - rozwiązane równania są usuwane z bloku.
+ * Funkcja może być wywoływana współbieżnie z wielu wątków dla rozłącznych zbiorów indeksów.
+ */
+using BatchRootFunction = std::function<void(const double* x, const std::size_t* index, double* fx, std::size_t count)>;
+
+/**
+ * @brief Stan zakończenia pojedynczego równania w `chandrupatla_batch`.
+ */
+enum class RootStatus : std::uint8_t {
+    Converged = 0,   ///< Pierwiastek znaleziony z zadaną tolerancją.
+    NoBracket,       ///< f(lower) i f(upper) mają ten sam znak - przedział nie zawiera zmiany znaku.
+    MaxIterations,   ///< Przekroczono limit iteracji; zwracane jest najlepsze przybliżenie.
+    NotFinite        ///< Funkcja zwróciła NaN lub nieskończoność.
+};
+
+/**
+ * @brief Parametry `chandrupatla_batch`.
+ */
+struct BatchRootOptions {
+    double tol = 1e-12;            ///< Tolerancja bezwzględna położenia pierwiastka (względna 2*eps jest dodawana automatycznie).
+    int max_iter = 100;            ///< Maksymalna liczba iteracji dla każdego równania.
+    std::size_t block_size = 1024; ///< Liczba równań w bloku przekazywanym do jednego wątku.
+};
+
+/**
+ * @brief Wynik `chandrupatla_batch` - pierwiastki i stan każdego równania.
+ */
+struct BatchRootResult {
+    std::vector<double> roots;          ///< Pierwiastki (NaN dla `NoBracket`).
+    std::vector<RootStatus> status;     ///< Stan zakończenia każdego równania.
+    std::vector<int> iterations;        ///< Liczba iteracji (wywołań f po ocenie końców przedziału) każdego równania.
+};
+
+/**
+ * @brief Rozwiązuje wiele niezależnych równań f_i(x) = 0, x w [lower_i, upper_i], metodą Chandrupatli.
+ *
+ * Metoda Chandrupatli (1997) łączy bisekcję z odwrotną interpolacją kwadratową, podobnie jak metoda
+ * Brenta, ale wybór kroku jest jedną formułą bez rozgałęzień zależnych od historii, co pozwala
+ * prowadzić wszystkie równania bloku w tych samych pętlach (pasmach SIMD). Każda iteracja wywołuje
+ * `f` raz dla całego bloku aktywnych równań; maska zbieżności jest liczona dla wszystkich pasm,
+ * a rozwiązane równania są następnie usuwane z bloku (kompakcja), więc kolejne wywołania `f`
+ * obejmują tylko pozostałe. Bloki `block_size` równań są rozdzielane między wątki `ThreadPool::global()`.
+ *
+ * Niepowodzenia pojedynczych równań nie przerywają obliczeń - są zgłaszane w `BatchRootResult::status`.
+ *
+ * @param f Funkcja liczona dla bloku równań (patrz `BatchRootFunction`).
+ * @param lower Lewe końce przedziałów.
+ * @param upper Prawe końce przedziałów (rozmiar równy `lower`).
+ * @param options Tolerancja, limit iteracji i rozmiar bloku.
+ * @return BatchRootResult Pierwiastki i stany wszystkich równań.
+ * @throws std::invalid_argument Jeśli rozmiary `lower` i `upper` są różne, `tol <= 0`, `max_iter <= 0` lub `block_size == 0`.
+ *
+ * @example
+ * @code
+ * // Odwracanie równania Keplera E - e*sin(E) = M dla miliona par (e_i, M_i)
+ * auto f = [&](const double* E, const size_t* idx, double* fx, size_t count) {
+ *     for (size_t k = 0; k < count; ++k) fx[k] = E[k] - e[idx[k]] * std::sin(E[k]) - M[idx[k]];
+ * };
+ * std::vector<double> lo(M.size(), 0.0), hi(M.size(), 2.0 * M_PI);
+ * NumLibCpp::BatchRootResult res = NumLibCpp::chandrupatla_batch(f, lo, hi);
+ * @endcode
+ */
+BatchRootResult chandrupatla_batch(const BatchRootFunction& f, const std::vector<double>& lower,
+                                   const std::vector<double>& upper,
+                                   const BatchRootOptions& options = BatchRootOptions());
+
+/**
+ * @brief Układ równań nieliniowych F(x) = 0, F: R^n -> R^n.
+ */
+using NonlinearSystem = std::function<std::vector<double>(const std::vector<double>&)>;
+
+/**
+ * @brief Macierz Jacobiego układu, J[i][j] = dF_i/dx_j (n x n).
+ */
+using NonlinearJacobian = std::function<std::vector<std::vector<double>>(const std::vector<double>&)>;
+
+/**
+ * @brief Parametry solverów `newton_system` i `broyden_system`.
+ */
+struct NonlinearSystemOptions {
+    double tol = 1e-10;                       ///< Zbieżność: max|F_i| < tol lub pełny krok max|dx_i| < tol * (1 + max|x_i|).
+    int max_iter = 100;                       ///< Maksymalna liczba iteracji.
+    NonlinearJacobian jacobian;               ///< Jakobian użytkownika; pusty oznacza różnice skończone.
+    std::vector<std::vector<int>> sparsity;   ///< Wzorzec jakobianu numerycznego (sparsity[i] - kolumny niezerowe w wierszu i); pusty oznacza macierz pełną.
+    double jacobian_reuse_ratio = 0.5;        ///< Newton: rozkład LU jest używany ponownie, dopóki pełny krok zmniejsza max|F_i| co najmniej tyle razy; 0 - nowy jakobian w każdej iteracji.
+    int max_broyden_updates = 30;             ///< Broyden: liczba poprawek rzędu 1, po której jakobian jest liczony od nowa.
+};
+
+/**
+ * @brief Wynik solvera układu nieliniowego wraz ze statystykami wykonanej pracy.
+ */
+struct NonlinearSystemResult {
+    std::vector<double> x;            ///< Przybliżone rozwiązanie.
+    double residual_norm = 0.0;       ///< max|F_i(x)| w zwróconym punkcie.
+    int iterations = 0;               ///< Liczba wykonanych iteracji.
+    int function_evaluations = 0;     ///< Liczba wywołań F (łącznie z wywołaniami wewnątrz jakobianu numerycznego).
+    int jacobian_evaluations = 0;     ///< Liczba obliczeń macierzy Jacobiego.
+    int lu_decompositions = 0;        ///< Liczba rozkładów LU jakobianu.
+};
+
+/**
+ * @brief Rozwiązuje układ równań nieliniowych F(x) = 0 metodą Newtona z przeszukiwaniem liniowym.
+ *
+ * Kierunek Newtona p = -J^{-1} F jest skracany (backtracking z interpolacją kwadratową), aż
+ * norma residuum spadnie zgodnie z warunkiem Armijo. Rozkład LU jakobianu jest używany w kolejnych
+ * iteracjach (metoda cięciw), dopóki pełny krok zmniejsza residuum co najmniej
+ * `1 / jacobian_reuse_ratio` razy; w przeciwnym razie jakobian jest liczony ponownie. Gdy
+ * przeszukiwanie liniowe zawiedzie z nieaktualnym jakobianem, iteracja jest powtarzana ze świeżym.
+ *
+ * Jakobian numeryczny korzysta z różnic centralnych (`numerical_jacobian`); jeśli podano wzorzec
+ * `sparsity`, kolumny są grupowane, co dla macierzy pasmowej redukuje koszt z 2n do 2w wywołań F.
+ *
+ * @param f Funkcja F(x), zwracająca wektor tego samego rozmiaru co x.
+ * @param x0 Przybliżenie początkowe (niepuste).
+ * @param options Tolerancja, limit iteracji i źródło jakobianu.
+ * @return NonlinearSystemResult Rozwiązanie i statystyki.
+ * @throws std::invalid_argument Jeśli `x0` jest pusty, parametry są niepoprawne lub rozmiary F/J są niezgodne z x.
+ * @throws std::runtime_error Jeśli metoda nie zbiegnie w `max_iter` iteracjach, przeszukiwanie liniowe
+ *         nie znajdzie kroku zmniejszającego residuum lub jakobian jest osobliwy.
+ *
+ * @example
+ * @code
+ * // x^2 + y^2 = 4, e^x + y = 1
+ * auto F = [](const std::vector<double>& v) {
+ *     return std::vector<double>{v[0] * v[0] + v[1] * v[1] - 4.0, std::exp(v[0]) + v[1] - 1.0};
+ * };
+ * NumLibCpp::NonlinearSystemResult res = NumLibCpp::newton_system(F, {1.0, -1.0});
+ * std::cout << res.x[0] << " " << res.x[1] << " (wywolania F: " << res.function_evaluations << ")" << std::endl;
+ * @endcode
+ */
+NonlinearSystemResult newton_system(const NonlinearSystem& f, const std::vector<double>& x0,
+                                    const NonlinearSystemOptions& options = NonlinearSystemOptions());
+
+/**
+ * @brief Rozwiązuje układ równań nieliniowych F(x) = 0 quasi-Newtonowską metodą Broydena.
+ *
+ * Odwrotność jakobianu jest przybliżana jako H_k = (I + a_{k-1} s_{k-1}^T) ... (I + a_0 s_0^T) J_0^{-1}
+ * ("dobra" poprawka Broydena w postaci iloczynowej). Przechowywane są tylko rozkład LU macierzy J_0
+ * i pary wektorów (a_i, s_i), więc iteracja kosztuje jedno wywołanie F (przy pełnym kroku)
+ * i O(n^2 + k n) operacji zamiast nowego jakobianu i rozkładu O(n^3). Jakobian jest liczony ponownie
+ * po `max_broyden_updates` poprawkach, przy degeneracji poprawki lub niepowodzeniu przeszukiwania liniowego.
+ *
+ * @param f Funkcja F(x), zwracająca wektor tego samego rozmiaru co x.
+ * @param x0 Przybliżenie początkowe (niepuste).
+ * @param options Tolerancja, limit iteracji i źródło jakobianu początkowego.
+ * @return NonlinearSystemResult Rozwiązanie i statystyki.
+ * @throws std::invalid_argument Jeśli `x0` jest pusty, parametry są niepoprawne lub rozmiary F/J są niezgodne z x.
+ * @throws std::runtime_error Jeśli metoda nie zbiegnie w `max_iter` iteracjach, przeszukiwanie liniowe
+ *         nie znajdzie kroku zmniejszającego residuum lub jakobian jest osobliwy.
+ */
+NonlinearSystemResult broyden_system(const NonlinearSystem& f, const std::vector<double>& x0,
+                                     const NonlinearSystemOptions& options = NonlinearSystemOptions());
+
 } // namespace NumLibCpp
 
 #endif //NUMLIBCPP_NONLINEAR_SOLVER_H
\ No newline at end of file
@@ -0,0 +1,122 @@
+#ifndef NUMLIBCPP_PDE_SOLVER_HPP
+#define NUMLIBCPP_PDE_SOLVER_HPP
+
+#include <cstddef>
+#include <vector>
+#include <stdexcept> // Dla std::invalid_argument
+
+namespace NumLibCpp {
+
+/**
+ * @brief Rodzaj warunku brzegowego równania dyfuzji.
+ */
+enum class BoundaryType {
+    Dirichlet, ///< u = value
+    Neumann,   ///< du/dn = value (n - normalna zewnętrzna)
+    Robin      ///< du/dn + coefficient * u = value
+};
+
+/**
+ * @brief Warunek brzegowy na jednym brzegu obszaru.
+ *
+ * Warunek Robina opisuje np. konwekcję do otoczenia: -k du/dn = h (u - T_env), czyli
+ * `coefficient = h/k` i `value = h/k * T_env`. Warunek Neumanna z `value = 0` oznacza izolację.
+ */
+struct BoundaryCondition {
+    BoundaryType type = BoundaryType::Dirichlet;
+    double value = 0.0;        ///< Wartość u, strumień du/dn lub prawa strona warunku Robina.
+    double coefficient = 0.0;  ///< Współczynnik przy u w warunku Robina.
+};
+
+/**
+ * @brief Schemat całkowania w czasie układu otrzymanego metodą linii.
+ */
+enum class TimeScheme {
+    ExplicitRK4,    ///< Jawna metoda RK4 (wymaga kroku spełniającego warunek stabilności).
+    CrankNicolson   ///< Niejawny schemat Cranka-Nicolson (w 2-D w postaci ADI Peacemana-Rachforda).
+};
+
+/**
+ * @brief Równanie przewodnictwa u_t = diffusivity * u_xx na odcinku [0, length].
+ */
+struct HeatProblem1D {
+    double length = 1.0;         ///< Długość pręta.
+    std::size_t nodes = 0;       ///< Liczba węzłów siatki (z brzegami, co najmniej 3).
+    double diffusivity = 1.0;    ///< Współczynnik dyfuzji (dodatni).
+    BoundaryCondition left;      ///< Warunek w x = 0.
+    BoundaryCondition right;     ///< Warunek w x = length.
+};
+
+/**
+ * @brief Równanie przewodnictwa u_t = diffusivity * (u_xx + u_yy) na prostokącie [0, length_x] x [0, length_y].
+ *
+ * Wartości siatki są przechowywane wierszami: u(x_i, y_j) ma indeks j * nodes_x + i.
+ * W narożnikach warunek Dirichleta ma pierwszeństwo przed pozostałymi.
+ */
+struct HeatProblem2D {
+    double length_x = 1.0;
+    double length_y = 1.0;
+    std::size_t nodes_x = 0;     ///< Liczba węzłów w kierunku x (co najmniej 3).
+    std::size_t nodes_y = 0;     ///< Liczba węzłów w kierunku y (co najmniej 3).
+    double diffusivity = 1.0;
+    BoundaryCondition left;      ///< x = 0
+    BoundaryCondition right;     ///< x = length_x
+    BoundaryCondition bottom;    ///< y = 0
+    BoundaryCondition top;       ///< y = length_y
+};
+
+/**
+ * @brief Rozwiązuje jednowymiarowe równanie przewodnictwa metodą linii.
+ *
+ * Pochodna przestrzenna jest dyskretyzowana różnicą centralną drugiego rzędu; warunki Neumanna
+ * i Robina są realizowane przez węzeł fikcyjny (ghost node). Schemat Cranka-Nicolson rozwiązuje
+ * w każdym kroku układ trójdiagonalny algorytmem Thomasa z rozkładem obliczonym raz na całe
+ * całkowanie; schemat jawny korzysta z `explicit_rk_solve_system<rk::Classic4>`.
+ *
+ * @param problem Opis zagadnienia.
+ * @param u0 Warunek początkowy w węzłach siatki (rozmiar `problem.nodes`). Węzły z warunkiem Dirichleta
+ *        są nadpisywane wartością brzegową.
+ * @param t_end Czas końcowy (t0 = 0).
+ * @param num_steps Liczba kroków czasowych (musi być dodatnia).
+ * @param scheme Schemat całkowania w czasie.
+ * @return std::vector<double> Rozwiązanie u(x_i, t_end).
+ * @throws std::invalid_argument Przy niepoprawnych parametrach lub gdy krok jawnego RK4 narusza warunek stabilności.
+ *
+ * @example
+ * @code
+ * // Pręt o długości 1 z końcami w temperaturze 0 i początkowym rozkładem sin(pi x)
+ * NumLibCpp::HeatProblem1D rod;
+ * rod.nodes = 101;
+ * rod.diffusivity = 0.1;
+ * std::vector<double> u0(rod.nodes);
+ * for (size_t i = 0; i < rod.nodes; ++i) u0[i] = std::sin(M_PI * i / 100.0);
+ * std::vector<double> u = NumLibCpp::solve_heat_1d(rod, u0, 1.0, 100);
+ * @endcode
+ */
+std::vector<double> solve_heat_1d(const HeatProblem1D& problem, const std::vector<double>& u0,
+                                  double t_end, int num_steps,
+                                  TimeScheme scheme = TimeScheme::CrankNicolson);
+
+/**
+ * @brief Rozwiązuje dwuwymiarowe równanie przewodnictwa metodą linii.
+ *
+ * Pięciopunktowy operator Laplace'a jest liczony w blokach wierszy i kolumn rozdzielanych między
+ * wątki `ThreadPool::global()`. Schemat niejawny to metoda kierunków naprzemiennych (ADI)
+ * Peacemana-Rachforda: każdy półkrok rozwiązuje niezależne układy trójdiagonalne wzdłuż wierszy,
+ * a następnie kolumn (kolumny są przetwarzane paczkami, aby dostęp do pamięci był ciągły).
+ *
+ * @param problem Opis zagadnienia.
+ * @param u0 Warunek początkowy (rozmiar `nodes_x * nodes_y`, układ wierszami).
+ * @param t_end Czas końcowy (t0 = 0).
+ * @param num_steps Liczba kroków czasowych (musi być dodatnia).
+ * @param scheme Schemat całkowania w czasie.
+ * @return std::vector<double> Rozwiązanie w chwili t_end (układ wierszami).
+ * @throws std::invalid_argument Przy niepoprawnych parametrach lub gdy krok jawnego RK4 narusza warunek stabilności.
+ */
+std::vector<double> solve_heat_2d(const HeatProblem2D& problem, const std::vector<double>& u0,
+                                  double t_end, int num_steps,
+                                  TimeScheme scheme = TimeScheme::CrankNicolson);
+
+} // namespace NumLibCpp
+
+#endif // NUMLIBCPP_PDE_SOLVER_HPP
@@ -0,0 +1,269 @@
+#ifndef NUMLIBCPP_RUNGE_KUTTA_HPP
+#define NUMLIBCPP_RUNGE_KUTTA_HPP
+
+#include <array>
+#include <cmath>     // Dla std::abs
+#include <utility>   // Dla std::integer_sequence
+#include <vector>
+#include <stdexcept> // Dla std::invalid_argument
+
+namespace NumLibCpp {
+
+/**
+ * @brief Tablice Butchera jawnych metod Rungego-Kutty do użycia z `explicit_rk_solve`.
+ *
+ * Każda tablica to typ ze stałymi `stages`, `order` oraz tablicami constexpr `a`, `b`, `c`.
+ * Własne metody można dodać, definiując typ o tej samej budowie.
+ */
+namespace rk {
+
+/// Metoda punktu środkowego (rząd 2).
+struct Midpoint {
+    static constexpr int stages = 2;
+    static constexpr int order = 2;
+    static constexpr double a[2][2] = {{0.0, 0.0}, {0.5, 0.0}};
+    static constexpr double b[2] = {0.0, 1.0};
+    static constexpr double c[2] = {0.0, 0.5};
+};
+
+/// Metoda Heuna / trapezów (rząd 2).
+struct Heun {
+    static constexpr int stages = 2;
+    static constexpr int order = 2;
+    static constexpr double a[2][2] = {{0.0, 0.0}, {1.0, 0.0}};
+    static constexpr double b[2] = {0.5, 0.5};
+    static constexpr double c[2] = {0.0, 1.0};
+};
+
+/// Klasyczna metoda Kutty rzędu 3.
+struct Kutta3 {
+    static constexpr int stages = 3;
+    static constexpr int order = 3;
+    static constexpr double a[3][3] = {{0.0, 0.0, 0.0}, {0.5, 0.0, 0.0}, {-1.0, 2.0, 0.0}};
+    static constexpr double b[3] = {1.0 / 6.0, 2.0 / 3.0, 1.0 / 6.0};
+    static constexpr double c[3] = {0.0, 0.5, 1.0};
+};
+
+/// Metoda SSP-RK3 Shu-Oshera (rząd 3, zachowuje monotoniczność przy ograniczeniu kroku).
+struct SSPRK3 {
+    static constexpr int stages = 3;
+    static constexpr int order = 3;
+    static constexpr double a[3][3] = {{0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.25, 0.25, 0.0}};
+    static constexpr double b[3] = {1.0 / 6.0, 1.0 / 6.0, 2.0 / 3.0};
+    static constexpr double c[3] = {0.0, 1.0, 0.5};
+};
+
+/// Klasyczna metoda RK4 (ta sama co w `rk4_solve`).
+struct Classic4 {
+    static constexpr int stages = 4;
+    static constexpr int order = 4;
+    static constexpr double a[4][4] = {{0.0, 0.0, 0.0, 0.0},
+                                       {0.5, 0.0, 0.0, 0.0},
+                                       {0.0, 0.5, 0.0, 0.0},
+                                       {0.0, 0.0, 1.0, 0.0}};
+    static constexpr double b[4] = {1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0};
+    static constexpr double c[4] = {0.0, 0.5, 0.5, 1.0};
+};
+
+/// Metoda RK4 "reguły 3/8" (rząd 4).
+struct ThreeEighths4 {
+    static constexpr int stages = 4;
+    static constexpr int order = 4;
+    static constexpr double a[4][4] = {{0.0, 0.0, 0.0, 0.0},
+                                       {1.0 / 3.0, 0.0, 0.0, 0.0},
+                                       {-1.0 / 3.0, 1.0, 0.0, 0.0},
+                                       {1.0, -1.0, 1.0, 0.0}};
+    static constexpr double b[4] = {0.125, 0.375, 0.375, 0.125};
+    static constexpr double c[4] = {0.0, 1.0 / 3.0, 2.0 / 3.0, 1.0};
+};
+
+/// Metoda Dormanda-Prince'a rzędu 5 (rozwiązanie rzędu 5 pary DOPRI5(4)).
+/// Siódmy etap ma b = 0 i nie jest używany przez inne etapy, więc zostaje pominięty w czasie kompilacji.
+struct DormandPrince5 {
+    static constexpr int stages = 7;
+    static constexpr int order = 5;
+    static constexpr double a[7][7] = {
+        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0, 0.0},
+        {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0, 0.0, 0.0},
+        {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0.0, 0.0},
+        {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0}};
+    static constexpr double b[7] = {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0,
+                                    -2187.0 / 6784.0, 11.0 / 84.0, 0.0};
+    static constexpr double c[7] = {0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0};
+};
+
+} // namespace rk
+
+namespace detail {
+
+// Etap i jest potrzebny, jeśli ma niezerową wagę b lub korzysta z niego któryś z późniejszych etapów
+template <typename Tableau>
+constexpr bool rk_stage_used(int i) {
+    if (Tableau::b[i] != 0.0) {
+        return true;
+    }
+    for (int j = i + 1; j < Tableau::stages; ++j) {
+        if (Tableau::a[j][i] != 0.0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sprawdzenie poprawności tablicy: metoda jawna, sum(b) = 1, c_i = sum_j a_ij
+template <typename Tableau>
+constexpr bool rk_tableau_consistent() {
+    double b_sum = 0.0;
+    for (int i = 0; i < Tableau::stages; ++i) {
+        double a_sum = 0.0;
+        for (int j = 0; j < Tableau::stages; ++j) {
+            if (j >= i && Tableau::a[i][j] != 0.0) {
+                return false;
+            }
+            a_sum += Tableau::a[i][j];
+        }
+        double diff = a_sum - Tableau::c[i];
+        if (diff > 1e-12 || diff < -1e-12) {
+            return false;
+        }
+        b_sum += Tableau::b[i];
+    }
+    return b_sum - 1.0 < 1e-12 && 1.0 - b_sum < 1e-12;
+}
+
+// Ogólne operacje na stanie: skalar lub std::vector<double>
+inline void rk_axpy(double& out, double alpha, const double& v) { out += alpha * v; }
+inline void rk_axpy(std::vector<double>& out, double alpha, const std::vector<double>& v) {
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i] += alpha * v[i];
+    }
+}
+inline void rk_assign(double& out, const double& v) { out = v; }
+inline void rk_assign(std::vector<double>& out, const std::vector<double>& v) {
+    out.resize(v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        out[i] = v[i];
+    }
+}
+
+// Wywołanie prawej strony: y' = f(x, y) dla skalara, f(x, y, dydx) dla wektora (bez alokacji)
+template <typename F>
+inline void rk_eval(F& f, double x, const double& y, double& k) { k = f(x, y); }
+template <typename F>
+inline void rk_eval(F& f, double x, const std::vector<double>& y, std::vector<double>& k) {
+    k.resize(y.size());
+    f(x, y, k);
+}
+
+template <typename Tableau, int I, int J, typename State>
+inline void rk_add_a_term(State& tmp, double h, const State* k) {
+    if constexpr (Tableau::a[I][J] != 0.0) {
+        rk_axpy(tmp, h * Tableau::a[I][J], k[J]);
+    }
+}
+
+template <typename Tableau, int I, typename F, typename State, int... J>
+inline void rk_stage(F& f, double x, const State& y, double h, State* k, State& tmp,
+                     std::integer_sequence<int, J...>) {
+    if constexpr (rk_stage_used<Tableau>(I)) {
+        if constexpr (I == 0) {
+            rk_eval(f, x, y, k[0]);
+        } else {
+            rk_assign(tmp, y);
+            (rk_add_a_term<Tableau, I, J>(tmp, h, k), ...);
+            rk_eval(f, x + Tableau::c[I] * h, tmp, k[I]);
+        }
+    }
+}
+
+template <typename Tableau, int I, typename State>
+inline void rk_add_b_term(State& y, double h, const State* k) {
+    if constexpr (Tableau::b[I] != 0.0) {
+        rk_axpy(y, h * Tableau::b[I], k[I]);
+    }
+}
+
+template <typename Tableau, typename F, typename State, int... I>
+inline void rk_step(F& f, double x, State& y, double h, State* k, State& tmp,
+                    std::integer_sequence<int, I...>) {
+    (rk_stage<Tableau, I>(f, x, y, h, k, tmp, std::make_integer_sequence<int, I>()), ...);
+    (rk_add_b_term<Tableau, I>(y, h, k), ...);
+}
+
+template <typename Tableau, typename F, typename State>
+State explicit_rk_integrate(F& f, double x0, State y, double x_target, int num_steps) {
+    static_assert(rk_tableau_consistent<Tableau>(),
+                  "Tablica Butchera musi opisywac metode jawna z sum(b) = 1 i c_i = sum_j a_ij.");
+    if (num_steps <= 0) {
+        throw std::invalid_argument("Liczba krokow musi byc dodatnia.");
+    }
+    const double h = (x_target - x0) / num_steps;
+    std::array<State, Tableau::stages> k{};
+    State tmp{};
+    double x = x0;
+    for (int i = 0; i < num_steps; ++i) {
+        rk_step<Tableau>(f, x, y, h, k.data(), tmp, std::make_integer_sequence<int, Tableau::stages>());
+        x = x + h;
+    }
+    return y;
+}
+
+} // namespace detail
+
+/**
+ * @brief Rozwiązuje równanie y' = f(x, y) jawną metodą Rungego-Kutty opisaną tablicą Butchera `Tableau`.
+ *
+ * Etapy metody są rozwijane w czasie kompilacji: zerowe współczynniki a_ij i b_i nie generują
+ * żadnego kodu, etapy nieużywane (np. siódmy etap DOPRI5) są pomijane, a `f` jest dowolnym
+ * obiektem wywoływalnym (lambda, funktor, wskaźnik do funkcji), który kompilator może wstawić
+ * w miejsce wywołania. Dla `rk::Classic4` wynik odpowiada `rk4_solve`.
+ *
+ * @tparam Tableau Tablica Butchera, np. `rk::Heun`, `rk::SSPRK3`, `rk::Classic4`, `rk::DormandPrince5`.
+ * @param f Funkcja f(x, y) zwracająca `double`.
+ * @param x0 Początkowa wartość x.
+ * @param y0 Początkowa wartość y.
+ * @param x_target Wartość x, dla której szukane jest rozwiązanie y.
+ * @param num_steps Liczba kroków całkowania (musi być dodatnia).
+ * @return double Wartość y w punkcie x_target.
+ * @throws std::invalid_argument Jeśli `num_steps <= 0`.
+ *
+ * @example
+ * @code
+ * #include <NumLibCpp/runge_kutta.hpp>
+ *
+ * auto f = [](double x, double y) { return y * std::cos(x); };
+ * double y_ssp = NumLibCpp::explicit_rk_solve<NumLibCpp::rk::SSPRK3>(f, 0.0, 1.0, 2.0, 200);
+ * double y_dp5 = NumLibCpp::explicit_rk_solve<NumLibCpp::rk::DormandPrince5>(f, 0.0, 1.0, 2.0, 20);
+ * @endcode
+ */
+template <typename Tableau, typename F>
+double explicit_rk_solve(F&& f, double x0, double y0, double x_target, int num_steps) {
+    return detail::explicit_rk_integrate<Tableau>(f, x0, y0, x_target, num_steps);
+}
+
+/**
+ * @brief Wariant `explicit_rk_solve` dla układu równań y' = f(x, y), y ∈ R^n.
+ *
+ * Prawa strona ma postać `f(x, y, dydx)` i zapisuje pochodną do `dydx` (rozmiar n),
+ * dzięki czemu kroki nie alokują pamięci po pierwszym kroku.
+ *
+ * @tparam Tableau Tablica Butchera.
+ * @param f Funkcja `void(double x, const std::vector<double>& y, std::vector<double>& dydx)`.
+ * @param x0 Początkowa wartość x.
+ * @param y0 Warunek początkowy y(x0).
+ * @param x_target Wartość x, dla której szukane jest rozwiązanie.
+ * @param num_steps Liczba kroków całkowania (musi być dodatnia).
+ * @return std::vector<double> Wartość y w punkcie x_target.
+ * @throws std::invalid_argument Jeśli `num_steps <= 0`.
+ */
+template <typename Tableau, typename F>
+std::vector<double> explicit_rk_solve_system(F&& f, double x0, std::vector<double> y0, double x_target, int num_steps) {
+    return detail::explicit_rk_integrate<Tableau>(f, x0, std::move(y0), x_target, num_steps);
+}
+
+} // namespace NumLibCpp
+
+#endif // NUMLIBCPP_RUNGE_KUTTA_HPP
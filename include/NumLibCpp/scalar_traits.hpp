@@ -0,0 +1,53 @@
+#ifndef NUMLIBCPP_SCALAR_TRAITS_HPP
+#define NUMLIBCPP_SCALAR_TRAITS_HPP
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace NumLibCpp {
+
+/**
+ * @brief Domyślna tolerancja metod iteracyjnych dla typu `T`: eps^(3/4).
+ *
+ * Około 6e-6 dla `float`, 2e-12 dla `double` i 6e-15 dla `long double` (x87) - na tyle powyżej
+ * precyzji maszynowej, by kryterium stopu było osiągalne mimo błędów zaokrągleń funkcji.
+ */
+template <typename T>
+T default_tolerance() {
+    static_assert(std::is_floating_point_v<T>, "Typ skalarny musi byc zmiennoprzecinkowy");
+    return std::pow(std::numeric_limits<T>::epsilon(), static_cast<T>(0.75));
+}
+
+/**
+ * @brief Domyślny krok różnicy centralnej dla typu `T`: eps^(1/3).
+ *
+ * Minimalizuje sumę błędu obcięcia O(h^2) i błędu zaokrągleń O(eps/h): około 5e-3 dla `float`,
+ * 6e-6 dla `double` i 5e-7 dla `long double`.
+ */
+template <typename T>
+T default_difference_step() {
+    static_assert(std::is_floating_point_v<T>, "Typ skalarny musi byc zmiennoprzecinkowy");
+    return std::cbrt(std::numeric_limits<T>::epsilon());
+}
+
+namespace detail {
+
+// Parametr wyłączony z dedukcji (odpowiednik std::type_identity_t z C++20)
+template <typename T>
+struct type_identity {
+    using type = T;
+};
+template <typename T>
+using type_identity_t = typename type_identity<T>::type;
+
+// Typy obsługiwane przez szablony skalarne obok wersji dla double (float, long double);
+// wywołania dla double trafiają do istniejących przeciążeń
+template <typename T>
+constexpr bool is_alternate_scalar_v = std::is_floating_point_v<T> && !std::is_same_v<T, double>;
+
+} // namespace detail
+
+} // namespace NumLibCpp
+
+#endif // NUMLIBCPP_SCALAR_TRAITS_HPP
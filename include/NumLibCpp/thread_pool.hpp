@@ -0,0 +1,146 @@
+#ifndef NUMLIBCPP_THREAD_POOL_HPP
+#define NUMLIBCPP_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NumLibCpp {
+
+/**
+ * @brief Parametry tworzenia puli wątków.
+ */
+struct ThreadPoolOptions {
+    /// Liczba wątków roboczych; 0 oznacza `std::thread::hardware_concurrency() - 1`.
+    std::size_t num_threads = 0;
+    /**
+     * Przypina wątki robocze do węzłów NUMA (Linux, odczyt topologii z /sys/devices/system/node).
+     * Wątki są rozdzielane na węzły w ciągłych blokach, a przy kradzieży zadań najpierw przeszukiwane
+     * są kolejki wątków z tego samego węzła. Na innych systemach opcja jest ignorowana.
+     */
+    bool numa_affinity = false;
+};
+
+/**
+ * @brief Pula wątków z kradzieżą zadań (work-stealing) używana przez równoległe ścieżki biblioteki.
+ *
+ * Każdy wątek roboczy ma własną kolejkę zadań. Wątek bierze zadania z końca swojej kolejki,
+ * a gdy ta jest pusta, "kradnie" zadania z początku kolejek pozostałych wątków.
+ * Wątek wywołujący `parallel_for` również wykonuje zadania, dopóki cała praca nie zostanie zakończona.
+ *
+ * Wywołania `parallel_for` zagnieżdżone wewnątrz zadania puli są wykonywane sekwencyjnie
+ * w bieżącym wątku, dzięki czemu nie dochodzi do nadsubskrypcji rdzeni.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Tworzy pulę z `num_threads` wątkami roboczymi.
+     *
+     * @param num_threads Liczba wątków roboczych. Wartość 0 oznacza `std::thread::hardware_concurrency() - 1`
+     *        (wątek wywołujący jest traktowany jako dodatkowy wykonawca).
+     */
+    explicit ThreadPool(std::size_t num_threads = 0);
+
+    /**
+     * @brief Tworzy pulę według podanych parametrów (liczba wątków, przypinanie do węzłów NUMA).
+     */
+    explicit ThreadPool(const ThreadPoolOptions& options);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Liczba wątków roboczych puli (bez wątku wywołującego).
+     */
+    std::size_t size() const { return threads_.size(); }
+
+    /**
+     * @brief Liczba węzłów NUMA, do których przypięto wątki robocze (0, jeśli wątki nie są przypięte).
+     */
+    std::size_t numa_nodes() const { return numa_nodes_; }
+
+    /**
+     * @brief Dzieli zakres [begin, end) na fragmenty o rozmiarze `grain` i wykonuje `body(lo, hi)` dla każdego z nich.
+     *
+     * Funkcja wraca dopiero po przetworzeniu wszystkich fragmentów. Pierwszy wyjątek rzucony
+     * przez `body` jest przekazywany do wywołującego po zakończeniu pozostałych fragmentów.
+     *
+     * @param begin Początek zakresu indeksów.
+     * @param end Koniec zakresu indeksów (wyłącznie).
+     * @param grain Maksymalny rozmiar fragmentu (musi być dodatni).
+     * @param body Funkcja wywoływana dla podzakresu [lo, hi).
+     * @throws std::invalid_argument Jeśli `grain == 0`.
+     */
+    void parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                      const std::function<void(std::size_t, std::size_t)>& body);
+
+    /**
+     * @brief Globalna pula wątków biblioteki (tworzona przy pierwszym użyciu).
+     *
+     * Jest to jedyna pula używana przez równoległe ścieżki biblioteki (`ExecutionPolicy::Parallel`
+     * i `ExecutionPolicy::ParallelSimd`). Parametry ustala `configure_global`; bez niej liczbę
+     * wątków można podać zmienną środowiskową `NUMLIBCPP_NUM_THREADS`.
+     */
+    static ThreadPool& global();
+
+    /// Górna granica `NUMLIBCPP_NUM_THREADS` jako wielokrotność `std::thread::hardware_concurrency()`.
+    static constexpr long max_threads_per_core = 4;
+
+    /**
+     * @brief Parametry globalnej puli ze zmiennej środowiskowej `NUMLIBCPP_NUM_THREADS`.
+     *
+     * Wartość niebędąca liczbą całkowitą, ujemna lub większa niż `max_threads_per_core` razy
+     * liczba wątków sprzętowych jest ignorowana (liczba wątków domyślna, `num_threads = 0`).
+     */
+    static ThreadPoolOptions options_from_environment();
+
+    /**
+     * @brief Ustala parametry globalnej puli; musi zostać wywołana przed jej pierwszym użyciem.
+     *
+     * @code
+     * int main() {
+     *     NumLibCpp::ThreadPool::configure_global({8, true}); // 8 wątków roboczych przypiętych do węzłów NUMA
+     *     ...
+     * }
+     * @endcode
+     *
+     * @throws std::logic_error Jeśli globalna pula została już utworzona.
+     */
+    static void configure_global(const ThreadPoolOptions& options);
+
+private:
+    using Task = std::function<void()>;
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void push(Task task);
+    bool try_pop(std::size_t self, Task& out);
+    void worker_loop(std::size_t id);
+    void pin_to_numa_nodes();
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::vector<std::size_t>> steal_order_; // Kolejność przeszukiwania kolejek dla każdej kolejki
+    std::vector<std::vector<int>> node_cpus_;          // Procesory węzłów NUMA (puste bez przypinania)
+    std::vector<std::size_t> worker_node_;             // Węzeł przypisany wątkowi roboczemu
+    std::size_t numa_nodes_ = 0;
+    std::vector<std::thread> threads_;
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    std::size_t pending_ = 0;           // Chronione przez sleep_mutex_
+    bool stop_ = false;                 // Chronione przez sleep_mutex_
+    std::atomic<std::size_t> next_queue_{0};
+};
+
+} // namespace NumLibCpp
+
+#endif // NUMLIBCPP_THREAD_POOL_HPP
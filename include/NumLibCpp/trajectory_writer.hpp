@@ -0,0 +1,148 @@
+#ifndef NUMLIBCPP_TRAJECTORY_WRITER_HPP
+#define NUMLIBCPP_TRAJECTORY_WRITER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept> // Dla std::runtime_error, std::invalid_argument
+
+namespace NumLibCpp {
+
+/**
+ * @brief Szerokość wartości zapisywanych w pliku trajektorii.
+ */
+enum class TrajectoryPrecision : std::uint32_t {
+    Float32 = 4, ///< Wartości zapisywane jako float (połowa rozmiaru pliku).
+    Float64 = 8  ///< Wartości zapisywane jako double (bez utraty dokładności).
+};
+
+/**
+ * @brief Strumieniowy zapis trajektorii do zwartego pliku binarnego w wątku tła.
+ *
+ * Format pliku (kolejność bajtów maszyny):
+ * - nagłówek 32 bajty: magiczne "NLTRAJ\0\0" (8 B), wersja (uint32 = 1), rozmiar stanu n (uint32),
+ *   szerokość wartości w bajtach (uint32: 4 lub 8), zarezerwowane (uint32), liczba rekordów (uint64),
+ * - rekordy o stałej szerokości: x, y_0, ..., y_{n-1}, każda wartość jako float lub double.
+ *
+ * Rekordy trafiają do ograniczonej puli buforów, które wątek tła zapisuje na dysk. Pamięć jest
+ * stała niezależnie od długości symulacji, a wątek obliczeń czeka tylko wtedy, gdy wszystkie
+ * bufory czekają na zapis. Liczba rekordów w nagłówku jest uzupełniana w `close()`.
+ *
+ * @example
+ * @code
+ * NumLibCpp::TrajectoryWriter writer("cooling.traj", 1, NumLibCpp::TrajectoryPrecision::Float32);
+ * NumLibCpp::rk4_solve(cooling_ode_func, 0.0, 100.0, 600.0, 1000000,
+ *     [&](double t, double T) { writer.write(t, T); });
+ * writer.close();
+ * NumLibCpp::TrajectoryData data = NumLibCpp::read_trajectory("cooling.traj");
+ * @endcode
+ */
+class TrajectoryWriter {
+public:
+    /**
+     * @brief Otwiera plik `path` do zapisu i uruchamia wątek zapisujący.
+     *
+     * @param path Ścieżka pliku wyjściowego (nadpisywanego).
+     * @param state_size Liczba składowych stanu y w rekordzie (musi być dodatnia).
+     * @param precision Szerokość zapisywanych wartości.
+     * @param buffer_records Liczba rekordów w jednym buforze (musi być dodatnia).
+     * @throws std::invalid_argument Jeśli `state_size == 0` lub `buffer_records == 0`.
+     * @throws std::runtime_error Jeśli pliku nie można otworzyć.
+     */
+    TrajectoryWriter(const std::string& path, std::size_t state_size,
+                     TrajectoryPrecision precision = TrajectoryPrecision::Float64,
+                     std::size_t buffer_records = 4096);
+
+    /**
+     * @brief Zamyka plik (jak `close()`), ignorując ewentualne błędy zapisu.
+     */
+    ~TrajectoryWriter();
+
+    TrajectoryWriter(const TrajectoryWriter&) = delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+    /**
+     * @brief Dodaje rekord (x, y[0..n-1]).
+     * @throws std::runtime_error Jeśli plik został zamknięty lub wątek tła zgłosił błąd zapisu.
+     */
+    void write(double x, const double* y);
+
+    /**
+     * @brief Dodaje rekord (x, y); `y.size()` musi być równe rozmiarowi stanu.
+     * @throws std::invalid_argument Jeśli rozmiar `y` jest niezgodny z rozmiarem stanu.
+     */
+    void write(double x, const std::vector<double>& y);
+
+    /**
+     * @brief Dodaje rekord (x, y) dla stanu skalarnego (rozmiar stanu 1).
+     * @throws std::invalid_argument Jeśli rozmiar stanu jest różny od 1.
+     */
+    void write(double x, double y);
+
+    /**
+     * @brief Zapisuje pozostałe dane, uzupełnia nagłówek i zamyka plik. Kolejne wywołania nic nie robią.
+     * @throws std::runtime_error Jeśli wystąpił błąd zapisu.
+     */
+    void close();
+
+    /**
+     * @brief Liczba rekordów przyjętych do zapisu.
+     */
+    std::uint64_t records_written() const { return records_; }
+
+private:
+    void writer_loop();
+    void flush_active();
+    void rethrow_if_failed();
+
+    std::ofstream file_;
+    std::size_t state_size_;
+    TrajectoryPrecision precision_;
+    std::size_t record_bytes_;
+    std::size_t buffer_bytes_;
+    std::uint64_t records_ = 0;
+    bool closed_ = false;
+
+    std::vector<char> active_;                 // Bufor wypełniany przez wątek obliczeń
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::vector<char>> full_;       // Bufory czekające na zapis
+    std::vector<std::vector<char>> free_;      // Bufory gotowe do ponownego użycia
+    std::size_t buffers_in_flight_ = 0;        // Bufory poza wątkiem obliczeń (full_ + zapisywany)
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::thread thread_;
+};
+
+/**
+ * @brief Trajektoria wczytana z pliku zapisanego przez `TrajectoryWriter`.
+ */
+struct TrajectoryData {
+    std::size_t state_size = 0;
+    TrajectoryPrecision precision = TrajectoryPrecision::Float64;
+    std::vector<double> x;   ///< Kolejne wartości x.
+    std::vector<double> y;   ///< Stany, rekord i pod indeksami [i*state_size, (i+1)*state_size).
+};
+
+/**
+ * @brief Wczytuje plik trajektorii zapisany przez `TrajectoryWriter`.
+ *
+ * Jeśli plik nie został poprawnie zamknięty (liczba rekordów w nagłówku wynosi 0),
+ * liczba rekordów jest wyznaczana z rozmiaru pliku.
+ *
+ * @param path Ścieżka pliku.
+ * @return TrajectoryData Wczytane dane.
+ * @throws std::runtime_error Jeśli pliku nie można odczytać lub ma niepoprawny format.
+ */
+TrajectoryData read_trajectory(const std::string& path);
+
+} // namespace NumLibCpp
+
+#endif // NUMLIBCPP_TRAJECTORY_WRITER_HPP
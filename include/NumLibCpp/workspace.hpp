@@ -0,0 +1,100 @@
+#ifndef NUMLIBCPP_WORKSPACE_HPP
+#define NUMLIBCPP_WORKSPACE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace NumLibCpp {
+
+/**
+ * @brief Arena pamięci roboczej wielokrotnego użytku (alokacja przez przesuwanie wskaźnika).
+ *
+ * Funkcje przyjmujące `Workspace&` biorą z niej bufory pomocnicze zamiast alokować je na stercie
+ * i zwalniają je przy wyjściu (przez `Workspace::Frame`). Pamięć nie jest oddawana systemowi, więc po
+ * pierwszym wywołaniu dla danego rozmiaru problemu kolejne wywołania nie wykonują żadnej alokacji.
+ * Obiekt nie jest bezpieczny wątkowo - każdy wątek powinien używać własnej areny.
+ *
+ * @example
+ * @code
+ * NumLibCpp::Workspace ws;
+ * std::vector<double> x;
+ * for (const Request& r : requests) {
+ *     NumLibCpp::gauss_elimination(r.A, r.b, x, ws); // Od drugiej iteracji bez alokacji
+ *     respond(x);
+ * }
+ * @endcode
+ */
+class Workspace {
+public:
+    /// Wyrównanie każdego bufora [B] (linia pamięci podręcznej).
+    static constexpr std::size_t alignment = 64;
+
+    /**
+     * @param initial_bytes Rozmiar pierwszego bloku (0 - blok tworzony przy pierwszej alokacji).
+     */
+    explicit Workspace(std::size_t initial_bytes = 0);
+
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+    Workspace(Workspace&&) noexcept = default;
+    Workspace& operator=(Workspace&&) noexcept = default;
+
+    /**
+     * @brief Zwraca niezainicjalizowany bufor `count` elementów typu `T`, ważny do zwolnienia ramki lub `reset()`.
+     */
+    template <typename T>
+    T* allocate(std::size_t count) {
+        static_assert(std::is_trivially_destructible_v<T> && alignof(T) <= alignment,
+                      "Workspace przechowuje tylko typy bez destruktora");
+        return static_cast<T*>(allocate_bytes(count * sizeof(T)));
+    }
+
+    /// Zwalnia wszystkie bufory (bloki pamięci pozostają do ponownego użycia).
+    void reset();
+
+    /// Łączny rozmiar bloków [B].
+    std::size_t capacity() const;
+
+    /// Liczba bajtów zajętych od początku areny (z wyrównaniem, także w pominiętych końcówkach bloków).
+    std::size_t used() const;
+
+    /**
+     * @brief Zakres alokacji: destruktor zwalnia wszystkie bufory przydzielone od utworzenia ramki.
+     */
+    class Frame {
+    public:
+        explicit Frame(Workspace& workspace)
+            : workspace_(workspace), block_(workspace.current_), offset_(workspace.offset_) {}
+        ~Frame() {
+            workspace_.current_ = block_;
+            workspace_.offset_ = offset_;
+        }
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+    private:
+        Workspace& workspace_;
+        std::size_t block_;
+        std::size_t offset_;
+    };
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t size = 0; // Bez zapasu na wyrównanie początku
+    };
+
+    void* allocate_bytes(std::size_t bytes);
+    void* try_bump(std::size_t bytes);
+
+    std::vector<Block> blocks_;
+    std::size_t current_ = 0; // Blok, z którego przydzielana jest pamięć
+    std::size_t offset_ = 0;  // Zajęta część bieżącego bloku
+};
+
+} // namespace NumLibCpp
+
+#endif // NUMLIBCPP_WORKSPACE_HPP
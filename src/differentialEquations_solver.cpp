@@ -1,26 +1,726 @@
 #include "NumLibCpp/differentialEquations_solver.hpp"
+#include "NumLibCpp/thread_pool.hpp" // Dla ThreadPool::global
+#include "NumLibCpp/linear_solver.hpp" // Dla lu_decompose, lu_solve
+#include "NumLibCpp/differentiation.hpp" // Dla numerical_jacobian
+#include "NumLibCpp/instrumentation.hpp"
+#include <algorithm> // Dla std::min, std::max
+#include <array>
+#include <cmath>     // Dla std::abs, std::pow, std::sqrt
+#include <limits>    // Dla std::numeric_limits
 
 namespace NumLibCpp {
 
 double rk4_solve(std::function<double(double, double)> f, double x0, double y0, double x_target, int num_steps) {
+    return detail::rk4_solve_impl(f, x0, y0, x_target, num_steps);
+}
+
+double rk4_solve(std::function<double(double, double)> f, double x0, double y0, double x_target, int num_steps,
+                 const StepObserver& observer) {
+    return detail::rk4_solve_observed_impl(f, x0, y0, x_target, num_steps, observer);
+}
+
+double rk4_solve(std::function<double(double, double)> f, double x0, double y0, double x_target, int num_steps,
+                 const std::vector<double>& output_points, const StepObserver& observer) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("rk4_solve");
     if (num_steps <= 0) {
         throw std::invalid_argument("Liczba krokow musi byc dodatnia.");
     }
+    const double direction = x_target >= x0 ? 1.0 : -1.0;
+    for (size_t i = 0; i < output_points.size(); ++i) {
+        double p = output_points[i];
+        if (direction * (p - x0) < 0.0 || direction * (p - x_target) > 0.0) {
+            throw std::invalid_argument("Punkty wyjsciowe musza lezec w przedziale [x0, x_target].");
+        }
+        if (i > 0 && direction * (p - output_points[i - 1]) < 0.0) {
+            throw std::invalid_argument("Punkty wyjsciowe musza byc uporzadkowane od x0 do x_target.");
+        }
+    }
 
     double h = (x_target - x0) / num_steps;
+    if (h == 0.0) {
+        for (double p : output_points) {
+            observer(p, y0);
+        }
+        return y0;
+    }
+
     double x = x0;
     double y = y0;
+    double fx = f(x, y);
+    size_t next = 0;
+    NUMLIBCPP_COUNT(iterations, num_steps);
+    NUMLIBCPP_COUNT(function_evaluations, 1 + 3 * static_cast<std::uint64_t>(num_steps));
 
     for (int i = 0; i < num_steps; ++i) {
-        double k1 = h * f(x, y);
+        double k1 = h * fx;
         double k2 = h * f(x + 0.5 * h, y + 0.5 * k1);
         double k3 = h * f(x + 0.5 * h, y + 0.5 * k2);
         double k4 = h * f(x + h, y + k3);
 
-        y = y + (k1 + 2.0 * k2 + 2.0 * k3 + k4) / 6.0;
-        x = x + h; // lub x = x0 + (i+1)*h dla większej precyzji
+        double y_new = y + (k1 + 2.0 * k2 + 2.0 * k3 + k4) / 6.0;
+        double x_new = x + h;
+        bool last = (i == num_steps - 1);
+
+        // f na końcu kroku jest potrzebne jako k1 następnego kroku lub do interpolacji
+        double f_new = 0.0;
+        if (!last || next < output_points.size()) {
+            f_new = f(x_new, y_new);
+            NUMLIBCPP_COUNT(function_evaluations, 1);
+        }
+
+        // Interpolacja Hermite'a na [x, x_new]; w ostatnim kroku obsługujemy wszystkie pozostałe punkty
+        while (next < output_points.size() && (last || direction * (output_points[next] - x_new) <= 0.0)) {
+            double t = (output_points[next] - x) / h;
+            double t2 = t * t;
+            double t3 = t2 * t;
+            double value = (2.0 * t3 - 3.0 * t2 + 1.0) * y
+                         + (t3 - 2.0 * t2 + t) * h * fx
+                         + (-2.0 * t3 + 3.0 * t2) * y_new
+                         + (t3 - t2) * h * f_new;
+            observer(output_points[next], value);
+            ++next;
+        }
+
+        x = x_new;
+        y = y_new;
+        fx = f_new;
     }
     return y;
 }
 
-} // namespace NumLibCpp
\ No newline at end of file
+namespace {
+// Liczba trajektorii przetwarzanych razem; 4 bufory po 256 wartości mieszczą się w L1
+constexpr std::size_t ensemble_block_size = 256;
+}
+
+std::vector<double> rk4_solve_ensemble(const EnsembleRhs& f, double x0, const std::vector<double>& y0,
+                                       double x_target, int num_steps) {
+    return rk4_solve_ensemble(f, x0, y0, x_target, num_steps, ExecutionPolicy::Parallel);
+}
+
+template <typename T>
+std::vector<T> rk4_solve_ensemble(const BasicEnsembleRhs<detail::type_identity_t<T>>& f, detail::type_identity_t<T> x0,
+                                  const std::vector<T>& y0, detail::type_identity_t<T> x_target, int num_steps,
+                                  ExecutionPolicy policy) {
+    std::vector<T> result(y0);
+    rk4_solve_ensemble_in_place<T>(f, x0, result, x_target, num_steps, policy);
+    return result;
+}
+
+template <typename T>
+void rk4_solve_ensemble_in_place(const BasicEnsembleRhs<detail::type_identity_t<T>>& f, detail::type_identity_t<T> x0,
+                                 std::vector<T>& y, detail::type_identity_t<T> x_target, int num_steps,
+                                 ExecutionPolicy policy) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("rk4_solve_ensemble");
+    if (num_steps <= 0) {
+        throw std::invalid_argument("Liczba krokow musi byc dodatnia.");
+    }
+
+    const T h = (x_target - x0) / num_steps;
+
+    auto integrate_blocks = [&](std::size_t lo, std::size_t hi) {
+        T dydx[ensemble_block_size];
+        T acc[ensemble_block_size];  // k1 + 2*k2 + 2*k3 (bez czynnika h)
+        T tmp[ensemble_block_size];  // Stan pośredni etapu
+
+        for (std::size_t first = lo; first < hi; first += ensemble_block_size) {
+            const std::size_t count = std::min(ensemble_block_size, hi - first);
+            T* y_block = y.data() + first;
+            T x = x0;
+
+            for (int step = 0; step < num_steps; ++step) {
+                f(x, y_block, dydx, first, count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    acc[i] = dydx[i];
+                    tmp[i] = y_block[i] + T(0.5) * h * dydx[i];
+                }
+                f(x + T(0.5) * h, tmp, dydx, first, count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    acc[i] += 2 * dydx[i];
+                    tmp[i] = y_block[i] + T(0.5) * h * dydx[i];
+                }
+                f(x + T(0.5) * h, tmp, dydx, first, count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    acc[i] += 2 * dydx[i];
+                    tmp[i] = y_block[i] + h * dydx[i];
+                }
+                f(x + h, tmp, dydx, first, count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    y_block[i] += h * (acc[i] + dydx[i]) / 6;
+                }
+                x = x + h;
+            }
+        }
+    };
+
+    if (policy == ExecutionPolicy::Sequential) {
+        integrate_blocks(0, y.size());
+    } else {
+        ThreadPool::global().parallel_for(0, y.size(), ensemble_block_size, integrate_blocks);
+    }
+
+    NUMLIBCPP_COUNT(iterations, num_steps);
+    NUMLIBCPP_COUNT(function_evaluations, 4 * static_cast<std::uint64_t>(num_steps) * y.size());
+}
+
+// Wersje dla double poza szablonami zachowują dotychczasowe symbole biblioteki
+std::vector<double> rk4_solve_ensemble(const EnsembleRhs& f, double x0, const std::vector<double>& y0,
+                                       double x_target, int num_steps, ExecutionPolicy policy) {
+    return rk4_solve_ensemble<double>(f, x0, y0, x_target, num_steps, policy);
+}
+
+void rk4_solve_ensemble_in_place(const EnsembleRhs& f, double x0, std::vector<double>& y, double x_target,
+                                 int num_steps, ExecutionPolicy policy) {
+    rk4_solve_ensemble_in_place<double>(f, x0, y, x_target, num_steps, policy);
+}
+
+// Jawne konkretyzacje dla obsługiwanych typów skalarnych
+template std::vector<float> rk4_solve_ensemble<float>(const BasicEnsembleRhs<float>&, float, const std::vector<float>&, float, int,
+                                                   ExecutionPolicy);
+template void rk4_solve_ensemble_in_place<float>(const BasicEnsembleRhs<float>&, float, std::vector<float>&, float, int,
+                                                ExecutionPolicy);
+template std::vector<double> rk4_solve_ensemble<double>(const BasicEnsembleRhs<double>&, double, const std::vector<double>&, double, int,
+                                                   ExecutionPolicy);
+template void rk4_solve_ensemble_in_place<double>(const BasicEnsembleRhs<double>&, double, std::vector<double>&, double, int,
+                                                ExecutionPolicy);
+template std::vector<long double> rk4_solve_ensemble<long double>(const BasicEnsembleRhs<long double>&, long double, const std::vector<long double>&, long double, int,
+                                                   ExecutionPolicy);
+template void rk4_solve_ensemble_in_place<long double>(const BasicEnsembleRhs<long double>&, long double, std::vector<long double>&, long double, int,
+                                                ExecutionPolicy);
+
+// --- Sztywne solvery (BDF, Rosenbrock) ---
+
+namespace {
+
+constexpr int bdf_max_order = 5;
+constexpr int newton_max_iter = 4;
+constexpr double step_min_factor = 0.2;
+constexpr double step_max_factor = 10.0;
+constexpr double machine_eps = std::numeric_limits<double>::epsilon();
+
+double rms_norm(const std::vector<double>& v, const std::vector<double>& scale) {
+    double sum = 0.0;
+    for (size_t i = 0; i < v.size(); ++i) {
+        double r = v[i] / scale[i];
+        sum += r * r;
+    }
+    return std::sqrt(sum / v.size());
+}
+
+void validate_stiff_arguments(const std::vector<double>& y0, const StiffSolverOptions& options) {
+    if (y0.empty()) {
+        throw std::invalid_argument("Warunek poczatkowy y0 nie moze byc pusty.");
+    }
+    if (options.rtol <= 0.0 || options.atol < 0.0) {
+        throw std::invalid_argument("Tolerancja rtol musi byc dodatnia, a atol nieujemna.");
+    }
+    if (options.initial_step < 0.0 || options.max_step < 0.0) {
+        throw std::invalid_argument("Ograniczenia kroku nie moga byc ujemne.");
+    }
+    if (options.max_steps <= 0) {
+        throw std::invalid_argument("Maksymalna liczba krokow musi byc dodatnia.");
+    }
+}
+
+// Wspólne dla obu solverów: wywołania f i jakobianu z liczeniem statystyk oraz macierz iteracji
+class StiffProblem {
+public:
+    StiffProblem(const OdeSystem& f, const StiffSolverOptions& options, StiffSolverResult& stats, size_t n)
+        : f_(f), options_(options), stats_(stats), n_(n) {}
+
+    std::vector<double> eval(double x, const std::vector<double>& y) {
+        ++stats_.function_evaluations;
+        std::vector<double> dydx = f_(x, y);
+        if (dydx.size() != n_) {
+            throw std::invalid_argument("Funkcja f musi zwracac wektor o rozmiarze y0.");
+        }
+        return dydx;
+    }
+
+    std::vector<std::vector<double>> jacobian(double x, const std::vector<double>& y) {
+        ++stats_.jacobian_evaluations;
+        std::vector<std::vector<double>> J;
+        if (options_.jacobian) {
+            J = options_.jacobian(x, y);
+        } else {
+            const OdeSystem& f = f_;
+            J = numerical_jacobian([&f, x](const std::vector<double>& v) { return f(x, v); },
+                                   y, std::cbrt(machine_eps));
+        }
+        if (J.size() != n_) {
+            throw std::invalid_argument("Jakobian musi miec wymiary n x n.");
+        }
+        return J;
+    }
+
+    // Rozkład LU macierzy iteracji I - c*J
+    LUDecomposition factor(const std::vector<std::vector<double>>& J, double c) {
+        std::vector<std::vector<double>> M(n_, std::vector<double>(n_));
+        for (size_t i = 0; i < n_; ++i) {
+            for (size_t j = 0; j < n_; ++j) {
+                M[i][j] = (i == j ? 1.0 : 0.0) - c * J[i][j];
+            }
+        }
+        ++stats_.lu_decompositions;
+        return lu_decompose(M);
+    }
+
+private:
+    const OdeSystem& f_;
+    const StiffSolverOptions& options_;
+    StiffSolverResult& stats_;
+    size_t n_;
+};
+
+// Heurystyczny wybór kroku początkowego (Hairer, Nørsett, Wanner, "Solving ODE I", II.4)
+double select_initial_step(StiffProblem& problem, double x0, const std::vector<double>& y0,
+                           const std::vector<double>& f0, double direction, int order,
+                           const StiffSolverOptions& options) {
+    const size_t n = y0.size();
+    std::vector<double> scale(n);
+    for (size_t i = 0; i < n; ++i) {
+        scale[i] = options.atol + std::abs(y0[i]) * options.rtol;
+    }
+    double d0 = rms_norm(y0, scale);
+    double d1 = rms_norm(f0, scale);
+    double h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+
+    std::vector<double> y1(n);
+    for (size_t i = 0; i < n; ++i) {
+        y1[i] = y0[i] + h0 * direction * f0[i];
+    }
+    std::vector<double> f1 = problem.eval(x0 + h0 * direction, y1);
+    for (size_t i = 0; i < n; ++i) {
+        f1[i] -= f0[i];
+    }
+    double d2 = rms_norm(f1, scale) / h0;
+
+    double h1;
+    if (d1 <= 1e-15 && d2 <= 1e-15) {
+        h1 = std::max(1e-6, h0 * 1e-3);
+    } else {
+        h1 = std::pow(0.01 / std::max(d1, d2), 1.0 / (order + 1));
+    }
+    return std::min(100.0 * h0, h1);
+}
+
+// Macierz R(order, factor) przeliczająca tablicę różnic przy zmianie kroku h -> factor*h
+std::vector<std::vector<double>> bdf_compute_R(int order, double factor) {
+    std::vector<std::vector<double>> R(order + 1, std::vector<double>(order + 1, 0.0));
+    for (int j = 0; j <= order; ++j) {
+        R[0][j] = 1.0;
+    }
+    for (int i = 1; i <= order; ++i) {
+        for (int j = 1; j <= order; ++j) {
+            R[i][j] = R[i - 1][j] * (i - 1 - factor * j) / i;
+        }
+    }
+    return R;
+}
+
+void bdf_change_D(std::vector<std::vector<double>>& D, int order, double factor) {
+    auto R = bdf_compute_R(order, factor);
+    auto U = bdf_compute_R(order, 1.0);
+    const size_t n = D[0].size();
+
+    std::vector<std::vector<double>> RU(order + 1, std::vector<double>(order + 1, 0.0));
+    for (int i = 0; i <= order; ++i) {
+        for (int k = 0; k <= order; ++k) {
+            for (int j = 0; j <= order; ++j) {
+                RU[i][j] += R[i][k] * U[k][j];
+            }
+        }
+    }
+
+    std::vector<std::vector<double>> D_new(order + 1, std::vector<double>(n, 0.0));
+    for (int i = 0; i <= order; ++i) {
+        for (int k = 0; k <= order; ++k) {
+            for (size_t m = 0; m < n; ++m) {
+                D_new[i][m] += RU[k][i] * D[k][m];
+            }
+        }
+    }
+    for (int i = 0; i <= order; ++i) {
+        D[i] = std::move(D_new[i]);
+    }
+}
+
+// Uproszczona iteracja Newtona dla równania BDF: c*f(x_new, y) - psi - d = 0, y = y_predict + d
+bool bdf_solve_system(StiffProblem& problem, double x_new, const std::vector<double>& y_predict, double c,
+                      const std::vector<double>& psi, const LUDecomposition& lu,
+                      const std::vector<double>& scale, double tol,
+                      std::vector<double>& y, std::vector<double>& d, int& n_iter) {
+    const size_t n = y_predict.size();
+    y = y_predict;
+    d.assign(n, 0.0);
+    double dy_norm_old = -1.0;
+
+    for (n_iter = 1; n_iter <= newton_max_iter; ++n_iter) {
+        std::vector<double> f = problem.eval(x_new, y);
+        std::vector<double> rhs(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (!std::isfinite(f[i])) {
+                return false;
+            }
+            rhs[i] = c * f[i] - psi[i] - d[i];
+        }
+        std::vector<double> dy = lu_solve(lu, rhs);
+        double dy_norm = rms_norm(dy, scale);
+
+        double rate = -1.0;
+        if (dy_norm_old > 0.0) {
+            rate = dy_norm / dy_norm_old;
+            // Zbieżność za wolna, aby osiągnąć tolerancję w pozostałych iteracjach
+            if (rate >= 1.0 || std::pow(rate, newton_max_iter - n_iter + 1) / (1.0 - rate) * dy_norm > tol) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            y[i] += dy[i];
+            d[i] += dy[i];
+        }
+        if (dy_norm == 0.0 || (rate > 0.0 && rate / (1.0 - rate) * dy_norm < tol)) {
+            return true;
+        }
+        dy_norm_old = dy_norm;
+    }
+    n_iter = newton_max_iter;
+    return false;
+}
+
+} // namespace
+
+StiffSolverResult bdf_solve(const OdeSystem& f, double x0, const std::vector<double>& y0, double x_target,
+                            const StiffSolverOptions& options) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("bdf_solve");
+    validate_stiff_arguments(y0, options);
+    StiffSolverResult result;
+    result.y = y0;
+    if (x_target == x0) {
+        return result;
+    }
+
+    const size_t n = y0.size();
+    StiffProblem problem(f, options, result, n);
+    const double direction = x_target > x0 ? 1.0 : -1.0;
+    const double max_step = options.max_step > 0.0 ? options.max_step : std::numeric_limits<double>::infinity();
+    const double newton_tol = std::max(10.0 * machine_eps / options.rtol, std::min(0.03, std::sqrt(options.rtol)));
+
+    // gamma_k = sum_{j=1..k} 1/j; stała błędu rzędu k to 1/(k+1)
+    std::array<double, bdf_max_order + 2> gamma{};
+    std::array<double, bdf_max_order + 2> error_const{};
+    error_const[0] = 1.0;
+    for (int k = 1; k <= bdf_max_order + 1; ++k) {
+        gamma[k] = gamma[k - 1] + 1.0 / k;
+        error_const[k] = 1.0 / (k + 1);
+    }
+
+    if (options.observer) {
+        options.observer(x0, y0);
+    }
+    std::vector<double> f0 = problem.eval(x0, y0);
+    double h_abs = options.initial_step > 0.0 ? options.initial_step
+                                              : select_initial_step(problem, x0, y0, f0, direction, 1, options);
+    h_abs = std::min({h_abs, max_step, std::abs(x_target - x0)});
+
+    // Tablica różnic wstecznych D[k] = nabla^k y (przeskalowana krokiem)
+    std::vector<std::vector<double>> D(bdf_max_order + 3, std::vector<double>(n, 0.0));
+    D[0] = y0;
+    for (size_t i = 0; i < n; ++i) {
+        D[1][i] = h_abs * direction * f0[i];
+    }
+
+    int order = 1;
+    int n_equal_steps = 0;
+    double x = x0;
+    std::vector<std::vector<double>> J = problem.jacobian(x0, y0);
+    bool current_jac = true;
+    LUDecomposition lu;
+    bool lu_valid = false;
+
+    std::vector<double> y_predict(n), psi(n), scale(n), y_new, d;
+
+    while (direction * (x_target - x) > 0.0) {
+        double min_step = 10.0 * machine_eps * std::abs(x);
+        if (h_abs > max_step) {
+            bdf_change_D(D, order, max_step / h_abs);
+            h_abs = max_step;
+            n_equal_steps = 0;
+            lu_valid = false;
+        } else if (h_abs < min_step) {
+            bdf_change_D(D, order, min_step / h_abs);
+            h_abs = min_step;
+            n_equal_steps = 0;
+            lu_valid = false;
+        }
+
+        bool accepted = false;
+        double x_new = x;
+        double safety = 0.9;
+        while (!accepted) {
+            if (result.steps + result.rejected_steps >= options.max_steps) {
+                throw std::runtime_error("Przekroczono maksymalna liczbe krokow solvera BDF.");
+            }
+            if (h_abs < min_step) {
+                throw std::runtime_error("Krok solvera BDF spadl ponizej dokladnosci maszynowej.");
+            }
+
+            x_new = x + h_abs * direction;
+            if (direction * (x_new - x_target) > 0.0) {
+                x_new = x_target;
+                bdf_change_D(D, order, std::abs(x_new - x) / h_abs);
+                n_equal_steps = 0;
+                lu_valid = false;
+            }
+            double h = x_new - x;
+            h_abs = std::abs(h);
+
+            for (size_t i = 0; i < n; ++i) {
+                double pred = 0.0;
+                double p = 0.0;
+                for (int k = 0; k <= order; ++k) {
+                    pred += D[k][i];
+                    if (k > 0) {
+                        p += D[k][i] * gamma[k];
+                    }
+                }
+                y_predict[i] = pred;
+                psi[i] = p / gamma[order];
+                scale[i] = options.atol + options.rtol * std::abs(pred);
+            }
+            const double c = h / gamma[order];
+
+            bool converged = false;
+            int n_iter = 0;
+            for (;;) {
+                if (!lu_valid) {
+                    lu = problem.factor(J, c);
+                    lu_valid = true;
+                }
+                converged = bdf_solve_system(problem, x_new, y_predict, c, psi, lu, scale, newton_tol, y_new, d, n_iter);
+                if (converged || current_jac) {
+                    break;
+                }
+                // Newton zwalnia przy starym jakobianie - liczymy go ponownie, krok bez zmian
+                J = problem.jacobian(x_new, y_predict);
+                current_jac = true;
+                lu_valid = false;
+            }
+
+            if (!converged) {
+                h_abs *= 0.5;
+                bdf_change_D(D, order, 0.5);
+                n_equal_steps = 0;
+                lu_valid = false;
+                ++result.rejected_steps;
+                continue;
+            }
+
+            safety = 0.9 * (2 * newton_max_iter + 1) / (2 * newton_max_iter + n_iter);
+            for (size_t i = 0; i < n; ++i) {
+                scale[i] = options.atol + options.rtol * std::abs(y_new[i]);
+            }
+            std::vector<double> error(n);
+            for (size_t i = 0; i < n; ++i) {
+                error[i] = error_const[order] * d[i];
+            }
+            double error_norm = rms_norm(error, scale);
+
+            if (error_norm > 1.0) {
+                double factor = std::max(step_min_factor, safety * std::pow(error_norm, -1.0 / (order + 1)));
+                h_abs *= factor;
+                bdf_change_D(D, order, factor);
+                n_equal_steps = 0;
+                lu_valid = false;
+                ++result.rejected_steps;
+            } else {
+                accepted = true;
+            }
+        }
+
+        ++result.steps;
+        ++n_equal_steps;
+        x = x_new;
+        result.y = y_new;
+        current_jac = false;
+        if (options.observer) {
+            options.observer(x, result.y);
+        }
+
+        // Aktualizacja tablicy różnic
+        for (size_t i = 0; i < n; ++i) {
+            D[order + 2][i] = d[i] - D[order + 1][i];
+            D[order + 1][i] = d[i];
+        }
+        for (int k = order; k >= 0; --k) {
+            for (size_t i = 0; i < n; ++i) {
+                D[k][i] += D[k + 1][i];
+            }
+        }
+
+        if (n_equal_steps < order + 1) {
+            continue;
+        }
+
+        // Wybór rzędu: porównanie estymat błędu dla rzędów order-1, order, order+1
+        std::vector<double> tmp(n);
+        auto scaled_norm = [&](int k, int row) {
+            for (size_t i = 0; i < n; ++i) {
+                tmp[i] = error_const[k] * D[row][i];
+            }
+            return rms_norm(tmp, scale);
+        };
+        const double inf = std::numeric_limits<double>::infinity();
+        std::array<double, 3> error_norms = {
+            order > 1 ? scaled_norm(order - 1, order) : inf,
+            scaled_norm(order, order + 1),
+            order < bdf_max_order ? scaled_norm(order + 1, order + 2) : inf};
+
+        int best = 0;
+        double best_factor = -1.0;
+        for (int k = 0; k < 3; ++k) {
+            double factor = std::pow(error_norms[k], -1.0 / (order + k));
+            if (factor > best_factor) {
+                best_factor = factor;
+                best = k;
+            }
+        }
+        order += best - 1;
+
+        double factor = std::min(step_max_factor, safety * best_factor);
+        h_abs *= factor;
+        bdf_change_D(D, order, factor);
+        n_equal_steps = 0;
+        lu_valid = false;
+    }
+
+    NUMLIBCPP_COUNT(iterations, result.steps + result.rejected_steps);
+    NUMLIBCPP_COUNT(function_evaluations, result.function_evaluations);
+    return result;
+}
+
+StiffSolverResult rosenbrock_solve(const OdeSystem& f, double x0, const std::vector<double>& y0, double x_target,
+                                   const StiffSolverOptions& options) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("rosenbrock_solve");
+    validate_stiff_arguments(y0, options);
+    StiffSolverResult result;
+    result.y = y0;
+    if (x_target == x0) {
+        return result;
+    }
+
+    const size_t n = y0.size();
+    StiffProblem problem(f, options, result, n);
+    const double direction = x_target > x0 ? 1.0 : -1.0;
+    const double max_step = options.max_step > 0.0 ? options.max_step : std::numeric_limits<double>::infinity();
+    // Współczynniki pary Rosenbrocka 2(3) (Shampine, Reichelt 1997)
+    const double d = 1.0 / (2.0 + std::sqrt(2.0));
+    const double e32 = 6.0 + std::sqrt(2.0);
+
+    double x = x0;
+    std::vector<double>& y = result.y;
+    if (options.observer) {
+        options.observer(x0, y0);
+    }
+    std::vector<double> F0 = problem.eval(x0, y0);
+    double h_abs = options.initial_step > 0.0 ? options.initial_step
+                                              : select_initial_step(problem, x0, y0, F0, direction, 2, options);
+
+    std::vector<std::vector<double>> J;
+    std::vector<double> dfdx(n);
+    bool derivatives_current = false; // Czy J i df/dx odpowiadają bieżącemu punktowi (x, y)
+    LUDecomposition lu;
+    double lu_h = 0.0; // Krok, dla którego policzono lu (0 - brak ważnego rozkładu)
+
+    std::vector<double> tmp(n), rhs(n), y_new(n), err(n), scale(n);
+
+    while (direction * (x_target - x) > 0.0) {
+        if (result.steps + result.rejected_steps >= options.max_steps) {
+            throw std::runtime_error("Przekroczono maksymalna liczbe krokow solvera Rosenbrocka.");
+        }
+        h_abs = std::min(h_abs, max_step);
+        if (h_abs < 10.0 * machine_eps * std::abs(x)) {
+            throw std::runtime_error("Krok solvera Rosenbrocka spadl ponizej dokladnosci maszynowej.");
+        }
+        double h = h_abs * direction;
+        bool last = direction * (x + h - x_target) >= 0.0;
+        if (last) {
+            h = x_target - x;
+        }
+
+        if (!derivatives_current) {
+            J = problem.jacobian(x, y);
+            // Pochodna cząstkowa df/dx różnicą w przód (potrzebna dla równań nieautonomicznych)
+            double delta = std::sqrt(machine_eps) * std::max(std::abs(x), std::abs(h));
+            std::vector<double> F_shift = problem.eval(x + delta, y);
+            for (size_t i = 0; i < n; ++i) {
+                dfdx[i] = (F_shift[i] - F0[i]) / delta;
+            }
+            derivatives_current = true;
+            lu_h = 0.0;
+        }
+
+        // Rozkład W = I - d*h*J jest ponownie używany, dopóki h i J się nie zmieniają
+        if (lu_h != h) {
+            lu = problem.factor(J, d * h);
+            lu_h = h;
+        }
+
+        // W k1 = F0 + h*d*df/dx
+        for (size_t i = 0; i < n; ++i) {
+            rhs[i] = F0[i] + h * d * dfdx[i];
+        }
+        std::vector<double> k1 = lu_solve(lu, rhs);
+
+        // W (k2 - k1) = F1 - k1
+        for (size_t i = 0; i < n; ++i) {
+            tmp[i] = y[i] + 0.5 * h * k1[i];
+        }
+        std::vector<double> F1 = problem.eval(x + 0.5 * h, tmp);
+        for (size_t i = 0; i < n; ++i) {
+            rhs[i] = F1[i] - k1[i];
+        }
+        std::vector<double> k2 = lu_solve(lu, rhs);
+        for (size_t i = 0; i < n; ++i) {
+            k2[i] += k1[i];
+            y_new[i] = y[i] + h * k2[i];
+        }
+
+        // Trzeci etap służy tylko do estymaty błędu; F2 jest ponownie używane jako F0 (FSAL)
+        const double x_new = last ? x_target : x + h;
+        std::vector<double> F2 = problem.eval(x_new, y_new);
+        for (size_t i = 0; i < n; ++i) {
+            rhs[i] = F2[i] - e32 * (k2[i] - F1[i]) - 2.0 * (k1[i] - F0[i]) + h * d * dfdx[i];
+        }
+        std::vector<double> k3 = lu_solve(lu, rhs);
+
+        for (size_t i = 0; i < n; ++i) {
+            err[i] = h / 6.0 * (k1[i] - 2.0 * k2[i] + k3[i]);
+            scale[i] = options.atol + options.rtol * std::max(std::abs(y[i]), std::abs(y_new[i]));
+        }
+        double error_norm = rms_norm(err, scale);
+        double factor = 0.9 * std::pow(error_norm, -1.0 / 3.0);
+
+        if (error_norm <= 1.0 && std::isfinite(error_norm)) {
+            x = x_new;
+            y = y_new;
+            F0 = std::move(F2);
+            ++result.steps;
+            if (options.observer) {
+                options.observer(x, y);
+            }
+            derivatives_current = false;
+            h_abs = std::abs(h) * std::min(step_max_factor, factor);
+        } else {
+            // Ten sam punkt (x, y) - jakobian pozostaje aktualny, potrzebny jest tylko nowy rozkład LU
+            ++result.rejected_steps;
+            h_abs = std::abs(h) * (std::isfinite(factor) ? std::max(step_min_factor, factor) : step_min_factor);
+        }
+    }
+
+    NUMLIBCPP_COUNT(iterations, result.steps + result.rejected_steps);
+    NUMLIBCPP_COUNT(function_evaluations, result.function_evaluations);
+    return result;
+}
+
+} // namespace NumLibCpp
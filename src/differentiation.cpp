@@ -1,16 +1,391 @@
 #include "NumLibCpp/differentiation.hpp"
-#include <cmath> // Dla std::abs
+#include "NumLibCpp/thread_pool.hpp"
+#include <cmath> // Dla std::abs, std::sqrt, std::cbrt, std::pow
+#include <algorithm> // Dla std::max
+#include <limits>    // Dla std::numeric_limits
 
 namespace NumLibCpp {
 
 double central_difference(std::function<double(double)> func, double x, double h) {
+    return detail::central_difference_impl(func, x, h);
+}
+
+std::vector<std::vector<double>> numerical_jacobian(
+    const std::function<std::vector<double>(const std::vector<double>&)>& func,
+    const std::vector<double>& x,
+    double h) {
+    if (h <= 0.0) {
+        throw std::invalid_argument("Krok h musi byc dodatni.");
+    }
+    if (x.empty()) {
+        throw std::invalid_argument("Wektor x nie moze byc pusty.");
+    }
+
+    const size_t n = x.size();
+    std::vector<std::vector<double>> J;
+    std::vector<double> x_shifted(x);
+
+    for (size_t j = 0; j < n; ++j) {
+        double h_j = h * std::max(1.0, std::abs(x[j]));
+        x_shifted[j] = x[j] + h_j;
+        std::vector<double> f_plus = func(x_shifted);
+        x_shifted[j] = x[j] - h_j;
+        std::vector<double> f_minus = func(x_shifted);
+        x_shifted[j] = x[j];
+
+        if (j == 0) {
+            J.assign(f_plus.size(), std::vector<double>(n));
+        }
+        if (f_plus.size() != J.size() || f_minus.size() != J.size()) {
+            throw std::invalid_argument("Funkcja musi zwracac wektory o stalym rozmiarze.");
+        }
+        // Różnica centralna kolumny j (jak w central_difference)
+        for (size_t i = 0; i < J.size(); ++i) {
+            J[i][j] = (f_plus[i] - f_minus[i]) / (2.0 * h_j);
+        }
+    }
+    return J;
+}
+
+std::vector<std::vector<double>> numerical_jacobian(
+    const std::function<std::vector<double>(const std::vector<double>&)>& func,
+    const std::vector<double>& x,
+    double h,
+    const std::vector<std::vector<int>>& sparsity) {
     if (h <= 0.0) {
         throw std::invalid_argument("Krok h musi byc dodatni.");
     }
-    // Dla bardzo małych h, (x+h) może być równe x numerycznie.
-    // Zabezpieczenie przed tym jest skomplikowane i zależy od precyzji double.
-    // Tutaj zakładamy, że h jest "rozsądnie" małe.
-    return (func(x + h) - func(x - h)) / (2.0 * h);
+    if (x.empty()) {
+        throw std::invalid_argument("Wektor x nie moze byc pusty.");
+    }
+
+    const size_t n = x.size();
+    const size_t m = sparsity.size();
+
+    // Kolumny -> wiersze, w których występują
+    std::vector<std::vector<int>> column_rows(n);
+    for (size_t i = 0; i < m; ++i) {
+        for (int j : sparsity[i]) {
+            if (j < 0 || static_cast<size_t>(j) >= n) {
+                throw std::invalid_argument("Wzorzec rzadkosci zawiera indeks kolumny spoza zakresu.");
+            }
+            column_rows[j].push_back(static_cast<int>(i));
+        }
+    }
+
+    // Zachłanne kolorowanie kolumn: kolumna trafia do pierwszej grupy bez konfliktu w wierszach
+    std::vector<std::vector<int>> groups;
+    std::vector<std::vector<char>> group_rows; // Wiersze zajęte przez grupę
+    for (size_t j = 0; j < n; ++j) {
+        size_t g = 0;
+        for (; g < groups.size(); ++g) {
+            bool conflict = false;
+            for (int row : column_rows[j]) {
+                if (group_rows[g][row]) {
+                    conflict = true;
+                    break;
+                }
+            }
+            if (!conflict) {
+                break;
+            }
+        }
+        if (g == groups.size()) {
+            groups.emplace_back();
+            group_rows.emplace_back(m, 0);
+        }
+        groups[g].push_back(static_cast<int>(j));
+        for (int row : column_rows[j]) {
+            group_rows[g][row] = 1;
+        }
+    }
+
+    std::vector<std::vector<double>> J(m, std::vector<double>(n, 0.0));
+    std::vector<double> x_shifted(x);
+    std::vector<double> steps(n);
+    for (size_t j = 0; j < n; ++j) {
+        steps[j] = h * std::max(1.0, std::abs(x[j]));
+    }
+
+    for (const auto& group : groups) {
+        for (int j : group) x_shifted[j] = x[j] + steps[j];
+        std::vector<double> f_plus = func(x_shifted);
+        for (int j : group) x_shifted[j] = x[j] - steps[j];
+        std::vector<double> f_minus = func(x_shifted);
+        for (int j : group) x_shifted[j] = x[j];
+
+        if (f_plus.size() != m || f_minus.size() != m) {
+            throw std::invalid_argument("Wzorzec rzadkosci musi miec tyle wierszy, ile elementow zwraca funkcja.");
+        }
+        // Każdy wiersz kolumny j należy w tej grupie tylko do kolumny j
+        for (int j : group) {
+            for (int i : column_rows[j]) {
+                J[i][j] = (f_plus[i] - f_minus[i]) / (2.0 * steps[j]);
+            }
+        }
+    }
+    return J;
+}
+
+namespace {
+
+using VectorFunction = std::function<std::vector<double>(const std::vector<double>&)>;
+
+void validate_difference_arguments(const std::vector<double>& x, const DifferenceOptions& options) {
+    if (x.empty()) {
+        throw std::invalid_argument("Wektor x nie moze byc pusty.");
+    }
+    if (options.step < 0.0) {
+        throw std::invalid_argument("Krok h nie moze byc ujemny.");
+    }
+}
+
+// Krok względny równoważący błąd obcięcia schematu rzędu p z błędem zaokrągleń: eps^(1/(p+1))
+double default_relative_step(DifferenceStencil stencil) {
+    const double eps = std::numeric_limits<double>::epsilon();
+    switch (stencil) {
+    case DifferenceStencil::Forward:
+        return std::sqrt(eps);
+    case DifferenceStencil::Central:
+        return std::cbrt(eps);
+    default:
+        return std::pow(eps, 0.2);
+    }
+}
+
+// Krok h_j, dla którego x_j + h_j jest dokładnie reprezentowalne (mianownik bez błędu reprezentacji)
+double representable_step(double x, double relative_step) {
+    const double shifted = x + relative_step * std::max(1.0, std::abs(x));
+    return shifted - x;
+}
+
+std::vector<double> column_steps(const std::vector<double>& x, double relative_step) {
+    std::vector<double> steps(x.size());
+    for (size_t j = 0; j < x.size(); ++j) {
+        steps[j] = representable_step(x[j], relative_step);
+    }
+    return steps;
+}
+
+// Wywołuje body(j) dla j = 0..n-1, w miarę możliwości równolegle
+void for_each_index(size_t n, bool parallel, const std::function<void(size_t)>& body) {
+    if (parallel && n > 1) {
+        ThreadPool::global().parallel_for(0, n, 1, [&](size_t lo, size_t hi) {
+            for (size_t j = lo; j < hi; ++j) body(j);
+        });
+    } else {
+        for (size_t j = 0; j < n; ++j) body(j);
+    }
+}
+
+void check_size(const std::vector<double>& v, size_t m) {
+    if (v.size() != m) {
+        throw std::invalid_argument("Funkcja musi zwracac wektory o stalym rozmiarze.");
+    }
+}
+
+// Kolumna j macierzy Jacobiego wybranym schematem; xs jest roboczą kopią x (przywracaną po obliczeniu)
+std::vector<double> stencil_column(const VectorFunction& func, std::vector<double>& xs, size_t j, double h,
+                                   DifferenceStencil stencil, const std::vector<double>& base) {
+    const double xj = xs[j];
+    auto eval_at = [&](double offset) {
+        xs[j] = xj + offset;
+        std::vector<double> r = func(xs);
+        xs[j] = xj;
+        return r;
+    };
+
+    std::vector<double> column;
+    switch (stencil) {
+    case DifferenceStencil::Forward: {
+        column = eval_at(h);
+        check_size(column, base.size());
+        for (size_t i = 0; i < column.size(); ++i) column[i] = (column[i] - base[i]) / h;
+        break;
+    }
+    case DifferenceStencil::Central: {
+        column = eval_at(h);
+        std::vector<double> minus = eval_at(-h);
+        check_size(minus, column.size());
+        for (size_t i = 0; i < column.size(); ++i) column[i] = (column[i] - minus[i]) / (2.0 * h);
+        break;
+    }
+    case DifferenceStencil::FivePoint: {
+        std::vector<double> p2 = eval_at(2.0 * h), p1 = eval_at(h), m1 = eval_at(-h), m2 = eval_at(-2.0 * h);
+        check_size(p1, p2.size());
+        check_size(m1, p2.size());
+        check_size(m2, p2.size());
+        column.resize(p2.size());
+        for (size_t i = 0; i < column.size(); ++i) {
+            column[i] = (-p2[i] + 8.0 * p1[i] - 8.0 * m1[i] + m2[i]) / (12.0 * h);
+        }
+        break;
+    }
+    case DifferenceStencil::Richardson: {
+        // D(h) = (f(x+h) - f(x-h)) / 2h, wynik (4 D(h/2) - D(h)) / 3 eliminuje składnik O(h^2)
+        std::vector<double> p1 = eval_at(h), m1 = eval_at(-h), p_half = eval_at(0.5 * h), m_half = eval_at(-0.5 * h);
+        check_size(m1, p1.size());
+        check_size(p_half, p1.size());
+        check_size(m_half, p1.size());
+        column.resize(p1.size());
+        for (size_t i = 0; i < column.size(); ++i) {
+            const double d_full = (p1[i] - m1[i]) / (2.0 * h);
+            const double d_half = (p_half[i] - m_half[i]) / h;
+            column[i] = (4.0 * d_half - d_full) / 3.0;
+        }
+        break;
+    }
+    }
+    return column;
+}
+
+// Kolumny jakobianu (kolumna j pod indeksem j)
+std::vector<std::vector<double>> jacobian_columns(const VectorFunction& func, const std::vector<double>& x,
+                                                  const DifferenceOptions& options) {
+    validate_difference_arguments(x, options);
+    const double relative = options.step > 0.0 ? options.step : default_relative_step(options.stencil);
+    const std::vector<double> steps = column_steps(x, relative);
+
+    std::vector<double> base;
+    if (options.stencil == DifferenceStencil::Forward) {
+        base = func(x); // Wspólna wartość F(x) dla wszystkich kolumn
+    }
+
+    std::vector<std::vector<double>> columns(x.size());
+    for_each_index(x.size(), options.parallel, [&](size_t j) {
+        std::vector<double> xs(x);
+        columns[j] = stencil_column(func, xs, j, steps[j], options.stencil, base);
+    });
+    for (const auto& column : columns) {
+        check_size(column, columns[0].size());
+    }
+    return columns;
+}
+
+} // namespace
+
+std::vector<double> numerical_gradient(const std::function<double(const std::vector<double>&)>& func,
+                                       const std::vector<double>& x, const DifferenceOptions& options) {
+    VectorFunction wrapped = [&func](const std::vector<double>& v) { return std::vector<double>{func(v)}; };
+    std::vector<std::vector<double>> columns = jacobian_columns(wrapped, x, options);
+    std::vector<double> grad(x.size());
+    for (size_t j = 0; j < x.size(); ++j) grad[j] = columns[j][0];
+    return grad;
+}
+
+std::vector<std::vector<double>> numerical_jacobian(
+    const std::function<std::vector<double>(const std::vector<double>&)>& func,
+    const std::vector<double>& x,
+    const DifferenceOptions& options) {
+    std::vector<std::vector<double>> columns = jacobian_columns(func, x, options);
+    const size_t m = columns[0].size();
+    std::vector<std::vector<double>> J(m, std::vector<double>(x.size()));
+    for (size_t j = 0; j < x.size(); ++j) {
+        for (size_t i = 0; i < m; ++i) J[i][j] = columns[j][i];
+    }
+    return J;
+}
+
+std::vector<std::vector<double>> numerical_hessian(const std::function<double(const std::vector<double>&)>& func,
+                                                   const std::vector<double>& x, const DifferenceOptions& options) {
+    validate_difference_arguments(x, options);
+    const bool forward = options.stencil == DifferenceStencil::Forward;
+    if (!forward && options.stencil != DifferenceStencil::Central) {
+        throw std::invalid_argument("Hesjan obsluguje tylko schematy Forward i Central.");
+    }
+    const double eps = std::numeric_limits<double>::epsilon();
+    const double relative = options.step > 0.0 ? options.step : (forward ? std::cbrt(eps) : std::pow(eps, 0.25));
+    const std::vector<double> h = column_steps(x, relative);
+    const size_t n = x.size();
+
+    const double f0 = func(x);
+    std::vector<double> f_plus(n, 0.0);
+    if (forward) {
+        // f(x + h_i e_i) - wspólne dla całego wiersza i kolumny i
+        for_each_index(n, options.parallel, [&](size_t i) {
+            std::vector<double> xs(x);
+            xs[i] += h[i];
+            f_plus[i] = func(xs);
+        });
+    }
+
+    std::vector<std::vector<double>> H(n, std::vector<double>(n, 0.0));
+    for_each_index(n, options.parallel, [&](size_t i) {
+        std::vector<double> xs(x);
+        for (size_t j = 0; j <= i; ++j) {
+            double value;
+            if (forward) {
+                xs[i] += h[i];
+                xs[j] += h[j];
+                value = (func(xs) - f_plus[i] - f_plus[j] + f0) / (h[i] * h[j]);
+            } else if (i == j) {
+                xs[i] = x[i] + h[i];
+                const double fp = func(xs);
+                xs[i] = x[i] - h[i];
+                const double fm = func(xs);
+                value = (fp - 2.0 * f0 + fm) / (h[i] * h[i]);
+            } else {
+                double sum = 0.0;
+                for (int si = -1; si <= 1; si += 2) {
+                    for (int sj = -1; sj <= 1; sj += 2) {
+                        xs[i] = x[i] + si * h[i];
+                        xs[j] = x[j] + sj * h[j];
+                        sum += si * sj * func(xs);
+                    }
+                }
+                value = sum / (4.0 * h[i] * h[j]);
+            }
+            xs[i] = x[i];
+            xs[j] = x[j];
+            H[i][j] = value;
+            H[j][i] = value; // Wiersz i zapisuje tylko kolumnę i powyżej diagonali - bez konfliktów między zadaniami
+        }
+    });
+    return H;
+}
+
+namespace {
+constexpr double complex_step_size = 1e-20;
+} // namespace
+
+std::vector<double> complex_step_gradient(
+    const std::function<std::complex<double>(const std::vector<std::complex<double>>&)>& func,
+    const std::vector<double>& x, bool parallel) {
+    if (x.empty()) {
+        throw std::invalid_argument("Wektor x nie moze byc pusty.");
+    }
+    std::vector<double> grad(x.size());
+    for_each_index(x.size(), parallel, [&](size_t j) {
+        std::vector<std::complex<double>> z(x.begin(), x.end());
+        z[j] += std::complex<double>(0.0, complex_step_size);
+        grad[j] = func(z).imag() / complex_step_size;
+    });
+    return grad;
+}
+
+std::vector<std::vector<double>> complex_step_jacobian(
+    const std::function<std::vector<std::complex<double>>(const std::vector<std::complex<double>>&)>& func,
+    const std::vector<double>& x, bool parallel) {
+    if (x.empty()) {
+        throw std::invalid_argument("Wektor x nie moze byc pusty.");
+    }
+    const size_t n = x.size();
+    std::vector<std::vector<std::complex<double>>> columns(n);
+    for_each_index(n, parallel, [&](size_t j) {
+        std::vector<std::complex<double>> z(x.begin(), x.end());
+        z[j] += std::complex<double>(0.0, complex_step_size);
+        columns[j] = func(z);
+    });
+
+    const size_t m = columns[0].size();
+    std::vector<std::vector<double>> J(m, std::vector<double>(n));
+    for (size_t j = 0; j < n; ++j) {
+        if (columns[j].size() != m) {
+            throw std::invalid_argument("Funkcja musi zwracac wektory o stalym rozmiarze.");
+        }
+        for (size_t i = 0; i < m; ++i) J[i][j] = columns[j][i].imag() / complex_step_size;
+    }
+    return J;
 }
 
-} // namespace NumLibCpp
\ No newline at end of file
+} // namespace NumLibCpp
@@ -0,0 +1,535 @@
+#include "NumLibCpp/eigen_solver.hpp"
+#include <algorithm> // Dla std::sort, std::max, std::min
+#include <cmath>     // Dla std::abs, std::sqrt, std::hypot
+#include <limits>    // Dla std::numeric_limits
+#include <numeric>   // Dla std::iota
+
+namespace NumLibCpp {
+
+namespace {
+
+constexpr int max_qr_iterations = 60; // Na jedną wartość własną
+
+void validate_square(const std::vector<std::vector<double>>& A) {
+    if (A.empty()) {
+        throw std::invalid_argument("Macierz A nie moze byc pusta.");
+    }
+    for (const auto& row : A) {
+        if (row.size() != A.size()) {
+            throw std::invalid_argument("Macierz A musi byc kwadratowa.");
+        }
+    }
+}
+
+bool complex_less(const std::complex<double>& a, const std::complex<double>& b) {
+    if (a.real() != b.real()) return a.real() < b.real();
+    return a.imag() < b.imag();
+}
+
+// Redukcja Householdera macierzy symetrycznej V (n x n, wierszami) do postaci trójdiagonalnej.
+// Po wyjściu d - diagonala, e[1..n-1] - poddiagonala, V - macierz przekształcenia ortogonalnego.
+void householder_tridiagonalize(int n, std::vector<double>& V, std::vector<double>& d, std::vector<double>& e) {
+    auto at = [&V, n](int i, int j) -> double& { return V[static_cast<size_t>(i) * n + j]; };
+
+    for (int j = 0; j < n; ++j) d[j] = at(n - 1, j);
+
+    for (int i = n - 1; i > 0; --i) {
+        double scale = 0.0;
+        double h = 0.0;
+        for (int k = 0; k < i; ++k) scale += std::abs(d[k]);
+
+        if (scale == 0.0) {
+            e[i] = d[i - 1];
+            for (int j = 0; j < i; ++j) {
+                d[j] = at(i - 1, j);
+                at(i, j) = 0.0;
+                at(j, i) = 0.0;
+            }
+        } else {
+            // Wektor Householdera ze skalowanego wiersza i
+            for (int k = 0; k < i; ++k) {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            double f = d[i - 1];
+            double g = std::sqrt(h);
+            if (f > 0.0) g = -g;
+            e[i] = scale * g;
+            h -= f * g;
+            d[i - 1] = f - g;
+            for (int j = 0; j < i; ++j) e[j] = 0.0;
+
+            // Przekształcenie podobieństwa pozostałej części macierzy
+            for (int j = 0; j < i; ++j) {
+                f = d[j];
+                at(j, i) = f;
+                g = e[j] + at(j, j) * f;
+                for (int k = j + 1; k <= i - 1; ++k) {
+                    g += at(k, j) * d[k];
+                    e[k] += at(k, j) * f;
+                }
+                e[j] = g;
+            }
+            f = 0.0;
+            for (int j = 0; j < i; ++j) {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            const double hh = f / (h + h);
+            for (int j = 0; j < i; ++j) e[j] -= hh * d[j];
+            for (int j = 0; j < i; ++j) {
+                f = d[j];
+                g = e[j];
+                for (int k = j; k <= i - 1; ++k) {
+                    at(k, j) -= (f * e[k] + g * d[k]);
+                }
+                d[j] = at(i - 1, j);
+                at(i, j) = 0.0;
+            }
+        }
+        d[i] = h;
+    }
+
+    // Akumulacja przekształceń
+    for (int i = 0; i < n - 1; ++i) {
+        at(n - 1, i) = at(i, i);
+        at(i, i) = 1.0;
+        const double h = d[i + 1];
+        if (h != 0.0) {
+            for (int k = 0; k <= i; ++k) d[k] = at(k, i + 1) / h;
+            for (int j = 0; j <= i; ++j) {
+                double g = 0.0;
+                for (int k = 0; k <= i; ++k) g += at(k, i + 1) * at(k, j);
+                for (int k = 0; k <= i; ++k) at(k, j) -= g * d[k];
+            }
+        }
+        for (int k = 0; k <= i; ++k) at(k, i + 1) = 0.0;
+    }
+    for (int j = 0; j < n; ++j) {
+        d[j] = at(n - 1, j);
+        at(n - 1, j) = 0.0;
+    }
+    at(n - 1, n - 1) = 1.0;
+    e[0] = 0.0;
+}
+
+// Niejawna metoda QL dla macierzy trójdiagonalnej (d, e). Obroty są stosowane do wierszy W
+// (W - transpozycja macierzy przekształcenia, wiersze to wektory własne); W pusty - tylko wartości.
+void tridiagonal_ql(int n, std::vector<double>& d, std::vector<double>& e, std::vector<double>& W) {
+    const bool vectors = !W.empty();
+    for (int i = 1; i < n; ++i) e[i - 1] = e[i];
+    e[n - 1] = 0.0;
+
+    const double eps = std::numeric_limits<double>::epsilon();
+    double f = 0.0;
+    double tst1 = 0.0;
+    for (int l = 0; l < n; ++l) {
+        tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+        int m = l;
+        while (m < n - 1 && std::abs(e[m]) > eps * tst1) ++m;
+
+        if (m > l) {
+            int iter = 0;
+            do {
+                if (++iter > max_qr_iterations) {
+                    throw std::runtime_error("Metoda QL nie zbiegla w maksymalnej liczbie iteracji.");
+                }
+                // Przesunięcie Wilkinsona
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2.0 * e[l]);
+                double r = std::hypot(p, 1.0);
+                if (p < 0.0) r = -r;
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                const double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (int i = l + 2; i < n; ++i) d[i] -= h;
+                f += h;
+
+                // Obroty Givensa od dołu bloku
+                p = d[m];
+                double c = 1.0, c2 = 1.0, c3 = 1.0;
+                const double el1 = e[l + 1];
+                double s = 0.0, s2 = 0.0;
+                for (int i = m - 1; i >= l; --i) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+                    if (vectors) {
+                        double* wi = W.data() + static_cast<size_t>(i) * n;
+                        double* wi1 = wi + n;
+                        for (int k = 0; k < n; ++k) {
+                            const double t = wi1[k];
+                            wi1[k] = s * wi[k] + c * t;
+                            wi[k] = c * wi[k] - s * t;
+                        }
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while (std::abs(e[l]) > eps * tst1);
+        }
+        d[l] += f;
+        e[l] = 0.0;
+    }
+}
+
+// Równoważenie macierzy (n x n, wierszami) skalowaniem wierszy i kolumn potęgami 2.
+void balance(int n, std::vector<double>& H) {
+    const double radix = 2.0;
+    const double radix2 = radix * radix;
+    bool done = false;
+    while (!done) {
+        done = true;
+        for (int i = 0; i < n; ++i) {
+            double r = 0.0, c = 0.0;
+            for (int j = 0; j < n; ++j) {
+                if (j != i) {
+                    c += std::abs(H[static_cast<size_t>(j) * n + i]);
+                    r += std::abs(H[static_cast<size_t>(i) * n + j]);
+                }
+            }
+            if (c == 0.0 || r == 0.0) continue;
+            double g = r / radix;
+            double f = 1.0;
+            const double s = c + r;
+            while (c < g) {
+                f *= radix;
+                c *= radix2;
+            }
+            g = r * radix;
+            while (c > g) {
+                f /= radix;
+                c /= radix2;
+            }
+            if ((c + r) / f < 0.95 * s) {
+                done = false;
+                g = 1.0 / f;
+                for (int j = 0; j < n; ++j) H[static_cast<size_t>(i) * n + j] *= g;
+                for (int j = 0; j < n; ++j) H[static_cast<size_t>(j) * n + i] *= f;
+            }
+        }
+    }
+}
+
+// Redukcja do postaci Hessenberga odbiciami Householdera.
+void hessenberg_reduce(int n, std::vector<double>& H) {
+    auto at = [&H, n](int i, int j) -> double& { return H[static_cast<size_t>(i) * n + j]; };
+    std::vector<double> ort(n);
+    const int high = n - 1;
+
+    for (int m = 1; m <= high - 1; ++m) {
+        double scale = 0.0;
+        for (int i = m; i <= high; ++i) scale += std::abs(at(i, m - 1));
+        if (scale == 0.0) continue;
+
+        double h = 0.0;
+        for (int i = high; i >= m; --i) {
+            ort[i] = at(i, m - 1) / scale;
+            h += ort[i] * ort[i];
+        }
+        double g = std::sqrt(h);
+        if (ort[m] > 0.0) g = -g;
+        h -= ort[m] * g;
+        ort[m] -= g;
+
+        // H = (I - u u^T / h) H (I - u u^T / h)
+        for (int j = m; j < n; ++j) {
+            double f = 0.0;
+            for (int i = high; i >= m; --i) f += ort[i] * at(i, j);
+            f /= h;
+            for (int i = m; i <= high; ++i) at(i, j) -= f * ort[i];
+        }
+        for (int i = 0; i <= high; ++i) {
+            double f = 0.0;
+            for (int j = high; j >= m; --j) f += ort[j] * at(i, j);
+            f /= h;
+            for (int j = m; j <= high; ++j) at(i, j) -= f * ort[j];
+        }
+        at(m, m - 1) = scale * g;
+        for (int i = m + 1; i <= high; ++i) at(i, m - 1) = 0.0;
+    }
+}
+
+// Podwójnie przesunięta metoda QR Francisa dla macierzy Hessenberga (tylko wartości własne).
+std::vector<std::complex<double>> hessenberg_qr(int nn, std::vector<double>& H) {
+    auto at = [&H, nn](int i, int j) -> double& { return H[static_cast<size_t>(i) * nn + j]; };
+    std::vector<std::complex<double>> eigenvalues(nn);
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    double norm = 0.0;
+    for (int i = 0; i < nn; ++i) {
+        for (int j = std::max(i - 1, 0); j < nn; ++j) norm += std::abs(at(i, j));
+    }
+
+    int n = nn - 1;
+    const int low = 0;
+    double exshift = 0.0;
+    double p = 0.0, q = 0.0, r = 0.0, s = 0.0, z = 0.0, w, x, y;
+    int iter = 0;
+
+    while (n >= low) {
+        // Szukanie małego elementu poddiagonalnego
+        int l = n;
+        while (l > low) {
+            s = std::abs(at(l - 1, l - 1)) + std::abs(at(l, l));
+            if (s == 0.0) s = norm;
+            if (std::abs(at(l, l - 1)) < eps * s) break;
+            --l;
+        }
+
+        if (l == n) {
+            // Jedna wartość własna
+            eigenvalues[n] = at(n, n) + exshift;
+            --n;
+            iter = 0;
+        } else if (l == n - 1) {
+            // Blok 2x2: para rzeczywista lub sprzężona
+            w = at(n, n - 1) * at(n - 1, n);
+            p = (at(n - 1, n - 1) - at(n, n)) / 2.0;
+            q = p * p + w;
+            z = std::sqrt(std::abs(q));
+            x = at(n, n) + exshift;
+            if (q >= 0.0) {
+                z = (p >= 0.0) ? p + z : p - z;
+                eigenvalues[n - 1] = x + z;
+                eigenvalues[n] = (z != 0.0) ? x - w / z : x + z;
+            } else {
+                eigenvalues[n - 1] = std::complex<double>(x + p, z);
+                eigenvalues[n] = std::complex<double>(x + p, -z);
+            }
+            n -= 2;
+            iter = 0;
+        } else {
+            x = at(n, n);
+            y = at(n - 1, n - 1);
+            w = at(n, n - 1) * at(n - 1, n);
+
+            // Przesunięcia awaryjne przy powolnej zbieżności
+            if (iter == 10) {
+                exshift += x;
+                for (int i = low; i <= n; ++i) at(i, i) -= x;
+                s = std::abs(at(n, n - 1)) + std::abs(at(n - 1, n - 2));
+                x = y = 0.75 * s;
+                w = -0.4375 * s * s;
+            }
+            if (iter == 30) {
+                s = (y - x) / 2.0;
+                s = s * s + w;
+                if (s > 0.0) {
+                    s = std::sqrt(s);
+                    if (y < x) s = -s;
+                    s = x - w / ((y - x) / 2.0 + s);
+                    for (int i = low; i <= n; ++i) at(i, i) -= s;
+                    exshift += s;
+                    x = y = w = 0.964;
+                }
+            }
+            if (++iter > max_qr_iterations) {
+                throw std::runtime_error("Metoda QR nie zbiegla w maksymalnej liczbie iteracji.");
+            }
+
+            // Szukanie dwóch kolejnych małych elementów poddiagonalnych
+            int m = n - 2;
+            while (m >= l) {
+                z = at(m, m);
+                r = x - z;
+                s = y - z;
+                p = (r * s - w) / at(m + 1, m) + at(m, m + 1);
+                q = at(m + 1, m + 1) - z - r - s;
+                r = at(m + 2, m + 1);
+                s = std::abs(p) + std::abs(q) + std::abs(r);
+                p /= s;
+                q /= s;
+                r /= s;
+                if (m == l) break;
+                if (std::abs(at(m, m - 1)) * (std::abs(q) + std::abs(r)) <
+                    eps * (std::abs(p) * (std::abs(at(m - 1, m - 1)) + std::abs(z) + std::abs(at(m + 1, m + 1))))) {
+                    break;
+                }
+                --m;
+            }
+            for (int i = m + 2; i <= n; ++i) {
+                at(i, i - 2) = 0.0;
+                if (i > m + 2) at(i, i - 3) = 0.0;
+            }
+
+            // Podwójny krok QR na wierszach l..n i kolumnach m..n
+            for (int k = m; k <= n - 1; ++k) {
+                const bool notlast = (k != n - 1);
+                if (k != m) {
+                    p = at(k, k - 1);
+                    q = at(k + 1, k - 1);
+                    r = notlast ? at(k + 2, k - 1) : 0.0;
+                    x = std::abs(p) + std::abs(q) + std::abs(r);
+                    if (x == 0.0) continue;
+                    p /= x;
+                    q /= x;
+                    r /= x;
+                }
+                s = std::sqrt(p * p + q * q + r * r);
+                if (p < 0.0) s = -s;
+                if (s == 0.0) continue;
+
+                if (k != m) {
+                    at(k, k - 1) = -s * x;
+                } else if (l != m) {
+                    at(k, k - 1) = -at(k, k - 1);
+                }
+                p += s;
+                x = p / s;
+                y = q / s;
+                z = r / s;
+                q /= p;
+                r /= p;
+
+                for (int j = k; j <= n; ++j) {
+                    p = at(k, j) + q * at(k + 1, j);
+                    if (notlast) {
+                        p += r * at(k + 2, j);
+                        at(k + 2, j) -= p * z;
+                    }
+                    at(k, j) -= p * x;
+                    at(k + 1, j) -= p * y;
+                }
+                for (int i = l; i <= std::min(n, k + 3); ++i) {
+                    p = x * at(i, k) + y * at(i, k + 1);
+                    if (notlast) {
+                        p += z * at(i, k + 2);
+                        at(i, k + 2) -= p * r;
+                    }
+                    at(i, k) -= p;
+                    at(i, k + 1) -= p * q;
+                }
+            }
+        }
+    }
+    return eigenvalues;
+}
+
+} // namespace
+
+SymmetricEigenResult symmetric_eigen(const std::vector<std::vector<double>>& A, bool compute_vectors) {
+    validate_square(A);
+    const int n = static_cast<int>(A.size());
+
+    // Kopia trójkąta dolnego w ciągłej tablicy
+    std::vector<double> V(static_cast<size_t>(n) * n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            V[static_cast<size_t>(i) * n + j] = A[i][j];
+            V[static_cast<size_t>(j) * n + i] = A[i][j];
+        }
+    }
+
+    std::vector<double> d(n), e(n);
+    householder_tridiagonalize(n, V, d, e);
+
+    std::vector<double> W;
+    if (compute_vectors) {
+        W.resize(V.size());
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                W[static_cast<size_t>(j) * n + i] = V[static_cast<size_t>(i) * n + j];
+            }
+        }
+    }
+    tridiagonal_ql(n, d, e, W);
+
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&d](int a, int b) { return d[a] < d[b]; });
+
+    SymmetricEigenResult result;
+    result.n = n;
+    result.values.resize(n);
+    if (compute_vectors) result.vectors.resize(W.size());
+    for (int k = 0; k < n; ++k) {
+        result.values[k] = d[order[k]];
+        if (compute_vectors) {
+            std::copy_n(W.begin() + static_cast<size_t>(order[k]) * n, n,
+                        result.vectors.begin() + static_cast<size_t>(k) * n);
+        }
+    }
+    return result;
+}
+
+std::vector<std::complex<double>> general_eigenvalues(const std::vector<std::vector<double>>& A) {
+    validate_square(A);
+    const int n = static_cast<int>(A.size());
+
+    std::vector<double> H(static_cast<size_t>(n) * n);
+    for (int i = 0; i < n; ++i) {
+        std::copy(A[i].begin(), A[i].end(), H.begin() + static_cast<size_t>(i) * n);
+    }
+    balance(n, H);
+    hessenberg_reduce(n, H);
+    std::vector<std::complex<double>> values = hessenberg_qr(n, H);
+    std::sort(values.begin(), values.end(), complex_less);
+    return values;
+}
+
+std::vector<std::complex<double>> polynomial_roots(const std::vector<double>& coeffs, bool polish) {
+    if (coeffs.empty()) {
+        throw std::invalid_argument("Wektor wspolczynnikow nie moze byc pusty.");
+    }
+    int degree = static_cast<int>(coeffs.size()) - 1;
+    while (degree >= 0 && coeffs[degree] == 0.0) --degree;
+    if (degree < 0) {
+        throw std::invalid_argument("Wszystkie wspolczynniki wielomianu sa zerowe.");
+    }
+    if (degree == 0) {
+        return {};
+    }
+
+    // Macierz stowarzyszona w postaci Hessenberga: pierwszy wiersz -c_{n-1}/c_n, ..., -c_0/c_n
+    const int n = degree;
+    std::vector<double> H(static_cast<size_t>(n) * n, 0.0);
+    for (int j = 0; j < n; ++j) {
+        H[j] = -coeffs[n - 1 - j] / coeffs[n];
+    }
+    for (int i = 1; i < n; ++i) {
+        H[static_cast<size_t>(i) * n + i - 1] = 1.0;
+    }
+    balance(n, H);
+    std::vector<std::complex<double>> roots = hessenberg_qr(n, H);
+
+    if (polish) {
+        for (auto& root : roots) {
+            // Schemat Hornera dla P i P'
+            auto evaluate = [&](std::complex<double> z, std::complex<double>& dp) {
+                std::complex<double> p = coeffs[n];
+                dp = 0.0;
+                for (int k = n - 1; k >= 0; --k) {
+                    dp = dp * z + p;
+                    p = p * z + coeffs[k];
+                }
+                return p;
+            };
+            std::complex<double> dp;
+            std::complex<double> p = evaluate(root, dp);
+            for (int iter = 0; iter < 3 && dp != 0.0 && p != 0.0; ++iter) {
+                const std::complex<double> candidate = root - p / dp;
+                std::complex<double> dp_candidate;
+                const std::complex<double> p_candidate = evaluate(candidate, dp_candidate);
+                if (!(std::abs(p_candidate) < std::abs(p))) break;
+                root = candidate;
+                p = p_candidate;
+                dp = dp_candidate;
+            }
+        }
+    }
+    std::sort(roots.begin(), roots.end(), complex_less);
+    return roots;
+}
+
+} // namespace NumLibCpp
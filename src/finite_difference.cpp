@@ -0,0 +1,315 @@
+#include "NumLibCpp/finite_difference.hpp"
+#include "NumLibCpp/thread_pool.hpp"
+#include <algorithm> // Dla std::min, std::max, std::copy_n
+#include <cmath>     // Dla std::pow
+
+namespace NumLibCpp {
+
+namespace {
+// Liczba punktów przetwarzanych jedną pętlą (dane szablonu mieszczą się w L1)
+constexpr std::size_t row_tile = 1024;
+// Liczba sąsiednich linii przetwarzanych razem przy pochodnej wzdłuż osi o dużym kroku pamięci
+constexpr std::size_t line_tile = 256;
+// Minimalna liczba elementów na zadanie puli wątków
+constexpr std::size_t min_task_elements = 16384;
+
+void validate_orders(int derivative, int accuracy) {
+    if (derivative < 1) {
+        throw std::invalid_argument("Rzad pochodnej musi byc co najmniej 1.");
+    }
+    if (accuracy < 2 || accuracy % 2 != 0) {
+        throw std::invalid_argument("Rzad dokladnosci musi byc parzysty i co najmniej 2.");
+    }
+}
+} // namespace
+
+std::vector<double> fornberg_weights(double x0, const std::vector<double>& nodes, int derivative) {
+    if (derivative < 0) {
+        throw std::invalid_argument("Rzad pochodnej nie moze byc ujemny.");
+    }
+    const std::size_t n = nodes.size();
+    const std::size_t M = static_cast<std::size_t>(derivative);
+    if (n < M + 1) {
+        throw std::invalid_argument("Liczba wezlow musi byc wieksza od rzedu pochodnej.");
+    }
+
+    // c[j * (M + 1) + k] - waga węzła j dla pochodnej rzędu k
+    std::vector<double> c(n * (M + 1), 0.0);
+    auto at = [&c, M](std::size_t j, std::size_t k) -> double& { return c[j * (M + 1) + k]; };
+    double c1 = 1.0;
+    double c4 = nodes[0] - x0;
+    at(0, 0) = 1.0;
+    for (std::size_t i = 1; i < n; ++i) {
+        const std::size_t mn = std::min(i, M);
+        double c2 = 1.0;
+        const double c5 = c4;
+        c4 = nodes[i] - x0;
+        for (std::size_t j = 0; j < i; ++j) {
+            const double c3 = nodes[i] - nodes[j];
+            c2 *= c3;
+            if (j == i - 1) {
+                for (std::size_t k = mn; k >= 1; --k) {
+                    at(i, k) = c1 * (static_cast<double>(k) * at(i - 1, k - 1) - c5 * at(i - 1, k)) / c2;
+                }
+                at(i, 0) = -c1 * c5 * at(i - 1, 0) / c2;
+            }
+            for (std::size_t k = mn; k >= 1; --k) {
+                at(j, k) = (c4 * at(j, k) - static_cast<double>(k) * at(j, k - 1)) / c3;
+            }
+            at(j, 0) = c4 * at(j, 0) / c3;
+        }
+        c1 = c2;
+    }
+
+    std::vector<double> weights(n);
+    for (std::size_t j = 0; j < n; ++j) weights[j] = at(j, M);
+    return weights;
+}
+
+FiniteDifferenceStencil::FiniteDifferenceStencil(std::size_t n, double dx, int derivative, int accuracy) : n_(n) {
+    validate_orders(derivative, accuracy);
+    if (dx <= 0.0) {
+        throw std::invalid_argument("Krok siatki dx musi byc dodatni.");
+    }
+    // Szablon centralny: 2*floor((m+1)/2) - 1 + p węzłów; brzegowy: m + p węzłów
+    interior_points_ = static_cast<std::size_t>(2 * ((derivative + 1) / 2) - 1 + accuracy);
+    boundary_points_ = static_cast<std::size_t>(derivative + accuracy);
+    if (n < std::max(interior_points_, boundary_points_)) {
+        throw std::invalid_argument("Liczba wezlow siatki jest mniejsza od liczby wezlow szablonu.");
+    }
+    const std::size_t half = (interior_points_ - 1) / 2;
+    interior_offset_ = half;
+    interior_begin_ = half;
+    interior_end_ = n - half;
+
+    const double scale = 1.0 / std::pow(dx, derivative);
+    std::vector<double> offsets(interior_points_);
+    for (std::size_t k = 0; k < interior_points_; ++k) {
+        offsets[k] = static_cast<double>(k) - static_cast<double>(half);
+    }
+    uniform_weights_ = fornberg_weights(0.0, offsets, derivative);
+    for (double& w : uniform_weights_) w *= scale;
+
+    // Szablony brzegowe na siatce o jednostkowym kroku, przeskalowane przez dx^-m
+    std::vector<double> unit_grid(n);
+    for (std::size_t i = 0; i < n; ++i) unit_grid[i] = static_cast<double>(i);
+    build_boundary(unit_grid, derivative, scale);
+}
+
+FiniteDifferenceStencil::FiniteDifferenceStencil(const std::vector<double>& x, int derivative, int accuracy)
+    : n_(x.size()) {
+    validate_orders(derivative, accuracy);
+    for (std::size_t i = 1; i < x.size(); ++i) {
+        if (!(x[i] > x[i - 1])) {
+            throw std::invalid_argument("Wezly siatki musza byc scisle rosnace.");
+        }
+    }
+    // Na siatce nierównomiernej m + p węzłów daje rząd p; szablon jest możliwie wyśrodkowany
+    interior_points_ = static_cast<std::size_t>(derivative + accuracy);
+    boundary_points_ = interior_points_;
+    if (n_ < interior_points_) {
+        throw std::invalid_argument("Liczba wezlow siatki jest mniejsza od liczby wezlow szablonu.");
+    }
+    interior_offset_ = (interior_points_ - 1) / 2;
+    interior_begin_ = interior_offset_;
+    interior_end_ = n_ - interior_points_ + interior_offset_ + 1;
+
+    const std::size_t count = interior_end_ - interior_begin_;
+    interior_table_.resize(interior_points_ * count);
+    std::vector<double> nodes(interior_points_);
+    for (std::size_t i = interior_begin_; i < interior_end_; ++i) {
+        std::copy_n(x.begin() + static_cast<std::ptrdiff_t>(i - interior_offset_), interior_points_, nodes.begin());
+        std::vector<double> w = fornberg_weights(x[i], nodes, derivative);
+        for (std::size_t k = 0; k < interior_points_; ++k) {
+            interior_table_[k * count + (i - interior_begin_)] = w[k];
+        }
+    }
+    build_boundary(x, derivative, 1.0);
+}
+
+void FiniteDifferenceStencil::build_boundary(const std::vector<double>& x, int derivative, double scale) {
+    std::vector<double> nodes(boundary_points_);
+    for (std::size_t i = 0; i < n_; ++i) {
+        if (i >= interior_begin_ && i < interior_end_) {
+            continue;
+        }
+        const std::size_t start = i < interior_begin_ ? 0 : n_ - boundary_points_;
+        std::copy_n(x.begin() + static_cast<std::ptrdiff_t>(start), boundary_points_, nodes.begin());
+        std::vector<double> w = fornberg_weights(x[i], nodes, derivative);
+        boundary_index_.push_back(i);
+        boundary_start_.push_back(start);
+        for (double wk : w) boundary_weights_.push_back(wk * scale);
+    }
+}
+
+void FiniteDifferenceStencil::apply_row(const double* f, double* out) const {
+    for (std::size_t b = 0; b < boundary_index_.size(); ++b) {
+        const double* w = boundary_weights_.data() + b * boundary_points_;
+        const double* src = f + boundary_start_[b];
+        double sum = 0.0;
+        for (std::size_t k = 0; k < boundary_points_; ++k) sum += w[k] * src[k];
+        out[boundary_index_[b]] = sum;
+    }
+
+    const std::size_t count = interior_end_ - interior_begin_;
+    for (std::size_t i0 = interior_begin_; i0 < interior_end_; i0 += row_tile) {
+        const std::size_t i1 = std::min(i0 + row_tile, interior_end_);
+        const double* src = f + (i0 - interior_offset_);
+        double* dst = out + i0;
+        const std::size_t len = i1 - i0;
+        if (!uniform_weights_.empty()) {
+            const double w0 = uniform_weights_[0];
+            for (std::size_t i = 0; i < len; ++i) dst[i] = w0 * src[i];
+            for (std::size_t k = 1; k < interior_points_; ++k) {
+                const double wk = uniform_weights_[k];
+                const double* s = src + k;
+                for (std::size_t i = 0; i < len; ++i) dst[i] += wk * s[i];
+            }
+        } else {
+            const double* w0 = interior_table_.data() + (i0 - interior_begin_);
+            for (std::size_t i = 0; i < len; ++i) dst[i] = w0[i] * src[i];
+            for (std::size_t k = 1; k < interior_points_; ++k) {
+                const double* wk = w0 + k * count;
+                const double* s = src + k;
+                for (std::size_t i = 0; i < len; ++i) dst[i] += wk[i] * s[i];
+            }
+        }
+    }
+}
+
+void FiniteDifferenceStencil::apply(const double* f, double* out) const {
+    if (f == out) {
+        thread_local std::vector<double> scratch;
+        scratch.assign(f, f + n_);
+        apply_row(scratch.data(), out);
+    } else {
+        apply_row(f, out);
+    }
+}
+
+std::vector<double> FiniteDifferenceStencil::apply(const std::vector<double>& f) const {
+    if (f.size() != n_) {
+        throw std::invalid_argument("Rozmiar tablicy f musi byc rowny liczbie wezlow siatki.");
+    }
+    std::vector<double> out(n_);
+    apply_row(f.data(), out.data());
+    return out;
+}
+
+void FiniteDifferenceStencil::apply_lines(const double* f, std::size_t f_stride, double* out,
+                                          std::size_t out_stride, std::size_t width) const {
+    // Wiersz wyniku i: o[t] = sum_k w_k * f[(start + k) * f_stride + t] dla ciągłego zakresu t
+    for (std::size_t b = 0; b < boundary_index_.size(); ++b) {
+        const double* w = boundary_weights_.data() + b * boundary_points_;
+        double* o = out + boundary_index_[b] * out_stride;
+        const double* line = f + boundary_start_[b] * f_stride;
+        for (std::size_t t = 0; t < width; ++t) o[t] = w[0] * line[t];
+        for (std::size_t k = 1; k < boundary_points_; ++k) {
+            const double wk = w[k];
+            const double* lk = line + k * f_stride;
+            for (std::size_t t = 0; t < width; ++t) o[t] += wk * lk[t];
+        }
+    }
+
+    const std::size_t count = interior_end_ - interior_begin_;
+    for (std::size_t i = interior_begin_; i < interior_end_; ++i) {
+        double* o = out + i * out_stride;
+        const double* line = f + (i - interior_offset_) * f_stride;
+        auto weight = [&](std::size_t k) {
+            return uniform_weights_.empty() ? interior_table_[k * count + (i - interior_begin_)] : uniform_weights_[k];
+        };
+        const double w0 = weight(0);
+        for (std::size_t t = 0; t < width; ++t) o[t] = w0 * line[t];
+        for (std::size_t k = 1; k < interior_points_; ++k) {
+            const double wk = weight(k);
+            const double* lk = line + k * f_stride;
+            for (std::size_t t = 0; t < width; ++t) o[t] += wk * lk[t];
+        }
+    }
+}
+
+std::vector<double> grid_derivative(const std::vector<double>& f, double dx, int derivative, int accuracy) {
+    return FiniteDifferenceStencil(f.size(), dx, derivative, accuracy).apply(f);
+}
+
+std::vector<double> grid_derivative(const std::vector<double>& f, const std::vector<double>& x, int derivative,
+                                    int accuracy) {
+    if (f.size() != x.size()) {
+        throw std::invalid_argument("Rozmiary f i x musza byc rowne.");
+    }
+    return FiniteDifferenceStencil(x, derivative, accuracy).apply(f);
+}
+
+namespace {
+
+// Pochodna wzdłuż osi tablicy o kształcie (outer, n, inner), gdzie n = długość osi
+void apply_axis(const FiniteDifferenceStencil& stencil, const double* f, double* out,
+                std::size_t outer, std::size_t n, std::size_t inner) {
+    if (stencil.size() != n) {
+        throw std::invalid_argument("Rozmiar operatora roznicowego nie odpowiada dlugosci osi.");
+    }
+
+    if (inner == 1) {
+        // Oś ciągła w pamięci: każdy wiersz jak tablica 1-D
+        const std::size_t grain = std::max<std::size_t>(1, min_task_elements / n);
+        ThreadPool::global().parallel_for(0, outer, grain, [&](std::size_t lo, std::size_t hi) {
+            for (std::size_t r = lo; r < hi; ++r) {
+                stencil.apply(f + r * n, out + r * n);
+            }
+        });
+        return;
+    }
+
+    // Oś o kroku inner: paczki line_tile sąsiednich linii, pętla wewnętrzna po ciągłej pamięci
+    const std::size_t tile = std::min(line_tile, inner);
+    const std::size_t tiles = (inner + tile - 1) / tile;
+    const std::size_t grain = std::max<std::size_t>(1, min_task_elements / (n * tile));
+    ThreadPool::global().parallel_for(0, outer * tiles, grain, [&](std::size_t lo, std::size_t hi) {
+        std::vector<double> scratch;
+        for (std::size_t u = lo; u < hi; ++u) {
+            const std::size_t block = u / tiles;
+            const std::size_t t0 = (u % tiles) * tile;
+            const std::size_t width = std::min(tile, inner - t0);
+            const double* src = f + block * n * inner + t0;
+            double* dst = out + block * n * inner + t0;
+            if (f == out) {
+                // W miejscu: kopia paczki linii, wynik zapisywany bezpośrednio do tablicy
+                scratch.resize(n * width);
+                for (std::size_t i = 0; i < n; ++i) {
+                    std::copy_n(src + i * inner, width, scratch.data() + i * width);
+                }
+                stencil.apply_lines(scratch.data(), width, dst, inner, width);
+            } else {
+                stencil.apply_lines(src, inner, dst, inner, width);
+            }
+        }
+    });
+}
+
+} // namespace
+
+void grid_derivative_2d(const FiniteDifferenceStencil& stencil, const double* f, double* out,
+                        std::size_t nx, std::size_t ny, int axis) {
+    if (axis == 0) {
+        apply_axis(stencil, f, out, ny, nx, 1);
+    } else if (axis == 1) {
+        apply_axis(stencil, f, out, 1, ny, nx);
+    } else {
+        throw std::invalid_argument("Os musi byc rowna 0 lub 1.");
+    }
+}
+
+void grid_derivative_3d(const FiniteDifferenceStencil& stencil, const double* f, double* out,
+                        std::size_t nx, std::size_t ny, std::size_t nz, int axis) {
+    if (axis == 0) {
+        apply_axis(stencil, f, out, ny * nz, nx, 1);
+    } else if (axis == 1) {
+        apply_axis(stencil, f, out, nz, ny, nx);
+    } else if (axis == 2) {
+        apply_axis(stencil, f, out, 1, nz, nx * ny);
+    } else {
+        throw std::invalid_argument("Os musi byc rowna 0, 1 lub 2.");
+    }
+}
+
+} // namespace NumLibCpp
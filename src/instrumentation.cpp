@@ -0,0 +1,260 @@
+#include "NumLibCpp/instrumentation.hpp"
+#include <algorithm> // Dla std::sort
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+namespace NumLibCpp {
+
+namespace detail {
+
+// Liczniki są atomowe tylko po to, by migawka z innego wątku była poprawnie zsynchronizowana;
+// zapisuje je wyłącznie wątek-właściciel (load + store, bez operacji read-modify-write)
+struct EntryPointSlot {
+    const char* name = nullptr;
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> function_evaluations{0};
+    std::atomic<std::uint64_t> iterations{0};
+    std::atomic<std::uint64_t> pivots{0};
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> wall_time_ns{0};
+};
+
+} // namespace detail
+
+namespace {
+
+using detail::EntryPointSlot;
+
+struct TraceEvent {
+    const char* name;
+    std::int64_t start_ns;
+    std::int64_t duration_ns;
+};
+
+// Dane jednego wątku; mutex chroni mapę i zdarzenia przed odczytem z innego wątku
+struct ThreadRecord {
+    std::uint32_t id = 0;
+    std::mutex mutex;
+    std::unordered_map<const char*, std::unique_ptr<EntryPointSlot>> slots;
+    std::vector<TraceEvent> events;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadRecord>> threads; // Także wątki zakończone - ich liczniki pozostają w migawce
+    std::atomic<bool> tracing{false};
+    bool session_active = false;
+};
+
+// Celowo bez destruktora: wątki puli mogą kończyć się po zniszczeniu obiektów statycznych
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+ThreadRecord& this_thread_record() {
+    thread_local std::shared_ptr<ThreadRecord> record = [] {
+        auto r = std::make_shared<ThreadRecord>();
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        r->id = static_cast<std::uint32_t>(reg.threads.size() + 1);
+        reg.threads.push_back(r);
+        return r;
+    }();
+    return *record;
+}
+
+thread_local EntryPointSlot* current_slot = nullptr;
+
+constexpr char unscoped_name[] = "(unscoped)";
+
+std::int64_t now_ns() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+EntryPointSlot* find_slot(const char* name) {
+    ThreadRecord& record = this_thread_record();
+    std::lock_guard<std::mutex> lock(record.mutex);
+    std::unique_ptr<EntryPointSlot>& slot = record.slots[name];
+    if (!slot) {
+        slot = std::make_unique<EntryPointSlot>();
+        slot->name = name;
+    }
+    return slot.get();
+}
+
+void add(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+std::vector<std::shared_ptr<ThreadRecord>> all_threads() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.threads;
+}
+
+void write_json_string(std::ostream& os, const char* s) {
+    os << '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') os << '\\';
+        os << *s;
+    }
+    os << '"';
+}
+
+} // namespace
+
+const EntryPointStats* InstrumentationSnapshot::find(const std::string& name) const {
+    for (const EntryPointStats& e : entries) {
+        if (e.name == name) return &e;
+    }
+    return nullptr;
+}
+
+InstrumentationSnapshot instrumentation_snapshot() {
+    // Ta sama nazwa może mieć kilka slotów (różne wątki, literały z różnych jednostek translacji)
+    std::map<std::string, EntryPointStats> merged;
+    for (const std::shared_ptr<ThreadRecord>& record : all_threads()) {
+        std::lock_guard<std::mutex> lock(record->mutex);
+        for (const auto& item : record->slots) {
+            const EntryPointSlot& slot = *item.second;
+            EntryPointStats& e = merged[slot.name];
+            e.name = slot.name;
+            e.calls += slot.calls.load(std::memory_order_relaxed);
+            e.function_evaluations += slot.function_evaluations.load(std::memory_order_relaxed);
+            e.iterations += slot.iterations.load(std::memory_order_relaxed);
+            e.pivots += slot.pivots.load(std::memory_order_relaxed);
+            e.allocations += slot.allocations.load(std::memory_order_relaxed);
+            e.wall_time_ns += slot.wall_time_ns.load(std::memory_order_relaxed);
+        }
+    }
+    InstrumentationSnapshot snapshot;
+    for (auto& item : merged) {
+        snapshot.entries.push_back(std::move(item.second));
+    }
+    return snapshot;
+}
+
+void instrumentation_reset() {
+    for (const std::shared_ptr<ThreadRecord>& record : all_threads()) {
+        std::lock_guard<std::mutex> lock(record->mutex);
+        for (const auto& item : record->slots) {
+            EntryPointSlot& slot = *item.second;
+            slot.calls.store(0, std::memory_order_relaxed);
+            slot.function_evaluations.store(0, std::memory_order_relaxed);
+            slot.iterations.store(0, std::memory_order_relaxed);
+            slot.pivots.store(0, std::memory_order_relaxed);
+            slot.allocations.store(0, std::memory_order_relaxed);
+            slot.wall_time_ns.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+TraceSession::TraceSession(std::string path) : path_(std::move(path)) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    if (reg.session_active) {
+        throw std::runtime_error("Inna sesja sledzenia jest juz aktywna.");
+    }
+    for (const std::shared_ptr<ThreadRecord>& record : reg.threads) {
+        std::lock_guard<std::mutex> record_lock(record->mutex);
+        record->events.clear();
+    }
+    reg.session_active = true;
+    active_ = true;
+    reg.tracing.store(true, std::memory_order_relaxed);
+}
+
+TraceSession::~TraceSession() {
+    stop();
+    if (!path_.empty()) {
+        try {
+            write(path_);
+        } catch (...) {
+            // Destruktor nie może rzucać - błąd zapisu jest pomijany
+        }
+    }
+}
+
+void TraceSession::stop() {
+    if (!active_) return;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.tracing.store(false, std::memory_order_relaxed);
+    reg.session_active = false;
+    active_ = false;
+}
+
+void TraceSession::write(std::ostream& os) const {
+    struct Event {
+        TraceEvent event;
+        std::uint32_t tid;
+    };
+    std::vector<Event> events;
+    for (const std::shared_ptr<ThreadRecord>& record : all_threads()) {
+        std::lock_guard<std::mutex> lock(record->mutex);
+        for (const TraceEvent& e : record->events) events.push_back({e, record->id});
+    }
+    std::sort(events.begin(), events.end(),
+              [](const Event& a, const Event& b) { return a.event.start_ns < b.event.start_ns; });
+
+    os << "{\"traceEvents\": [";
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        const Event& e = events[i];
+        os << (i == 0 ? "\n" : ",\n") << "  {\"name\": ";
+        write_json_string(os, e.event.name);
+        // Chrome Trace Event: czasy w mikrosekundach (ułamkowe)
+        os << ", \"cat\": \"NumLibCpp\", \"ph\": \"X\", \"ts\": " << static_cast<double>(e.event.start_ns) / 1000.0
+           << ", \"dur\": " << static_cast<double>(e.event.duration_ns) / 1000.0 << ", \"pid\": 1, \"tid\": " << e.tid
+           << "}";
+    }
+    os << "\n], \"displayTimeUnit\": \"ns\"}\n";
+}
+
+void TraceSession::write(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Nie mozna otworzyc pliku sledzenia: " + path);
+    }
+    write(file);
+}
+
+namespace detail {
+
+InstrumentScope::InstrumentScope(const char* name)
+    : slot_(find_slot(name)), parent_(current_slot), start_ns_(now_ns()) {
+    add(slot_->calls, 1);
+    current_slot = slot_;
+}
+
+InstrumentScope::~InstrumentScope() {
+    const std::int64_t duration = now_ns() - start_ns_;
+    add(slot_->wall_time_ns, static_cast<std::uint64_t>(duration));
+    current_slot = parent_;
+    if (registry().tracing.load(std::memory_order_relaxed)) {
+        ThreadRecord& record = this_thread_record();
+        std::lock_guard<std::mutex> lock(record.mutex);
+        record.events.push_back({slot_->name, start_ns_, duration});
+    }
+}
+
+void instrument_count(Counter counter, std::uint64_t amount) {
+    EntryPointSlot* slot = current_slot ? current_slot : find_slot(unscoped_name);
+    switch (counter) {
+        case Counter::function_evaluations: add(slot->function_evaluations, amount); break;
+        case Counter::iterations: add(slot->iterations, amount); break;
+        case Counter::pivots: add(slot->pivots, amount); break;
+        case Counter::allocations: add(slot->allocations, amount); break;
+    }
+}
+
+} // namespace detail
+
+} // namespace NumLibCpp
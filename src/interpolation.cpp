@@ -1,18 +1,18 @@
 #include "NumLibCpp/interpolation.hpp" // Dołączenie odpowiedniego nagłówka
+#include "NumLibCpp/instrumentation.hpp"
 #include <vector>
 #include <stdexcept>
 #include <cmath> // Dla std::abs, przydatne do sprawdzania duplikatów
+#include <algorithm> // Dla std::min
 
 // Otwieramy przestrzeń nazw, aby definicja pasowała do deklaracji
 namespace NumLibCpp {
 
-/**
- * @brief Implementacja funkcji obliczającej wartość interpolowaną metodą Lagrange'a.
- */
-double lagrange_interpolate(const std::vector<double>& x_nodes, const std::vector<double>& y_nodes, double x_interp) {
-    
-    // --- Walidacja danych wejściowych ---
+namespace {
 
+// Wspólna walidacja węzłów dla wersji punktowej i wsadowej
+template <typename T>
+void validate_nodes(const std::vector<T>& x_nodes, const std::vector<T>& y_nodes) {
     if (x_nodes.size() != y_nodes.size()) {
         throw std::invalid_argument("Vectors x_nodes and y_nodes must have the same size.");
     }
@@ -25,19 +25,49 @@ double lagrange_interpolate(const std::vector<double>& x_nodes, const std::vecto
     for (size_t i = 0; i < x_nodes.size(); ++i) {
         for (size_t j = i + 1; j < x_nodes.size(); ++j) {
             // Używamy małej tolerancji na wypadek problemów z precyzją zmiennoprzecinkową
-            if (std::abs(x_nodes[i] - x_nodes[j]) < 1e-9) {
+            if (std::abs(x_nodes[i] - x_nodes[j]) < static_cast<T>(1e-9)) {
                 throw std::invalid_argument("x_nodes must contain unique values.");
             }
         }
     }
-    
+}
+
+// Liczba punktów przetwarzanych razem w trybie ParallelSimd (pętla po punktach jest wektoryzowana)
+constexpr std::size_t lagrange_simd_block = 8;
+
+// Wartość z sum barycentrycznych; w węźle (dzielenie przez zero) zwracana jest dokładna wartość węzła
+template <typename T>
+T barycentric_value(const std::vector<T>& x_nodes, const std::vector<T>& y_nodes, T x, T num, T den) {
+    T value = num / den;
+    if (!std::isfinite(value)) {
+        for (std::size_t j = 0; j < x_nodes.size(); ++j) {
+            if (x == x_nodes[j]) {
+                return y_nodes[j];
+            }
+        }
+    }
+    return value;
+}
+
+} // namespace
+
+/**
+ * @brief Implementacja funkcji obliczającej wartość interpolowaną metodą Lagrange'a.
+ */
+template <typename T>
+T lagrange_interpolate(const std::vector<T>& x_nodes, const std::vector<T>& y_nodes, detail::type_identity_t<T> x_interp) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("lagrange_interpolate");
+
+    // --- Walidacja danych wejściowych ---
+    validate_nodes(x_nodes, y_nodes);
+
     // --- Logika interpolacji Lagrange'a ---
 
-    double interpolated_value = 0.0;
+    T interpolated_value = 0;
     size_t n = x_nodes.size();
 
     for (size_t i = 0; i < n; ++i) {
-        double basis_polynomial = 1.0; // l_i(x)
+        T basis_polynomial = 1; // l_i(x)
         for (size_t j = 0; j < n; ++j) {
             if (i != j) {
                 basis_polynomial *= (x_interp - x_nodes[j]) / (x_nodes[i] - x_nodes[j]);
@@ -49,4 +79,130 @@ double lagrange_interpolate(const std::vector<double>& x_nodes, const std::vecto
     return interpolated_value;
 }
 
+namespace {
+
+// Wersja wsadowa na surowych buforach; w i wy - miejsce na wagi barycentryczne (N elementów)
+template <typename T>
+void lagrange_batch(const std::vector<T>& x_nodes, const std::vector<T>& y_nodes, const T* x_interp,
+                    std::size_t count, T* result, T* w, T* wy, ExecutionPolicy policy) {
+    // Wagi barycentryczne w_j = 1 / prod_{k != j} (x_j - x_k), liczone raz dla wszystkich punktów
+    const std::size_t n = x_nodes.size();
+    for (std::size_t j = 0; j < n; ++j) {
+        T prod = 1;
+        for (std::size_t k = 0; k < n; ++k) {
+            if (k != j) {
+                prod *= x_nodes[j] - x_nodes[k];
+            }
+        }
+        w[j] = 1 / prod;
+        wy[j] = w[j] * y_nodes[j];
+    }
+
+    // p(x) = sum_j (w_j y_j / (x - x_j)) / sum_j (w_j / (x - x_j)); we wszystkich trybach sumy mają
+    // tę samą kolejność, więc wynik nie zależy od wybranego sposobu wykonania
+    auto evaluate = [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t p = lo; p < hi; ++p) {
+            T num = 0, den = 0;
+            for (std::size_t j = 0; j < n; ++j) {
+                T t = 1 / (x_interp[p] - x_nodes[j]);
+                num += wy[j] * t;
+                den += w[j] * t;
+            }
+            result[p] = barycentric_value(x_nodes, y_nodes, x_interp[p], num, den);
+        }
+    };
+    // Węzły w pętli zewnętrznej, punkty bloku w wewnętrznej - niezależne akumulatory dla każdego punktu
+    auto evaluate_simd = [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t start = lo; start < hi; start += lagrange_simd_block) {
+            const std::size_t m = std::min(lagrange_simd_block, hi - start);
+            T num[lagrange_simd_block] = {}, den[lagrange_simd_block] = {};
+            const T* x = x_interp + start;
+            for (std::size_t j = 0; j < n; ++j) {
+                const T xj = x_nodes[j], wj = w[j], wyj = wy[j];
+                for (std::size_t q = 0; q < m; ++q) {
+                    T t = 1 / (x[q] - xj);
+                    num[q] += wyj * t;
+                    den[q] += wj * t;
+                }
+            }
+            for (std::size_t q = 0; q < m; ++q) {
+                result[start + q] = barycentric_value(x_nodes, y_nodes, x[q], num[q], den[q]);
+            }
+        }
+    };
+
+    if (policy == ExecutionPolicy::Sequential) {
+        evaluate(0, count);
+    } else {
+        // Fragment obejmuje około 64 tysięcy par (punkt, węzeł)
+        const std::size_t grain = std::max<std::size_t>(lagrange_simd_block, 65536 / n);
+        ThreadPool::global().parallel_for(0, count, grain, [&](std::size_t lo, std::size_t hi) {
+            if (policy == ExecutionPolicy::ParallelSimd) {
+                evaluate_simd(lo, hi);
+            } else {
+                evaluate(lo, hi);
+            }
+        });
+    }
+}
+
+} // namespace
+
+template <typename T>
+std::vector<T> lagrange_interpolate(const std::vector<T>& x_nodes, const std::vector<T>& y_nodes,
+                                    const std::vector<T>& x_interp, ExecutionPolicy policy) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("lagrange_interpolate");
+    validate_nodes(x_nodes, y_nodes);
+
+    std::vector<T> w(x_nodes.size()), wy(x_nodes.size());
+    std::vector<T> result(x_interp.size());
+    NUMLIBCPP_COUNT(allocations, 3);
+    lagrange_batch(x_nodes, y_nodes, x_interp.data(), x_interp.size(), result.data(), w.data(), wy.data(), policy);
+    return result;
+}
+
+template <typename T>
+void lagrange_interpolate(const std::vector<T>& x_nodes, const std::vector<T>& y_nodes,
+                          const std::vector<T>& x_interp, std::vector<T>& out, Workspace& workspace,
+                          ExecutionPolicy policy) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("lagrange_interpolate");
+    validate_nodes(x_nodes, y_nodes);
+
+    Workspace::Frame frame(workspace);
+    T* w = workspace.allocate<T>(x_nodes.size());
+    T* wy = workspace.allocate<T>(x_nodes.size());
+    out.resize(x_interp.size());
+    lagrange_batch(x_nodes, y_nodes, x_interp.data(), x_interp.size(), out.data(), w, wy, policy);
+}
+
+// Wersje dla double poza szablonami zachowują dotychczasowe symbole biblioteki
+double lagrange_interpolate(const std::vector<double>& x_nodes, const std::vector<double>& y_nodes, double x_interp) {
+    return lagrange_interpolate<double>(x_nodes, y_nodes, x_interp);
+}
+
+std::vector<double> lagrange_interpolate(const std::vector<double>& x_nodes, const std::vector<double>& y_nodes,
+                                         const std::vector<double>& x_interp, ExecutionPolicy policy) {
+    return lagrange_interpolate<double>(x_nodes, y_nodes, x_interp, policy);
+}
+
+void lagrange_interpolate(const std::vector<double>& x_nodes, const std::vector<double>& y_nodes,
+                          const std::vector<double>& x_interp, std::vector<double>& out, Workspace& workspace,
+                          ExecutionPolicy policy) {
+    lagrange_interpolate<double>(x_nodes, y_nodes, x_interp, out, workspace, policy);
+}
+
+// Jawne konkretyzacje dla obsługiwanych typów skalarnych
+template float lagrange_interpolate<float>(const std::vector<float>&, const std::vector<float>&, float);
+template std::vector<float> lagrange_interpolate<float>(const std::vector<float>&, const std::vector<float>&, const std::vector<float>&, ExecutionPolicy);
+template void lagrange_interpolate<float>(const std::vector<float>&, const std::vector<float>&, const std::vector<float>&, std::vector<float>&, Workspace&,
+                                        ExecutionPolicy);
+template double lagrange_interpolate<double>(const std::vector<double>&, const std::vector<double>&, double);
+template std::vector<double> lagrange_interpolate<double>(const std::vector<double>&, const std::vector<double>&, const std::vector<double>&, ExecutionPolicy);
+template void lagrange_interpolate<double>(const std::vector<double>&, const std::vector<double>&, const std::vector<double>&, std::vector<double>&, Workspace&,
+                                        ExecutionPolicy);
+template long double lagrange_interpolate<long double>(const std::vector<long double>&, const std::vector<long double>&, long double);
+template std::vector<long double> lagrange_interpolate<long double>(const std::vector<long double>&, const std::vector<long double>&, const std::vector<long double>&, ExecutionPolicy);
+template void lagrange_interpolate<long double>(const std::vector<long double>&, const std::vector<long double>&, const std::vector<long double>&, std::vector<long double>&, Workspace&,
+                                        ExecutionPolicy);
+
 } // namespace NumLibCpp
\ No newline at end of file
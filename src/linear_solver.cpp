@@ -1,4 +1,5 @@
 #include "NumLibCpp/linear_solver.hpp"
+#include "NumLibCpp/instrumentation.hpp"
 #include <cmath> // Dla std::abs, std::fabs
 #include <algorithm> // Dla std::swap
 #include <limits>    // Dla std::numeric_limits
@@ -6,6 +7,83 @@
 namespace NumLibCpp {
 
 std::vector<double> gauss_elimination(std::vector<std::vector<double>> A, std::vector<double> b) {
+    return gauss_elimination(std::move(A), std::move(b), ExecutionPolicy::Sequential);
+}
+
+template <typename T>
+void gauss_elimination_in_place(T* A, T* b, int n) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("gauss_elimination");
+    if (n <= 0) {
+        throw std::invalid_argument("Macierz A nie moze byc pusta.");
+    }
+
+    // Ta sama kolejność działań co w wersji z std::vector (identyczny wynik)
+    for (int i = 0; i < n; ++i) {
+        T* row_i = A + static_cast<std::size_t>(i) * n;
+        int max_row = i;
+        for (int k = i + 1; k < n; ++k) {
+            if (std::abs(A[static_cast<std::size_t>(k) * n + i]) > std::abs(A[static_cast<std::size_t>(max_row) * n + i])) {
+                max_row = k;
+            }
+        }
+        if (max_row != i) {
+            std::swap_ranges(row_i, row_i + n, A + static_cast<std::size_t>(max_row) * n);
+            std::swap(b[i], b[max_row]);
+        }
+        NUMLIBCPP_COUNT(pivots, max_row != i);
+        NUMLIBCPP_COUNT(iterations, 1);
+
+        if (std::abs(row_i[i]) < std::numeric_limits<T>::epsilon()) {
+            throw std::runtime_error("Macierz jest osobliwa lub bliska osobliwej.");
+        }
+
+        for (int k = i + 1; k < n; ++k) {
+            row_i[k] /= row_i[i];
+        }
+        b[i] /= row_i[i];
+        row_i[i] = 1.0;
+
+        for (int k = 0; k < n; ++k) {
+            if (k != i) {
+                T* row_k = A + static_cast<std::size_t>(k) * n;
+                T factor = row_k[i];
+                for (int j = i; j < n; ++j) {
+                    row_k[j] -= factor * row_i[j];
+                }
+                b[k] -= factor * b[i];
+            }
+        }
+    }
+}
+
+template <typename T>
+void gauss_elimination(const std::vector<std::vector<T>>& A, const std::vector<T>& b, std::vector<T>& x,
+                       Workspace& workspace) {
+    const int n = static_cast<int>(A.size());
+    if (n == 0) {
+        throw std::invalid_argument("Macierz A nie moze byc pusta.");
+    }
+    for (const std::vector<T>& row : A) {
+        if (row.size() != static_cast<size_t>(n)) {
+            throw std::invalid_argument("Macierz A musi byc kwadratowa.");
+        }
+    }
+    if (b.size() != static_cast<size_t>(n)) {
+        throw std::invalid_argument("Rozmiar wektora b musi byc zgodny z rozmiarem macierzy A.");
+    }
+
+    Workspace::Frame frame(workspace);
+    T* a = workspace.allocate<T>(static_cast<std::size_t>(n) * n);
+    for (int i = 0; i < n; ++i) {
+        std::copy(A[i].begin(), A[i].end(), a + static_cast<std::size_t>(i) * n);
+    }
+    x.assign(b.begin(), b.end());
+    gauss_elimination_in_place<T>(a, x.data(), n);
+}
+
+template <typename T>
+std::vector<T> gauss_elimination(std::vector<std::vector<T>> A, std::vector<T> b, ExecutionPolicy policy) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("gauss_elimination");
     int n = A.size();
     if (n == 0) {
         throw std::invalid_argument("Macierz A nie moze byc pusta.");
@@ -17,6 +95,10 @@ std::vector<double> gauss_elimination(std::vector<std::vector<double>> A, std::v
         throw std::invalid_argument("Rozmiar wektora b musi byc zgodny z rozmiarem macierzy A.");
     }
 
+    // Dla małych macierzy koszt synchronizacji po każdej kolumnie przewyższa zysk z podziału wierszy
+    const bool parallel = policy != ExecutionPolicy::Sequential && n >= 64;
+    const std::size_t row_grain = std::max<std::size_t>(8, 16384 / static_cast<std::size_t>(n));
+
     for (int i = 0; i < n; ++i) {
         // Częściowy wybór elementu głównego (pivot)
         int max_row = i;
@@ -27,9 +109,11 @@ std::vector<double> gauss_elimination(std::vector<std::vector<double>> A, std::v
         }
         std::swap(A[i], A[max_row]);
         std::swap(b[i], b[max_row]);
+        NUMLIBCPP_COUNT(pivots, max_row != i);
+        NUMLIBCPP_COUNT(iterations, 1);
 
         // Sprawdzenie osobliwości
-        if (std::abs(A[i][i]) < std::numeric_limits<double>::epsilon()) {
+        if (std::abs(A[i][i]) < std::numeric_limits<T>::epsilon()) {
             throw std::runtime_error("Macierz jest osobliwa lub bliska osobliwej.");
         }
 
@@ -41,15 +125,24 @@ std::vector<double> gauss_elimination(std::vector<std::vector<double>> A, std::v
         A[i][i] = 1.0; // Ustawienie elementu diagonalnego na 1 (opcjonalne, ale czytelne)
 
 
-        // Eliminacja dla pozostałych wierszy
-        for (int k = 0; k < n; ++k) {
-            if (k != i) {
-                double factor = A[k][i];
-                for (int j = i; j < n; ++j) { // Zaczynamy od kolumny i, bo A[k][<i] już są 0
-                    A[k][j] -= factor * A[i][j];
+        // Eliminacja dla pozostałych wierszy (wiersze są od siebie niezależne)
+        auto eliminate_rows = [&A, &b, i, n](int first, int last) {
+            for (int k = first; k < last; ++k) {
+                if (k != i) {
+                    T factor = A[k][i];
+                    for (int j = i; j < n; ++j) { // Zaczynamy od kolumny i, bo A[k][<i] już są 0
+                        A[k][j] -= factor * A[i][j];
+                    }
+                    b[k] -= factor * b[i];
                 }
-                b[k] -= factor * b[i];
             }
+        };
+        if (parallel) {
+            ThreadPool::global().parallel_for(0, n, row_grain, [&eliminate_rows](std::size_t lo, std::size_t hi) {
+                eliminate_rows(static_cast<int>(lo), static_cast<int>(hi));
+            });
+        } else {
+            eliminate_rows(0, n);
         }
     }
 
@@ -98,4 +191,161 @@ std::vector<double> gauss_elimination(std::vector<std::vector<double>> A, std::v
     return b;
 }
 
-} // namespace NumLibCpp
\ No newline at end of file
+// Wersje dla double poza szablonami zachowują dotychczasowe symbole biblioteki
+std::vector<double> gauss_elimination(std::vector<std::vector<double>> A, std::vector<double> b, ExecutionPolicy policy) {
+    return gauss_elimination<double>(std::move(A), std::move(b), policy);
+}
+
+void gauss_elimination_in_place(double* A, double* b, int n) {
+    gauss_elimination_in_place<double>(A, b, n);
+}
+
+void gauss_elimination(const std::vector<std::vector<double>>& A, const std::vector<double>& b, std::vector<double>& x,
+                       Workspace& workspace) {
+    gauss_elimination<double>(A, b, x, workspace);
+}
+
+// Jawne konkretyzacje dla obsługiwanych typów skalarnych
+template std::vector<float> gauss_elimination<float>(std::vector<std::vector<float>>, std::vector<float>, ExecutionPolicy);
+template void gauss_elimination_in_place<float>(float*, float*, int);
+template void gauss_elimination<float>(const std::vector<std::vector<float>>&, const std::vector<float>&, std::vector<float>&,
+                                     Workspace&);
+template std::vector<double> gauss_elimination<double>(std::vector<std::vector<double>>, std::vector<double>, ExecutionPolicy);
+template void gauss_elimination_in_place<double>(double*, double*, int);
+template void gauss_elimination<double>(const std::vector<std::vector<double>>&, const std::vector<double>&, std::vector<double>&,
+                                     Workspace&);
+template std::vector<long double> gauss_elimination<long double>(std::vector<std::vector<long double>>, std::vector<long double>, ExecutionPolicy);
+template void gauss_elimination_in_place<long double>(long double*, long double*, int);
+template void gauss_elimination<long double>(const std::vector<std::vector<long double>>&, const std::vector<long double>&, std::vector<long double>&,
+                                     Workspace&);
+
+LUDecomposition lu_decompose(const std::vector<std::vector<double>>& A) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("lu_decompose");
+    int n = A.size();
+    if (n == 0) {
+        throw std::invalid_argument("Macierz A nie moze byc pusta.");
+    }
+
+    LUDecomposition result;
+    result.n = n;
+    result.lu.resize(static_cast<size_t>(n) * n);
+    result.pivots.resize(n);
+    NUMLIBCPP_COUNT(allocations, 2);
+    for (int i = 0; i < n; ++i) {
+        if (A[i].size() != static_cast<size_t>(n)) {
+            throw std::invalid_argument("Macierz A musi byc kwadratowa.");
+        }
+        std::copy(A[i].begin(), A[i].end(), result.lu.begin() + static_cast<size_t>(i) * n);
+    }
+
+    double* lu = result.lu.data();
+    for (int i = 0; i < n; ++i) {
+        // Częściowy wybór elementu głównego (pivot)
+        int max_row = i;
+        for (int k = i + 1; k < n; ++k) {
+            if (std::abs(lu[k * n + i]) > std::abs(lu[max_row * n + i])) {
+                max_row = k;
+            }
+        }
+        result.pivots[i] = max_row;
+        if (max_row != i) {
+            std::swap_ranges(lu + i * n, lu + (i + 1) * n, lu + max_row * n);
+            NUMLIBCPP_COUNT(pivots, 1);
+        }
+        NUMLIBCPP_COUNT(iterations, 1);
+
+        // Sprawdzenie osobliwości (to samo kryterium co w gauss_elimination)
+        if (std::abs(lu[i * n + i]) < std::numeric_limits<double>::epsilon()) {
+            throw std::runtime_error("Macierz jest osobliwa lub bliska osobliwej.");
+        }
+
+        // Eliminacja pod diagonalą; mnożniki trafiają w miejsce zer (czynnik L)
+        const double* row_i = lu + i * n;
+        for (int k = i + 1; k < n; ++k) {
+            double* row_k = lu + k * n;
+            double factor = row_k[i] / row_i[i];
+            row_k[i] = factor;
+            for (int j = i + 1; j < n; ++j) {
+                row_k[j] -= factor * row_i[j];
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<double> lu_solve(const LUDecomposition& lu, std::vector<double> b) {
+    const int n = lu.n;
+    if (b.size() != static_cast<size_t>(n)) {
+        throw std::invalid_argument("Rozmiar wektora b musi byc zgodny z rozmiarem rozkladu LU.");
+    }
+    const double* a = lu.lu.data();
+
+    // Permutacja i podstawienie w przód (L ma jedynki na diagonali)
+    for (int i = 0; i < n; ++i) {
+        std::swap(b[i], b[lu.pivots[i]]);
+    }
+    for (int i = 1; i < n; ++i) {
+        double sum = b[i];
+        for (int j = 0; j < i; ++j) {
+            sum -= a[i * n + j] * b[j];
+        }
+        b[i] = sum;
+    }
+    // Podstawienie wsteczne
+    for (int i = n - 1; i >= 0; --i) {
+        double sum = b[i];
+        for (int j = i + 1; j < n; ++j) {
+            sum -= a[i * n + j] * b[j];
+        }
+        b[i] = sum / a[i * n + i];
+    }
+    return b;
+}
+
+TridiagonalDecomposition tridiagonal_decompose(const std::vector<double>& lower,
+                                               const std::vector<double>& diag,
+                                               const std::vector<double>& upper) {
+    const size_t n = diag.size();
+    if (n == 0) {
+        throw std::invalid_argument("Macierz trojdiagonalna nie moze byc pusta.");
+    }
+    if (lower.size() != n || upper.size() != n) {
+        throw std::invalid_argument("Przekatne macierzy trojdiagonalnej musza miec ten sam rozmiar.");
+    }
+
+    TridiagonalDecomposition result;
+    result.lower = lower;
+    result.c_prime.resize(n);
+    result.inv_denom.resize(n);
+
+    double c_prev = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double denom = diag[i] - (i > 0 ? lower[i] * c_prev : 0.0);
+        if (std::abs(denom) < std::numeric_limits<double>::epsilon()) {
+            throw std::runtime_error("Zerowy mianownik w algorytmie Thomasa (macierz nie jest diagonalnie dominujaca?).");
+        }
+        result.inv_denom[i] = 1.0 / denom;
+        c_prev = (i + 1 < n) ? upper[i] * result.inv_denom[i] : 0.0;
+        result.c_prime[i] = c_prev;
+    }
+    return result;
+}
+
+std::vector<double> tridiagonal_solve(const TridiagonalDecomposition& decomposition, std::vector<double> d) {
+    const size_t n = decomposition.inv_denom.size();
+    if (d.size() != n) {
+        throw std::invalid_argument("Rozmiar wektora d musi byc zgodny z rozmiarem macierzy trojdiagonalnej.");
+    }
+    // Podstawienie w przód
+    d[0] *= decomposition.inv_denom[0];
+    for (size_t i = 1; i < n; ++i) {
+        d[i] = (d[i] - decomposition.lower[i] * d[i - 1]) * decomposition.inv_denom[i];
+    }
+    // Podstawienie wsteczne
+    for (size_t i = n - 1; i-- > 0;) {
+        d[i] -= decomposition.c_prime[i] * d[i + 1];
+    }
+    return d;
+}
+
+} // namespace NumLibCpp
@@ -1,46 +1,446 @@
 #include "NumLibCpp/nonlinear_solver.hpp"
-#include <cmath> // Dla std::abs, std::fabs
+#include "NumLibCpp/linear_solver.hpp"
+#include "NumLibCpp/differentiation.hpp"
+#include "NumLibCpp/thread_pool.hpp"
+#include "NumLibCpp/instrumentation.hpp"
+#include <algorithm> // Dla std::max, std::min
+#include <utility>   // Dla std::move
+#include <cmath> // Dla std::abs, std::fabs, std::cbrt
 
 namespace NumLibCpp {
 
 double secant_method(std::function<double(double)> func, double x0, double x1, double tol, int max_iter) {
-    if (tol <= 0.0) {
+    int num_evaluations = 0;
+    return secant_method(std::move(func), x0, x1, tol, max_iter, num_evaluations);
+}
+
+double secant_method(std::function<double(double)> func, double x0, double x1, double tol, int max_iter,
+                     int& num_evaluations) {
+    return detail::secant_method_impl(func, x0, x1, tol, max_iter, num_evaluations);
+}
+
+double brent_method(std::function<double(double)> func, double a, double b, double tol, int max_iter) {
+    int num_evaluations = 0;
+    return brent_method(std::move(func), a, b, tol, max_iter, num_evaluations);
+}
+
+double brent_method(std::function<double(double)> func, double a, double b, double tol, int max_iter,
+                    int& num_evaluations) {
+    return detail::brent_method_impl(func, a, b, tol, max_iter, num_evaluations);
+}
+
+namespace {
+
+// Rozwiązuje równania [first, first + count) jednego bloku; stan pasm w układzie SoA
+void chandrupatla_block(const BatchRootFunction& f, const std::vector<double>& lower,
+                        const std::vector<double>& upper, const BatchRootOptions& options,
+                        std::size_t first, std::size_t count, BatchRootResult& result) {
+    const double eps = std::numeric_limits<double>::epsilon();
+    std::vector<double> a(count), b(count), c(count), fa(count), fb(count), fc(count);
+    std::vector<double> t(count, 0.5), xt(count), ft(count), xm(count), tlim(count);
+    std::vector<std::size_t> index(count);
+    std::vector<std::uint8_t> done(count);
+
+    for (std::size_t k = 0; k < count; ++k) {
+        index[k] = first + k;
+        a[k] = lower[first + k];
+        b[k] = upper[first + k];
+    }
+    f(a.data(), index.data(), fa.data(), count);
+    f(b.data(), index.data(), fb.data(), count);
+
+    // Klasyfikacja końców przedziałów i kompakcja pozostałych równań
+    std::size_t active = 0;
+    for (std::size_t k = 0; k < count; ++k) {
+        const std::size_t i = index[k];
+        RootStatus status = RootStatus::Converged;
+        double root = 0.0;
+        if (!std::isfinite(fa[k]) || !std::isfinite(fb[k])) {
+            status = RootStatus::NotFinite;
+            root = std::numeric_limits<double>::quiet_NaN();
+        } else if (fa[k] == 0.0) {
+            root = a[k];
+        } else if (fb[k] == 0.0) {
+            root = b[k];
+        } else if ((fa[k] > 0.0) == (fb[k] > 0.0)) {
+            status = RootStatus::NoBracket;
+            root = std::numeric_limits<double>::quiet_NaN();
+        } else {
+            a[active] = a[k];
+            b[active] = b[k];
+            fa[active] = fa[k];
+            fb[active] = fb[k];
+            index[active] = i;
+            ++active;
+            continue;
+        }
+        result.roots[i] = root;
+        result.status[i] = status;
+    }
+
+    for (int iter = 1; iter <= options.max_iter && active > 0; ++iter) {
+        for (std::size_t k = 0; k < active; ++k) {
+            xt[k] = a[k] + t[k] * (b[k] - a[k]);
+        }
+        f(xt.data(), index.data(), ft.data(), active);
+
+        // Aktualizacja wszystkich pasm bez rozgałęzień (wybory przez wyrażenia warunkowe)
+        for (std::size_t k = 0; k < active; ++k) {
+            const bool same = (ft[k] > 0.0) == (fa[k] > 0.0);
+            const double c_new = same ? a[k] : b[k];
+            const double fc_new = same ? fa[k] : fb[k];
+            const double b_new = same ? b[k] : a[k];
+            const double fb_new = same ? fb[k] : fa[k];
+            c[k] = c_new;
+            fc[k] = fc_new;
+            b[k] = b_new;
+            fb[k] = fb_new;
+            a[k] = xt[k];
+            fa[k] = ft[k];
+
+            const bool a_better = std::abs(fa[k]) < std::abs(fb[k]);
+            xm[k] = a_better ? a[k] : b[k];
+            const double fm = a_better ? fa[k] : fb[k];
+            const double tol = 2.0 * eps * std::abs(xm[k]) + options.tol;
+            tlim[k] = tol / std::abs(b[k] - c[k]);
+            done[k] = static_cast<std::uint8_t>(tlim[k] > 0.5 || fm == 0.0 || !std::isfinite(ft[k]));
+
+            // Odwrotna interpolacja kwadratowa, jeśli punkty a, b, c są odpowiednio ułożone; inaczej bisekcja
+            const double xi = (a[k] - b[k]) / (c[k] - b[k]);
+            const double phi = (fa[k] - fb[k]) / (fc[k] - fb[k]);
+            const bool iqi = phi * phi < xi && (1.0 - phi) * (1.0 - phi) < 1.0 - xi;
+            const double t_iqi = fa[k] / (fb[k] - fa[k]) * fc[k] / (fb[k] - fc[k]) +
+                                 (c[k] - a[k]) / (b[k] - a[k]) * fa[k] / (fc[k] - fa[k]) * fb[k] / (fc[k] - fb[k]);
+            const double t_new = iqi ? t_iqi : 0.5;
+            t[k] = std::min(1.0 - tlim[k], std::max(tlim[k], t_new));
+        }
+
+        // Zapis zakończonych pasm i kompakcja aktywnych
+        std::size_t kept = 0;
+        for (std::size_t k = 0; k < active; ++k) {
+            if (done[k]) {
+                const std::size_t i = index[k];
+                const bool finite = std::isfinite(ft[k]);
+                result.roots[i] = finite ? xm[k] : std::numeric_limits<double>::quiet_NaN();
+                result.status[i] = finite ? RootStatus::Converged : RootStatus::NotFinite;
+                result.iterations[i] = iter;
+                continue;
+            }
+            if (kept != k) {
+                a[kept] = a[k];
+                b[kept] = b[k];
+                c[kept] = c[k];
+                fa[kept] = fa[k];
+                fb[kept] = fb[k];
+                fc[kept] = fc[k];
+                t[kept] = t[k];
+                index[kept] = index[k];
+            }
+            ++kept;
+        }
+        active = kept;
+    }
+
+    for (std::size_t k = 0; k < active; ++k) {
+        const std::size_t i = index[k];
+        result.roots[i] = std::abs(fa[k]) < std::abs(fb[k]) ? a[k] : b[k];
+        result.status[i] = RootStatus::MaxIterations;
+        result.iterations[i] = options.max_iter;
+    }
+}
+
+double max_norm(const std::vector<double>& v) {
+    double m = 0.0;
+    for (double vi : v) m = std::max(m, std::abs(vi));
+    return m;
+}
+
+double squared_norm(const std::vector<double>& v) {
+    double s = 0.0;
+    for (double vi : v) s += vi * vi;
+    return s;
+}
+
+double dot(const std::vector<double>& a, const std::vector<double>& b) {
+    double s = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) s += a[i] * b[i];
+    return s;
+}
+
+// Wspólny stan solverów: licznik wywołań F, jakobian (użytkownika lub numeryczny) i rozkład LU.
+class NonlinearProblem {
+public:
+    NonlinearProblem(const NonlinearSystem& f, const std::vector<double>& x0,
+                     const NonlinearSystemOptions& options, NonlinearSystemResult& stats)
+        : f_(f), options_(options), stats_(stats), n_(x0.size()) {
+        if (x0.empty()) {
+            throw std::invalid_argument("Wektor poczatkowy x0 nie moze byc pusty.");
+        }
+        if (options.tol <= 0.0) {
+            throw std::invalid_argument("Tolerancja musi byc dodatnia.");
+        }
+        if (options.max_iter <= 0) {
+            throw std::invalid_argument("Maksymalna liczba iteracji musi byc dodatnia.");
+        }
+        if (options.jacobian_reuse_ratio < 0.0 || options.jacobian_reuse_ratio >= 1.0) {
+            throw std::invalid_argument("Wspolczynnik ponownego uzycia jakobianu musi nalezec do [0, 1).");
+        }
+        if (options.max_broyden_updates < 0) {
+            throw std::invalid_argument("Liczba poprawek Broydena nie moze byc ujemna.");
+        }
+        if (!options.sparsity.empty() && options.sparsity.size() != n_) {
+            throw std::invalid_argument("Wzorzec rzadkosci musi miec n wierszy.");
+        }
+    }
+
+    std::vector<double> eval(const std::vector<double>& x) {
+        ++stats_.function_evaluations;
+        std::vector<double> fx = f_(x);
+        if (fx.size() != n_) {
+            throw std::invalid_argument("Funkcja F musi zwracac wektor o rozmiarze x.");
+        }
+        return fx;
+    }
+
+    // Oblicza jakobian w punkcie x i jego rozkład LU
+    void factor(const std::vector<double>& x) {
+        std::vector<std::vector<double>> J;
+        if (options_.jacobian) {
+            J = options_.jacobian(x);
+            if (J.size() != n_) {
+                throw std::invalid_argument("Jakobian uzytkownika musi miec rozmiar n x n.");
+            }
+        } else {
+            const double h = std::cbrt(std::numeric_limits<double>::epsilon());
+            auto counted = [this](const std::vector<double>& v) { return eval(v); };
+            J = options_.sparsity.empty() ? numerical_jacobian(counted, x, h)
+                                          : numerical_jacobian(counted, x, h, options_.sparsity);
+        }
+        ++stats_.jacobian_evaluations;
+        lu_ = lu_decompose(J); // Sprawdza kwadratowość i osobliwość
+        ++stats_.lu_decompositions;
+    }
+
+    const LUDecomposition& lu() const { return lu_; }
+
+private:
+    const NonlinearSystem& f_;
+    const NonlinearSystemOptions& options_;
+    NonlinearSystemResult& stats_;
+    size_t n_;
+    LUDecomposition lu_;
+};
+
+// Przeszukiwanie liniowe wzdłuż p: szuka lambda w (0, 1] spełniającej warunek Armijo
+// ||F(x + lambda p)||^2 <= (1 - 2 alpha lambda) ||F(x)||^2. Zwraca lambda lub 0 przy niepowodzeniu.
+double line_search(NonlinearProblem& problem, const std::vector<double>& x, const std::vector<double>& fx,
+                   const std::vector<double>& p, std::vector<double>& x_new, std::vector<double>& f_new) {
+    const double alpha = 1e-4;
+    const double min_lambda = 1e-10;
+    const double phi0 = squared_norm(fx);
+    double lambda = 1.0;
+    for (;;) {
+        for (size_t i = 0; i < x.size(); ++i) x_new[i] = x[i] + lambda * p[i];
+        f_new = problem.eval(x_new);
+        const double phi = squared_norm(f_new);
+        if (phi <= (1.0 - 2.0 * alpha * lambda) * phi0) { // Fałsz także dla NaN
+            return lambda;
+        }
+        if (lambda < min_lambda) {
+            return 0.0;
+        }
+        // Minimum paraboli przez phi(0), phi'(0) = -2 phi0 i phi(lambda), ograniczone do [0.1, 0.5] lambda
+        double next = 0.1 * lambda;
+        if (std::isfinite(phi)) {
+            next = phi0 * lambda * lambda / (phi - phi0 + 2.0 * phi0 * lambda);
+        }
+        lambda = std::min(0.5 * lambda, std::max(0.1 * lambda, next));
+    }
+}
+
+bool step_converged(const std::vector<double>& x, const std::vector<double>& p, double lambda, double tol) {
+    return lambda == 1.0 && max_norm(p) < tol * (1.0 + max_norm(x));
+}
+
+} // namespace
+
+BatchRootResult chandrupatla_batch(const BatchRootFunction& f, const std::vector<double>& lower,
+                                   const std::vector<double>& upper, const BatchRootOptions& options) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("chandrupatla_batch");
+    if (lower.size() != upper.size()) {
+        throw std::invalid_argument("Wektory lower i upper musza miec ten sam rozmiar.");
+    }
+    if (options.tol <= 0.0) {
         throw std::invalid_argument("Tolerancja musi byc dodatnia.");
     }
-    if (max_iter <= 0) {
+    if (options.max_iter <= 0) {
         throw std::invalid_argument("Maksymalna liczba iteracji musi byc dodatnia.");
     }
-    if (std::abs(x0 - x1) < std::numeric_limits<double>::epsilon()) {
-         throw std::invalid_argument("Poczatkowe przyblizenia x0 i x1 musza byc rozne.");
+    if (options.block_size == 0) {
+        throw std::invalid_argument("Rozmiar bloku musi byc dodatni.");
+    }
+
+    const std::size_t n = lower.size();
+    BatchRootResult result;
+    result.roots.resize(n);
+    result.status.resize(n, RootStatus::Converged);
+    result.iterations.resize(n, 0);
+
+    ThreadPool::global().parallel_for(0, n, options.block_size, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t first = lo; first < hi; first += options.block_size) {
+            chandrupatla_block(f, lower, upper, options, first, std::min(options.block_size, hi - first), result);
+        }
+    });
+#if NUMLIBCPP_INSTRUMENTATION
+    // Liczniki zbierane w wątku wywołującym: bloki wykonywane w puli nie mają aktywnego zakresu
+    std::uint64_t lane_iterations = 0;
+    for (int it : result.iterations) lane_iterations += static_cast<std::uint64_t>(it);
+    NUMLIBCPP_COUNT(iterations, lane_iterations);
+#endif
+    return result;
+}
+
+NonlinearSystemResult newton_system(const NonlinearSystem& f, const std::vector<double>& x0,
+                                    const NonlinearSystemOptions& options) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("newton_system");
+    NonlinearSystemResult result;
+    NonlinearProblem problem(f, x0, options, result);
+    const size_t n = x0.size();
+
+    std::vector<double> x = x0;
+    std::vector<double> fx = problem.eval(x);
+    std::vector<double> x_new(n), f_new(n), p(n);
+    double residual = max_norm(fx);
+    bool have_lu = false;
+    bool fresh = false; // Czy rozkład LU pochodzi z bieżącego punktu
+
+    while (residual >= options.tol) {
+        if (result.iterations == options.max_iter) {
+            throw std::runtime_error("Metoda Newtona nie zbiegla w maksymalnej liczbie iteracji.");
+        }
+        ++result.iterations;
+        if (!have_lu) {
+            problem.factor(x);
+            have_lu = fresh = true;
+        }
+
+        for (size_t i = 0; i < n; ++i) p[i] = -fx[i];
+        p = lu_solve(problem.lu(), p);
+
+        const double lambda = line_search(problem, x, fx, p, x_new, f_new);
+        if (lambda == 0.0) {
+            if (fresh) {
+                throw std::runtime_error("Przeszukiwanie liniowe nie znalazlo kroku zmniejszajacego residuum.");
+            }
+            have_lu = false; // Kierunek z nieaktualnego jakobianu - ponów ze świeżym
+            continue;
+        }
+
+        const double new_residual = max_norm(f_new);
+        const bool small_step = step_converged(x, p, lambda, options.tol);
+        const bool contracted = lambda == 1.0 && new_residual <= options.jacobian_reuse_ratio * residual;
+        x.swap(x_new);
+        fx.swap(f_new);
+        residual = new_residual;
+        if (small_step) {
+            break;
+        }
+        fresh = false;
+        have_lu = contracted;
     }
 
+    result.x = std::move(x);
+    result.residual_norm = residual;
+    NUMLIBCPP_COUNT(iterations, result.iterations);
+    NUMLIBCPP_COUNT(function_evaluations, result.function_evaluations);
+    return result;
+}
+
+NonlinearSystemResult broyden_system(const NonlinearSystem& f, const std::vector<double>& x0,
+                                     const NonlinearSystemOptions& options) {
+    NUMLIBCPP_INSTRUMENT_SCOPE("broyden_system");
+    NonlinearSystemResult result;
+    NonlinearProblem problem(f, x0, options, result);
+    const size_t n = x0.size();
 
-    double fx0 = func(x0);
-    double fx1 = func(x1);
+    std::vector<double> x = x0;
+    std::vector<double> fx = problem.eval(x);
+    std::vector<double> x_new(n), f_new(n), p(n);
+    double residual = max_norm(fx);
+    bool have_lu = false;
+    bool fresh = false;
 
-    for (int i = 0; i < max_iter; ++i) {
-        if (std::abs(fx1 - fx0) < std::numeric_limits<double>::epsilon() * 100) { // Mnożnik dla bezpieczeństwa
-            // To może oznaczać, że f(x1) i f(x0) są bardzo blisko,
-            // co może prowadzić do dzielenia przez bardzo małą liczbę, lub
-            // że znaleźliśmy płaski region funkcji.
-            // Jeśli fx1 jest bliskie 0, to x1 jest prawdopodobnie pierwiastkiem.
-            if (std::abs(fx1) < tol) return x1;
-            throw std::runtime_error("Dzielenie przez wartosc bliska zeru (fx1 - fx0). Funkcja moze byc plaska w poblizu przyblizen.");
+    // Poprawki rzędu 1: H_k = (I + a_{k-1} s_{k-1}^T) ... (I + a_0 s_0^T) J_0^{-1}
+    std::vector<std::vector<double>> a_vectors, s_vectors;
+    auto apply_inverse = [&](std::vector<double> v) {
+        v = lu_solve(problem.lu(), std::move(v));
+        for (size_t k = 0; k < a_vectors.size(); ++k) {
+            const double coeff = dot(s_vectors[k], v);
+            for (size_t i = 0; i < n; ++i) v[i] += coeff * a_vectors[k][i];
+        }
+        return v;
+    };
+
+    while (residual >= options.tol) {
+        if (result.iterations == options.max_iter) {
+            throw std::runtime_error("Metoda Broydena nie zbiegla w maksymalnej liczbie iteracji.");
+        }
+        ++result.iterations;
+        if (!have_lu) {
+            problem.factor(x);
+            a_vectors.clear();
+            s_vectors.clear();
+            have_lu = fresh = true;
         }
 
-        double x_next = x1 - fx1 * (x1 - x0) / (fx1 - fx0);
+        for (size_t i = 0; i < n; ++i) p[i] = -fx[i];
+        p = apply_inverse(p);
 
-        if (std::abs(x_next - x1) < tol || std::abs(func(x_next)) < tol) {
-            return x_next;
+        const double lambda = line_search(problem, x, fx, p, x_new, f_new);
+        if (lambda == 0.0) {
+            if (fresh) {
+                throw std::runtime_error("Przeszukiwanie liniowe nie znalazlo kroku zmniejszajacego residuum.");
+            }
+            have_lu = false;
+            continue;
         }
 
-        x0 = x1;
-        fx0 = fx1;
-        x1 = x_next;
-        fx1 = func(x1);
+        const bool small_step = step_converged(x, p, lambda, options.tol);
+        std::vector<double> s(n), y(n);
+        for (size_t i = 0; i < n; ++i) {
+            s[i] = x_new[i] - x[i];
+            y[i] = f_new[i] - fx[i];
+        }
+        x.swap(x_new);
+        fx.swap(f_new);
+        residual = max_norm(fx);
+        if (small_step || residual < options.tol) {
+            break;
+        }
+        fresh = false;
+
+        if (static_cast<int>(a_vectors.size()) >= options.max_broyden_updates) {
+            have_lu = false;
+            continue;
+        }
+        // a = (s - H y) / (s^T H y); przy s^T H y bliskim zeru poprawka jest niestabilna
+        std::vector<double> hy = apply_inverse(y);
+        const double denom = dot(s, hy);
+        if (std::abs(denom) <= 1e3 * std::numeric_limits<double>::epsilon() * std::sqrt(squared_norm(s) * squared_norm(hy))) {
+            have_lu = false;
+            continue;
+        }
+        std::vector<double> a(n);
+        for (size_t i = 0; i < n; ++i) a[i] = (s[i] - hy[i]) / denom;
+        a_vectors.push_back(std::move(a));
+        s_vectors.push_back(std::move(s));
     }
 
-    throw std::runtime_error("Metoda siecznych nie zbiegla w maksymalnej liczbie iteracji.");
+    result.x = std::move(x);
+    result.residual_norm = residual;
+    NUMLIBCPP_COUNT(iterations, result.iterations);
+    NUMLIBCPP_COUNT(function_evaluations, result.function_evaluations);
+    return result;
 }
 
-} // namespace NumLibCpp
\ No newline at end of file
+} // namespace NumLibCpp
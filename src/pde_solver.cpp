@@ -0,0 +1,300 @@
+#include "NumLibCpp/pde_solver.hpp"
+#include "NumLibCpp/linear_solver.hpp"   // Dla tridiagonal_decompose, tridiagonal_solve
+#include "NumLibCpp/runge_kutta.hpp"     // Dla explicit_rk_solve_system
+#include "NumLibCpp/thread_pool.hpp"     // Dla ThreadPool::global
+#include <algorithm> // Dla std::min, std::max
+#include <cmath>     // Dla std::abs
+
+namespace NumLibCpp {
+
+namespace {
+
+// Obszar stabilności RK4 na ujemnej półosi rzeczywistej: |h * lambda| <= ~2.785
+constexpr double rk4_stability_limit = 2.78;
+// Bloki pętli stencila: wiersze na zadanie puli i szerokość kafelka kolumn (3 wiersze kafelka mieszczą się w L1)
+constexpr std::size_t rows_per_task = 16;
+constexpr std::size_t column_tile = 512;
+// Liczba kolumn rozwiązywanych razem w półkroku ADI wzdłuż y
+constexpr std::size_t columns_per_task = 64;
+
+// Trójdiagonalny operator d^2/dx^2 (z warunkami brzegowymi) wzdłuż jednej osi: (A u)_i + source_i
+struct AxisOperator {
+    std::vector<double> lower, diag, upper, source;
+    bool fixed_lo = false, fixed_hi = false;
+    double spectral_bound = 0.0; // Oszacowanie Gerszgorina promienia spektralnego A
+};
+
+void validate_boundary(const BoundaryCondition& bc) {
+    if (bc.type == BoundaryType::Robin && bc.coefficient < 0.0) {
+        throw std::invalid_argument("Wspolczynnik warunku Robina musi byc nieujemny.");
+    }
+}
+
+AxisOperator build_axis_operator(std::size_t n, double length, double alpha,
+                                 const BoundaryCondition& lo, const BoundaryCondition& hi) {
+    if (n < 3) {
+        throw std::invalid_argument("Siatka musi miec co najmniej 3 wezly w kazdym kierunku.");
+    }
+    if (length <= 0.0) {
+        throw std::invalid_argument("Wymiary obszaru musza byc dodatnie.");
+    }
+    validate_boundary(lo);
+    validate_boundary(hi);
+
+    const double d = length / (n - 1);
+    const double k = alpha / (d * d);
+    AxisOperator op;
+    op.lower.assign(n, k);
+    op.diag.assign(n, -2.0 * k);
+    op.upper.assign(n, k);
+    op.source.assign(n, 0.0);
+    op.lower[0] = 0.0;
+    op.upper[n - 1] = 0.0;
+
+    // Węzeł fikcyjny: u_{-1} = u_1 + 2d (g - c u_0), analogicznie na drugim końcu
+    auto apply = [&](const BoundaryCondition& bc, std::size_t i, double& inner, bool& fixed) {
+        if (bc.type == BoundaryType::Dirichlet) {
+            fixed = true;
+            op.lower[i] = op.diag[i] = op.upper[i] = 0.0;
+            return;
+        }
+        double c = bc.type == BoundaryType::Robin ? bc.coefficient : 0.0;
+        inner = 2.0 * k;
+        op.diag[i] = -2.0 * k * (1.0 + d * c);
+        op.source[i] = 2.0 * k * d * bc.value;
+    };
+    apply(lo, 0, op.upper[0], op.fixed_lo);
+    apply(hi, n - 1, op.lower[n - 1], op.fixed_hi);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        op.spectral_bound = std::max(op.spectral_bound,
+                                     std::abs(op.lower[i]) + std::abs(op.diag[i]) + std::abs(op.upper[i]));
+    }
+    return op;
+}
+
+// Rozkład macierzy I - theta * A
+TridiagonalDecomposition decompose_shifted(const AxisOperator& op, double theta) {
+    const std::size_t n = op.diag.size();
+    std::vector<double> lower(n), diag(n), upper(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        lower[i] = -theta * op.lower[i];
+        diag[i] = 1.0 - theta * op.diag[i];
+        upper[i] = -theta * op.upper[i];
+    }
+    return tridiagonal_decompose(lower, diag, upper);
+}
+
+void validate_time_arguments(double t_end, int num_steps, double diffusivity) {
+    if (num_steps <= 0) {
+        throw std::invalid_argument("Liczba krokow musi byc dodatnia.");
+    }
+    if (t_end < 0.0) {
+        throw std::invalid_argument("Czas koncowy nie moze byc ujemny.");
+    }
+    if (diffusivity <= 0.0) {
+        throw std::invalid_argument("Wspolczynnik dyfuzji musi byc dodatni.");
+    }
+}
+
+void check_explicit_stability(double dt, double spectral_bound) {
+    if (dt * spectral_bound > rk4_stability_limit) {
+        throw std::invalid_argument("Krok czasowy jest za duzy dla jawnego RK4 (warunek stabilnosci). "
+                                    "Zwieksz liczbe krokow lub uzyj schematu Cranka-Nicolson.");
+    }
+}
+
+} // namespace
+
+std::vector<double> solve_heat_1d(const HeatProblem1D& problem, const std::vector<double>& u0,
+                                  double t_end, int num_steps, TimeScheme scheme) {
+    validate_time_arguments(t_end, num_steps, problem.diffusivity);
+    const std::size_t n = problem.nodes;
+    AxisOperator op = build_axis_operator(n, problem.length, problem.diffusivity, problem.left, problem.right);
+    if (u0.size() != n) {
+        throw std::invalid_argument("Rozmiar warunku poczatkowego musi byc rowny liczbie wezlow.");
+    }
+
+    std::vector<double> u(u0);
+    if (op.fixed_lo) u[0] = problem.left.value;
+    if (op.fixed_hi) u[n - 1] = problem.right.value;
+    const double dt = t_end / num_steps;
+
+    // du/dt = A u + source (wiersze węzłów Dirichleta są zerowe, więc te węzły się nie zmieniają)
+    auto apply = [&op, n](const std::vector<double>& v, std::vector<double>& out) {
+        out[0] = op.diag[0] * v[0] + op.upper[0] * v[1] + op.source[0];
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            out[i] = op.lower[i] * v[i - 1] + op.diag[i] * v[i] + op.upper[i] * v[i + 1] + op.source[i];
+        }
+        out[n - 1] = op.lower[n - 1] * v[n - 2] + op.diag[n - 1] * v[n - 1] + op.source[n - 1];
+    };
+
+    if (scheme == TimeScheme::ExplicitRK4) {
+        check_explicit_stability(dt, op.spectral_bound);
+        return explicit_rk_solve_system<rk::Classic4>(
+            [&apply](double, const std::vector<double>& v, std::vector<double>& dvdt) { apply(v, dvdt); },
+            0.0, std::move(u), t_end, num_steps);
+    }
+
+    // Crank-Nicolson: (I - dt/2 A) u^{n+1} = u^n + dt/2 A u^n + dt * source
+    TridiagonalDecomposition lhs = decompose_shifted(op, 0.5 * dt);
+    std::vector<double> Au(n), rhs(n);
+    for (int step = 0; step < num_steps; ++step) {
+        apply(u, Au); // Zawiera już source
+        for (std::size_t i = 0; i < n; ++i) {
+            rhs[i] = u[i] + 0.5 * dt * Au[i] + 0.5 * dt * op.source[i];
+        }
+        u = tridiagonal_solve(lhs, rhs);
+    }
+    return u;
+}
+
+std::vector<double> solve_heat_2d(const HeatProblem2D& problem, const std::vector<double>& u0,
+                                  double t_end, int num_steps, TimeScheme scheme) {
+    validate_time_arguments(t_end, num_steps, problem.diffusivity);
+    const std::size_t nx = problem.nodes_x;
+    const std::size_t ny = problem.nodes_y;
+    AxisOperator ax = build_axis_operator(nx, problem.length_x, problem.diffusivity, problem.left, problem.right);
+    AxisOperator ay = build_axis_operator(ny, problem.length_y, problem.diffusivity, problem.bottom, problem.top);
+    if (u0.size() != nx * ny) {
+        throw std::invalid_argument("Rozmiar warunku poczatkowego musi byc rowny nodes_x * nodes_y.");
+    }
+
+    // Maska węzłów swobodnych (1) i ustalonych warunkiem Dirichleta (0); Dirichlet w x ma pierwszeństwo w narożnikach
+    std::vector<double> u(u0);
+    std::vector<double> free_mask(nx * ny, 1.0);
+    for (std::size_t j = 0; j < ny; ++j) {
+        for (std::size_t i = 0; i < nx; ++i) {
+            const std::size_t idx = j * nx + i;
+            if ((i == 0 && ax.fixed_lo) || (i == nx - 1 && ax.fixed_hi)) {
+                free_mask[idx] = 0.0;
+                u[idx] = (i == 0 && ax.fixed_lo) ? problem.left.value : problem.right.value;
+            } else if ((j == 0 && ay.fixed_lo) || (j == ny - 1 && ay.fixed_hi)) {
+                free_mask[idx] = 0.0;
+                u[idx] = (j == 0 && ay.fixed_lo) ? problem.bottom.value : problem.top.value;
+            }
+        }
+    }
+    const double dt = t_end / num_steps;
+    ThreadPool& pool = ThreadPool::global();
+
+    // out = free * (wx * (Ax v + bx) + wy * (Ay v + by)) + keep * v, liczone w blokach wierszy i kafelkach kolumn
+    auto stencil = [&](const std::vector<double>& v, std::vector<double>& out, double wx, double wy, double keep) {
+        pool.parallel_for(0, ny, rows_per_task, [&](std::size_t j_lo, std::size_t j_hi) {
+            for (std::size_t i_lo = 0; i_lo < nx; i_lo += column_tile) {
+                const std::size_t i_hi = std::min(nx, i_lo + column_tile);
+                for (std::size_t j = j_lo; j < j_hi; ++j) {
+                    const double* row = v.data() + j * nx;
+                    // Brakujący sąsiad ma zerowy współczynnik, więc można podstawić dowolny wiersz
+                    const double* below = j > 0 ? row - nx : row;
+                    const double* above = j + 1 < ny ? row + nx : row;
+                    const double* mask = free_mask.data() + j * nx;
+                    double* o = out.data() + j * nx;
+                    const double cl = wy * ay.lower[j], cd = wy * ay.diag[j], cu = wy * ay.upper[j];
+                    const double sy = wy * ay.source[j];
+
+                    auto node = [&](std::size_t i, double left, double right) {
+                        double value = wx * (ax.lower[i] * left + ax.diag[i] * row[i] + ax.upper[i] * right + ax.source[i])
+                                     + cl * below[i] + cd * row[i] + cu * above[i] + sy;
+                        o[i] = mask[i] * value + keep * row[i];
+                    };
+                    std::size_t i_begin = i_lo;
+                    std::size_t i_end = i_hi;
+                    if (i_begin == 0) {
+                        node(0, 0.0, row[1]);
+                        i_begin = 1;
+                    }
+                    if (i_end == nx) {
+                        i_end = nx - 1;
+                    }
+                    // Wnętrze kafelka bez rozgałęzień (pętla wektoryzowalna)
+                    for (std::size_t i = i_begin; i < i_end; ++i) {
+                        double value = wx * (ax.lower[i] * row[i - 1] + ax.diag[i] * row[i] + ax.upper[i] * row[i + 1] + ax.source[i])
+                                     + cl * below[i] + cd * row[i] + cu * above[i] + sy;
+                        o[i] = mask[i] * value + keep * row[i];
+                    }
+                    if (i_hi == nx) {
+                        node(nx - 1, row[nx - 2], 0.0);
+                    }
+                }
+            }
+        });
+    };
+
+    if (scheme == TimeScheme::ExplicitRK4) {
+        check_explicit_stability(dt, ax.spectral_bound + ay.spectral_bound);
+        return explicit_rk_solve_system<rk::Classic4>(
+            [&stencil](double, const std::vector<double>& v, std::vector<double>& dvdt) {
+                stencil(v, dvdt, 1.0, 1.0, 0.0);
+            },
+            0.0, std::move(u), t_end, num_steps);
+    }
+
+    // ADI Peacemana-Rachforda:
+    //   (I - dt/2 Ax) u*      = (I + dt/2 Ay) u^n + dt/2 (bx + by)
+    //   (I - dt/2 Ay) u^{n+1} = (I + dt/2 Ax) u*  + dt/2 (bx + by)
+    // Człon źródłowy bx + by (warunki Neumanna/Robina) pojawia się w obu półkrokach z wagą dt/2.
+    const double half = 0.5 * dt;
+    TridiagonalDecomposition lhs_x = decompose_shifted(ax, half);
+    TridiagonalDecomposition lhs_y = decompose_shifted(ay, half);
+    std::vector<double> rhs(nx * ny);
+    const std::size_t col_begin = ax.fixed_lo ? 1 : 0;
+    const std::size_t col_end = ax.fixed_hi ? nx - 1 : nx;
+
+    for (int step = 0; step < num_steps; ++step) {
+        // Półkrok 1: jawnie w y, niejawnie w x
+        stencil(u, rhs, 0.0, half, 1.0);
+        pool.parallel_for(0, ny, rows_per_task, [&](std::size_t j_lo, std::size_t j_hi) {
+            for (std::size_t j = j_lo; j < j_hi; ++j) {
+                double* r = rhs.data() + j * nx;
+                double* out = u.data() + j * nx;
+                if ((j == 0 && ay.fixed_lo) || (j == ny - 1 && ay.fixed_hi)) {
+                    std::copy(r, r + nx, out); // Cały wiersz ustalony warunkiem Dirichleta
+                    continue;
+                }
+                for (std::size_t i = 0; i < nx; ++i) {
+                    r[i] += free_mask[j * nx + i] * half * ax.source[i];
+                }
+                // Algorytm Thomasa w miejscu wzdłuż wiersza
+                out[0] = r[0] * lhs_x.inv_denom[0];
+                for (std::size_t i = 1; i < nx; ++i) {
+                    out[i] = (r[i] - lhs_x.lower[i] * out[i - 1]) * lhs_x.inv_denom[i];
+                }
+                for (std::size_t i = nx - 1; i-- > 0;) {
+                    out[i] -= lhs_x.c_prime[i] * out[i + 1];
+                }
+            }
+        });
+
+        // Półkrok 2: jawnie w x, niejawnie w y; kolumny rozwiązywane paczkami (dostęp wierszami)
+        stencil(u, rhs, half, 0.0, 1.0);
+        pool.parallel_for(col_begin, col_end, columns_per_task, [&](std::size_t i_lo, std::size_t i_hi) {
+            for (std::size_t j = 0; j < ny; ++j) {
+                double* r = rhs.data() + j * nx;
+                const double* mask = free_mask.data() + j * nx;
+                const double src = half * ay.source[j];
+                const double* prev = j > 0 ? r - nx : r; // Dla j = 0 współczynnik lower wynosi 0
+                const double lower = lhs_y.lower[j];
+                const double inv = lhs_y.inv_denom[j];
+                for (std::size_t i = i_lo; i < i_hi; ++i) {
+                    r[i] = (r[i] + mask[i] * src - lower * prev[i]) * inv;
+                }
+            }
+            for (std::size_t i = i_lo; i < i_hi; ++i) {
+                u[(ny - 1) * nx + i] = rhs[(ny - 1) * nx + i];
+            }
+            for (std::size_t j = ny - 1; j-- > 0;) {
+                const double cp = lhs_y.c_prime[j];
+                const double* r = rhs.data() + j * nx;
+                double* out = u.data() + j * nx;
+                const double* next = out + nx;
+                for (std::size_t i = i_lo; i < i_hi; ++i) {
+                    out[i] = r[i] - cp * next[i];
+                }
+            }
+        });
+    }
+    return u;
+}
+
+} // namespace NumLibCpp
@@ -0,0 +1,306 @@
+#include "NumLibCpp/thread_pool.hpp"
+#include <algorithm>   // Dla std::stable_partition, std::max
+#include <cerrno>
+#include <cstdlib>     // Dla std::getenv, std::strtol
+#include <fstream>
+#include <sstream>
+#include <stdexcept>   // Dla std::invalid_argument, std::logic_error
+#include <string>
+#include <exception>   // Dla std::exception_ptr
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace NumLibCpp {
+
+namespace {
+// Ustawiane na czas wykonywania zadania puli; zagnieżdżone parallel_for działają wtedy sekwencyjnie.
+thread_local bool inside_pool_task = false;
+
+struct TaskScope {
+    bool previous;
+    TaskScope() : previous(inside_pool_task) { inside_pool_task = true; }
+    ~TaskScope() { inside_pool_task = previous; }
+};
+
+// Parametry globalnej puli; po jej utworzeniu nie mogą być zmienione
+std::mutex global_options_mutex;
+ThreadPoolOptions global_options;
+bool global_configured = false;
+bool global_created = false;
+
+ThreadPoolOptions take_global_options() {
+    std::lock_guard<std::mutex> lock(global_options_mutex);
+    global_created = true;
+    return global_configured ? global_options : ThreadPool::options_from_environment();
+}
+
+#ifdef __linux__
+// Lista procesorów w formacie jądra, np. "0-3,8-11"
+std::vector<int> parse_cpu_list(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        const std::size_t dash = item.find('-');
+        try {
+            const int first = std::stoi(item.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        } catch (const std::exception&) {
+            return {};
+        }
+    }
+    return cpus;
+}
+
+// Procesory każdego węzła NUMA dostępne dla procesu (węzły bez takich procesorów są pomijane)
+std::vector<std::vector<int>> numa_topology() {
+    std::vector<std::vector<int>> nodes;
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return nodes;
+    }
+    // Numery węzłów mogą mieć luki (węzły wyłączone), dlatego sprawdzamy cały typowy zakres
+    for (int node = 0; node < 256; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file) continue;
+        std::string line;
+        std::getline(file, line);
+        std::vector<int> cpus;
+        for (int cpu : parse_cpu_list(line)) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+        }
+        if (!cpus.empty()) nodes.push_back(std::move(cpus));
+    }
+    return nodes;
+}
+#endif
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t num_threads) : ThreadPool(ThreadPoolOptions{num_threads, false}) {}
+
+ThreadPool::ThreadPool(const ThreadPoolOptions& options) {
+    std::size_t num_threads = options.num_threads;
+    if (num_threads == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        num_threads = hw > 1 ? hw - 1 : 0;
+    }
+    // Kolejka o indeksie num_threads należy do wątków wywołujących (nie-roboczych)
+    for (std::size_t i = 0; i <= num_threads; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+        std::vector<std::size_t> order;
+        for (std::size_t k = 0; k <= num_threads; ++k) {
+            order.push_back((i + k) % (num_threads + 1));
+        }
+        steal_order_.push_back(std::move(order));
+    }
+    // Topologia i kolejność kradzieży muszą być gotowe przed startem wątków
+    if (options.numa_affinity && num_threads > 0) {
+        pin_to_numa_nodes();
+    }
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+}
+
+void ThreadPool::pin_to_numa_nodes() {
+#ifdef __linux__
+    const std::vector<std::vector<int>> nodes = numa_topology();
+    if (nodes.empty()) {
+        return;
+    }
+    const std::size_t workers = queues_.size() - 1;
+    // Ciągłe bloki wątków na kolejnych węzłach: sąsiednie kolejki należą do tego samego węzła
+    std::vector<std::size_t> node_of(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        node_of[i] = i * nodes.size() / workers;
+    }
+    for (std::size_t i = 0; i < workers; ++i) {
+        // Kradzież najpierw z kolejek tego samego węzła (kolejność rotacyjna zachowana w obu grupach)
+        std::stable_partition(steal_order_[i].begin(), steal_order_[i].end(), [&](std::size_t q) {
+            return q < workers && node_of[q] == node_of[i];
+        });
+    }
+    node_cpus_ = nodes;
+    worker_node_ = node_of;
+    numa_nodes_ = std::min(nodes.size(), workers);
+#endif
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool(take_global_options());
+    return pool;
+}
+
+void ThreadPool::configure_global(const ThreadPoolOptions& options) {
+    std::lock_guard<std::mutex> lock(global_options_mutex);
+    if (global_created) {
+        throw std::logic_error("Globalna pula watkow zostala juz utworzona.");
+    }
+    global_options = options;
+    global_configured = true;
+}
+
+ThreadPoolOptions ThreadPool::options_from_environment() {
+    ThreadPoolOptions options;
+    const char* env = std::getenv("NUMLIBCPP_NUM_THREADS");
+    if (env == nullptr) {
+        return options;
+    }
+    char* end = nullptr;
+    errno = 0;
+    const long value = std::strtol(env, &end, 10);
+    const long limit = max_threads_per_core * static_cast<long>(std::max(1u, std::thread::hardware_concurrency()));
+    // Wartość nieliczbowa, ujemna lub nierealnie duża - liczba wątków domyślna
+    if (end != env && *end == '\0' && errno != ERANGE && value >= 0 && value <= limit) {
+        options.num_threads = static_cast<std::size_t>(value);
+    }
+    return options;
+}
+
+void ThreadPool::push(Task task) {
+    std::size_t idx = next_queue_.fetch_add(1, std::memory_order_relaxed) % threads_.size();
+    // Licznik rośnie przed umieszczeniem zadania w kolejce, aby dekrementacja w try_pop go nie wyprzedziła
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        ++pending_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[idx]->mutex);
+        queues_[idx]->tasks.push_back(std::move(task));
+    }
+    sleep_cv_.notify_one();
+}
+
+bool ThreadPool::try_pop(std::size_t self, Task& out) {
+    const std::vector<std::size_t>& order = steal_order_[self];
+    // Najpierw własna kolejka (koniec - najświeższe zadanie), potem kradzież z początku cudzych
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        Queue& q = *queues_[order[k]];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) {
+            continue;
+        }
+        if (k == 0) {
+            out = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        } else {
+            out = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+        std::lock_guard<std::mutex> sleep_lock(sleep_mutex_);
+        --pending_;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::worker_loop(std::size_t id) {
+#ifdef __linux__
+    if (!worker_node_.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : node_cpus_[worker_node_[id]]) CPU_SET(cpu, &set);
+        // Niepowodzenie (np. ograniczenia kontenera) nie jest błędem - wątek działa bez przypięcia
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#endif
+    for (;;) {
+        Task task;
+        if (try_pop(id, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [this] { return stop_ || pending_ > 0; });
+        if (stop_ && pending_ == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                              const std::function<void(std::size_t, std::size_t)>& body) {
+    if (grain == 0) {
+        throw std::invalid_argument("Rozmiar fragmentu (grain) musi byc dodatni.");
+    }
+    if (end <= begin) {
+        return;
+    }
+    const std::size_t num_chunks = (end - begin + grain - 1) / grain;
+    if (threads_.empty() || num_chunks == 1 || inside_pool_task) {
+        body(begin, end);
+        return;
+    }
+
+    struct Sync {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t remaining;
+        std::exception_ptr error;
+    };
+    auto sync = std::make_shared<Sync>();
+    sync->remaining = num_chunks;
+
+    for (std::size_t lo = begin; lo < end; lo += grain) {
+        std::size_t hi = (end - lo > grain) ? lo + grain : end;
+        push([sync, &body, lo, hi] {
+            std::exception_ptr error;
+            {
+                TaskScope scope;
+                try {
+                    body(lo, hi);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+            std::lock_guard<std::mutex> lock(sync->mutex);
+            if (error && !sync->error) {
+                sync->error = error;
+            }
+            if (--sync->remaining == 0) {
+                sync->cv.notify_all();
+            }
+        });
+    }
+
+    // Wątek wywołujący pomaga w obliczeniach, zamiast bezczynnie czekać
+    const std::size_t caller_queue = threads_.size();
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(sync->mutex);
+            if (sync->remaining == 0) {
+                break;
+            }
+        }
+        Task task;
+        if (try_pop(caller_queue, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sync->mutex);
+        sync->cv.wait(lock, [&sync] { return sync->remaining == 0; });
+        break;
+    }
+
+    if (sync->error) {
+        std::rethrow_exception(sync->error);
+    }
+}
+
+} // namespace NumLibCpp
@@ -0,0 +1,256 @@
+#include "NumLibCpp/trajectory_writer.hpp"
+#include <cstring> // Dla std::memcpy, std::memcmp
+
+namespace NumLibCpp {
+
+namespace {
+const char trajectory_magic[8] = {'N', 'L', 'T', 'R', 'A', 'J', '\0', '\0'};
+constexpr std::uint32_t trajectory_version = 1;
+constexpr std::size_t trajectory_header_size = 32;
+constexpr std::size_t record_count_offset = 24;
+// Maksymalna liczba buforów oczekujących na zapis; ogranicza zużycie pamięci
+constexpr std::size_t max_buffers_in_flight = 4;
+
+template <typename T>
+void append_value(std::vector<char>& buffer, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+} // namespace
+
+TrajectoryWriter::TrajectoryWriter(const std::string& path, std::size_t state_size,
+                                   TrajectoryPrecision precision, std::size_t buffer_records)
+    : state_size_(state_size), precision_(precision) {
+    if (state_size == 0) {
+        throw std::invalid_argument("Rozmiar stanu musi byc dodatni.");
+    }
+    if (buffer_records == 0) {
+        throw std::invalid_argument("Rozmiar bufora musi byc dodatni.");
+    }
+    record_bytes_ = (state_size + 1) * static_cast<std::size_t>(precision);
+    buffer_bytes_ = record_bytes_ * buffer_records;
+
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        throw std::runtime_error("Nie mozna otworzyc pliku trajektorii: " + path);
+    }
+
+    std::vector<char> header;
+    header.insert(header.end(), trajectory_magic, trajectory_magic + 8);
+    append_value<std::uint32_t>(header, trajectory_version);
+    append_value<std::uint32_t>(header, static_cast<std::uint32_t>(state_size));
+    append_value<std::uint32_t>(header, static_cast<std::uint32_t>(precision));
+    append_value<std::uint32_t>(header, 0);
+    append_value<std::uint64_t>(header, 0); // Liczba rekordów - uzupełniana w close()
+    file_.write(header.data(), static_cast<std::streamsize>(header.size()));
+    if (!file_) {
+        throw std::runtime_error("Blad zapisu naglowka pliku trajektorii: " + path);
+    }
+
+    active_.reserve(buffer_bytes_);
+    thread_ = std::thread([this] { writer_loop(); });
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Destruktor nie może rzucać; błąd jest widoczny tylko przy jawnym close()
+    }
+}
+
+void TrajectoryWriter::write(double x, const double* y) {
+    if (closed_) {
+        throw std::runtime_error("Plik trajektorii zostal juz zamkniety.");
+    }
+    if (precision_ == TrajectoryPrecision::Float32) {
+        append_value<float>(active_, static_cast<float>(x));
+        for (std::size_t i = 0; i < state_size_; ++i) {
+            append_value<float>(active_, static_cast<float>(y[i]));
+        }
+    } else {
+        append_value<double>(active_, x);
+        for (std::size_t i = 0; i < state_size_; ++i) {
+            append_value<double>(active_, y[i]);
+        }
+    }
+    ++records_;
+    if (active_.size() + record_bytes_ > buffer_bytes_) {
+        flush_active();
+    }
+}
+
+void TrajectoryWriter::write(double x, const std::vector<double>& y) {
+    if (y.size() != state_size_) {
+        throw std::invalid_argument("Rozmiar stanu y jest niezgodny z rozmiarem stanu pliku.");
+    }
+    write(x, y.data());
+}
+
+void TrajectoryWriter::write(double x, double y) {
+    if (state_size_ != 1) {
+        throw std::invalid_argument("Zapis skalarny wymaga rozmiaru stanu 1.");
+    }
+    write(x, &y);
+}
+
+void TrajectoryWriter::flush_active() {
+    if (active_.empty()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return buffers_in_flight_ < max_buffers_in_flight || error_; });
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+    full_.push_back(std::move(active_));
+    ++buffers_in_flight_;
+    if (!free_.empty()) {
+        active_ = std::move(free_.back());
+        free_.pop_back();
+    } else {
+        active_ = std::vector<char>();
+        active_.reserve(buffer_bytes_);
+    }
+    lock.unlock();
+    cv_.notify_all();
+}
+
+void TrajectoryWriter::writer_loop() {
+    for (;;) {
+        std::vector<char> buffer;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stop_ || !full_.empty(); });
+            if (full_.empty()) {
+                return;
+            }
+            buffer = std::move(full_.front());
+            full_.pop_front();
+        }
+
+        file_.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        bool failed = !file_;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (failed && !error_) {
+                error_ = std::make_exception_ptr(std::runtime_error("Blad zapisu pliku trajektorii."));
+            }
+            buffer.clear();
+            free_.push_back(std::move(buffer));
+            --buffers_in_flight_;
+        }
+        cv_.notify_all();
+    }
+}
+
+void TrajectoryWriter::rethrow_if_failed() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void TrajectoryWriter::close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+
+    std::exception_ptr flush_error;
+    try {
+        flush_active();
+    } catch (...) {
+        flush_error = std::current_exception();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+
+    if (!flush_error && !error_) {
+        file_.seekp(record_count_offset);
+        char bytes[sizeof(std::uint64_t)];
+        std::memcpy(bytes, &records_, sizeof(records_));
+        file_.write(bytes, sizeof(bytes));
+        file_.flush();
+        if (!file_) {
+            error_ = std::make_exception_ptr(std::runtime_error("Blad zapisu naglowka pliku trajektorii."));
+        }
+    }
+    file_.close();
+
+    if (flush_error) {
+        std::rethrow_exception(flush_error);
+    }
+    rethrow_if_failed();
+}
+
+TrajectoryData read_trajectory(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Nie mozna otworzyc pliku trajektorii: " + path);
+    }
+    const std::streamoff file_size = in.tellg();
+    in.seekg(0);
+
+    char header[trajectory_header_size];
+    if (file_size < static_cast<std::streamoff>(trajectory_header_size) || !in.read(header, sizeof(header))) {
+        throw std::runtime_error("Plik trajektorii jest za krotki.");
+    }
+    if (std::memcmp(header, trajectory_magic, 8) != 0) {
+        throw std::runtime_error("Niepoprawny format pliku trajektorii.");
+    }
+    std::uint32_t version, state_size, width;
+    std::uint64_t count;
+    std::memcpy(&version, header + 8, 4);
+    std::memcpy(&state_size, header + 12, 4);
+    std::memcpy(&width, header + 16, 4);
+    std::memcpy(&count, header + record_count_offset, 8);
+    if (version != trajectory_version || state_size == 0 || (width != 4 && width != 8)) {
+        throw std::runtime_error("Nieobslugiwana wersja lub niepoprawny naglowek pliku trajektorii.");
+    }
+
+    const std::uint64_t record_bytes = static_cast<std::uint64_t>(state_size + 1) * width;
+    const std::uint64_t data_bytes = static_cast<std::uint64_t>(file_size) - trajectory_header_size;
+    if (count == 0) {
+        count = data_bytes / record_bytes; // Plik niezamknięty - liczba rekordów z rozmiaru
+    } else if (count * record_bytes > data_bytes) {
+        throw std::runtime_error("Plik trajektorii jest niekompletny.");
+    }
+
+    TrajectoryData data;
+    data.state_size = state_size;
+    data.precision = static_cast<TrajectoryPrecision>(width);
+    data.x.resize(count);
+    data.y.resize(count * state_size);
+
+    std::vector<char> record(record_bytes);
+    for (std::uint64_t r = 0; r < count; ++r) {
+        if (!in.read(record.data(), static_cast<std::streamsize>(record_bytes))) {
+            throw std::runtime_error("Blad odczytu pliku trajektorii.");
+        }
+        for (std::uint32_t k = 0; k <= state_size; ++k) {
+            double value;
+            if (width == 4) {
+                float v;
+                std::memcpy(&v, record.data() + k * 4, 4);
+                value = v;
+            } else {
+                std::memcpy(&value, record.data() + k * 8, 8);
+            }
+            if (k == 0) {
+                data.x[r] = value;
+            } else {
+                data.y[r * state_size + (k - 1)] = value;
+            }
+        }
+    }
+    return data;
+}
+
+} // namespace NumLibCpp
@@ -0,0 +1,79 @@
+#include "NumLibCpp/workspace.hpp"
+#include "NumLibCpp/instrumentation.hpp"
+#include <algorithm> // Dla std::max
+#include <cstdint>   // Dla std::uintptr_t
+
+namespace NumLibCpp {
+
+namespace {
+constexpr std::size_t min_block_size = 4096;
+} // namespace
+
+Workspace::Workspace(std::size_t initial_bytes) {
+    if (initial_bytes > 0) {
+        blocks_.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[initial_bytes + alignment]), initial_bytes});
+    }
+}
+
+void Workspace::reset() {
+    current_ = 0;
+    offset_ = 0;
+}
+
+std::size_t Workspace::capacity() const {
+    std::size_t total = 0;
+    for (const Block& block : blocks_) {
+        total += block.size;
+    }
+    return total;
+}
+
+std::size_t Workspace::used() const {
+    std::size_t total = offset_;
+    for (std::size_t i = 0; i < current_ && i < blocks_.size(); ++i) {
+        total += blocks_[i].size;
+    }
+    return total;
+}
+
+void* Workspace::try_bump(std::size_t bytes) {
+    if (current_ >= blocks_.size()) {
+        return nullptr;
+    }
+    const Block& block = blocks_[current_];
+    // Początek bloku wyrównujemy w obrębie zapasu `alignment` bajtów zaalokowanego ponad block.size
+    const std::uintptr_t raw = reinterpret_cast<std::uintptr_t>(block.data.get());
+    const std::size_t base = static_cast<std::size_t>((alignment - raw % alignment) % alignment);
+    const std::size_t start = (offset_ + alignment - 1) / alignment * alignment;
+    if (start + bytes > block.size) {
+        return nullptr;
+    }
+    offset_ = start + bytes;
+    return block.data.get() + base + start;
+}
+
+void* Workspace::allocate_bytes(std::size_t bytes) {
+    if (void* p = try_bump(bytes)) {
+        return p;
+    }
+    // Następny istniejący blok (zachowany po wcześniejszych wywołaniach) albo nowy, większy blok
+    std::size_t next = blocks_.empty() ? 0 : current_ + 1;
+    if (next < blocks_.size() && blocks_[next].size >= bytes) {
+        current_ = next;
+        offset_ = 0;
+        return try_bump(bytes);
+    }
+    const std::size_t size = std::max({bytes, 2 * capacity(), min_block_size});
+    Block block{std::unique_ptr<unsigned char[]>(new unsigned char[size + alignment]), size};
+    NUMLIBCPP_COUNT(allocations, 1);
+    if (next < blocks_.size()) {
+        blocks_[next] = std::move(block); // Za mały blok jest zastępowany
+    } else {
+        blocks_.push_back(std::move(block));
+    }
+    current_ = next;
+    offset_ = 0;
+    return try_bump(bytes);
+}
+
+} // namespace NumLibCpp
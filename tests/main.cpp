@@ -8,6 +8,83 @@
 #include "NumLibCpp/differentialEquations_solver.hpp"
 #include "NumLibCpp/nonlinear_solver.hpp"
 #include "NumLibCpp/differentiation.hpp"
+#include "NumLibCpp/thread_pool.hpp"
+#include "NumLibCpp/trajectory_writer.hpp"
+#include "NumLibCpp/runge_kutta.hpp"
+#include "NumLibCpp/pde_solver.hpp"
+#include "NumLibCpp/eigen_solver.hpp"
+#include "NumLibCpp/autodiff.hpp"
+#include "NumLibCpp/finite_difference.hpp"
+#include "NumLibCpp/instrumentation.hpp"
+#include "NumLibCpp/workspace.hpp"
+#include <sstream>
+#include <memory>
+#include <cstdio> // Dla std::remove
+#include <cstdlib> // Dla std::malloc, std::aligned_alloc, std::free
+#include <new>
+#include <atomic>
+
+// Licznik alokacji na stercie (globalne operatory new/delete programu testowego) - testy pracy bez alokacji.
+// Zastępowany jest pełny zestaw, łącznie z wersjami nothrow, tablicowymi i wyrównanymi (std::align_val_t),
+// tak aby każda pamięć z dowolnego operatora new była zwalniana przez std::free (w counted_free).
+static std::atomic<std::size_t> heap_allocations{0};
+
+static void* counted_malloc(std::size_t size) noexcept {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+static void* counted_aligned_alloc(std::size_t size, std::align_val_t alignment) noexcept {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    // std::aligned_alloc wymaga rozmiaru będącego wielokrotnością wyrównania
+    return std::aligned_alloc(align, ((size ? size : 1) + align - 1) / align * align);
+}
+// Jedno, niewstawiane miejsce zwalniania dla wszystkich operatorów delete; po wstawieniu GCC widzi
+// std::free na wskaźniku z operatora new i zgłasza fałszywe -Wmismatched-new-delete
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+static void counted_free(void* p) noexcept {
+    std::free(p);
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = counted_malloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = counted_malloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_malloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_malloc(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* p = counted_aligned_alloc(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* p = counted_aligned_alloc(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_aligned_alloc(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_aligned_alloc(size, alignment);
+}
+
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_free(p); }
 
 // --- 1. Testy algebry liniowej ---
 void test_linear_algebra() {
@@ -25,6 +102,47 @@ void test_linear_algebra() {
     std::vector<double> b2 = {2, 3};
     ASSERT_THROW(NumLibCpp::gauss_elimination(A2, b2), std::runtime_error);
     std::cout << "  gauss_elimination (singular matrix): PASSED" << std::endl;
+
+    // Rozkład LU użyty dla dwóch prawych stron
+    NumLibCpp::LUDecomposition lu = NumLibCpp::lu_decompose(A1);
+    std::vector<double> x_lu = NumLibCpp::lu_solve(lu, b1);
+    ASSERT_NEAR(x_lu[0], 2.0, 1e-9);
+    ASSERT_NEAR(x_lu[1], 3.0, 1e-9);
+    ASSERT_NEAR(x_lu[2], -1.0, 1e-9);
+    std::vector<double> x_lu2 = NumLibCpp::lu_solve(lu, {1, 0, 0});
+    std::vector<double> x_gauss2 = NumLibCpp::gauss_elimination(A1, {1, 0, 0});
+    for (size_t i = 0; i < 3; ++i) ASSERT_NEAR(x_lu2[i], x_gauss2[i], 1e-12);
+    std::cout << "  lu_decompose/lu_solve (correct): PASSED" << std::endl;
+
+    ASSERT_THROW(NumLibCpp::lu_decompose(A2), std::runtime_error);
+    ASSERT_THROW(NumLibCpp::lu_solve(lu, {1.0, 2.0}), std::invalid_argument);
+    std::cout << "  lu_decompose/lu_solve (invalid input): PASSED" << std::endl;
+
+    // Układ trójdiagonalny -u'' = 1 porównany z eliminacją Gaussa
+    auto tri = NumLibCpp::tridiagonal_decompose({0, -1, -1, -1}, {2, 2, 2, 2}, {-1, -1, -1, 0});
+    std::vector<double> x_tri = NumLibCpp::tridiagonal_solve(tri, {1, 1, 1, 1});
+    std::vector<double> x_tri_ref = NumLibCpp::gauss_elimination(
+        {{2, -1, 0, 0}, {-1, 2, -1, 0}, {0, -1, 2, -1}, {0, 0, -1, 2}}, {1, 1, 1, 1});
+    for (size_t i = 0; i < 4; ++i) ASSERT_NEAR(x_tri[i], x_tri_ref[i], 1e-12);
+    std::cout << "  tridiagonal_solve (correct): PASSED" << std::endl;
+
+    ASSERT_THROW(NumLibCpp::tridiagonal_decompose({0, 1}, {0, 1}, {1, 0}), std::runtime_error);
+    ASSERT_THROW(NumLibCpp::tridiagonal_solve(tri, {1, 1}), std::invalid_argument);
+    std::cout << "  tridiagonal_solve (invalid input): PASSED" << std::endl;
+
+    // Równoległa eliminacja: każdy wiersz liczony w tej samej kolejności - wynik identyczny
+    const int n_big = 120;
+    std::vector<std::vector<double>> A_big(n_big, std::vector<double>(n_big));
+    std::vector<double> b_big(n_big);
+    for (int i = 0; i < n_big; ++i) {
+        for (int j = 0; j < n_big; ++j) A_big[i][j] = std::sin(1.0 + i * 0.7 + j * 1.3);
+        A_big[i][i] += n_big;
+        b_big[i] = std::cos(0.1 * i);
+    }
+    std::vector<double> x_seq = NumLibCpp::gauss_elimination(A_big, b_big);
+    ASSERT_TRUE(NumLibCpp::gauss_elimination(A_big, b_big, NumLibCpp::ExecutionPolicy::Parallel) == x_seq);
+    ASSERT_TRUE(NumLibCpp::gauss_elimination(A_big, b_big, NumLibCpp::ExecutionPolicy::ParallelSimd) == x_seq);
+    std::cout << "  gauss_elimination (execution policies): PASSED" << std::endl;
 }
 
 // --- 2. Testy interpolacji ---
@@ -41,6 +159,25 @@ void test_interpolation() {
     std::vector<double> y2 = {0.0, 1.0, 2.0};
     ASSERT_THROW(NumLibCpp::lagrange_interpolate(x2, y2, 0.5), std::invalid_argument);
     std::cout << "  lagrange_interpolate (mismatched sizes): PASSED" << std::endl;
+
+    // Wersja wsadowa: zgodna z punktową, dokładna w węzłach, niezależna od sposobu wykonania
+    std::vector<double> x_cheb(20), y_cheb(20);
+    for (int i = 0; i < 20; ++i) {
+        x_cheb[i] = std::cos(M_PI * (2.0 * i + 1.0) / 40.0);
+        y_cheb[i] = std::exp(x_cheb[i]);
+    }
+    std::vector<double> points(5003);
+    for (std::size_t i = 0; i < points.size(); ++i) points[i] = -1.0 + 2.0 * i / (points.size() - 1);
+    points[17] = x_cheb[3];
+    std::vector<double> batch = NumLibCpp::lagrange_interpolate(x_cheb, y_cheb, points);
+    for (std::size_t i = 0; i < points.size(); i += 101) {
+        ASSERT_NEAR(batch[i], NumLibCpp::lagrange_interpolate(x_cheb, y_cheb, points[i]), 1e-12);
+    }
+    ASSERT_TRUE(batch[17] == y_cheb[3]);
+    ASSERT_TRUE(NumLibCpp::lagrange_interpolate(x_cheb, y_cheb, points, NumLibCpp::ExecutionPolicy::Parallel) == batch);
+    ASSERT_TRUE(NumLibCpp::lagrange_interpolate(x_cheb, y_cheb, points, NumLibCpp::ExecutionPolicy::ParallelSimd) == batch);
+    ASSERT_THROW(NumLibCpp::lagrange_interpolate(x2, y2, points), std::invalid_argument);
+    std::cout << "  lagrange_interpolate (batch): PASSED" << std::endl;
 }
 
 // --- 3. Testy aproksymacji ---
@@ -54,6 +191,17 @@ void test_approximation() {
     // Błędny przypadek (niepoprawne argumenty)
     ASSERT_THROW(NumLibCpp::polynomial_approximation(func, 0.0, 1.0, -1, 100), std::invalid_argument);
     std::cout << "  polynomial_approximation (invalid args): PASSED" << std::endl;
+
+    // Całki rozdzielone między wątki; w trybie Parallel każda całka liczona sekwencyjnie
+    auto f_exp = [](double x) { return std::exp(x); };
+    std::vector<double> c_seq = NumLibCpp::polynomial_approximation(f_exp, -1.0, 1.0, 6, 10000);
+    ASSERT_TRUE(NumLibCpp::polynomial_approximation(f_exp, -1.0, 1.0, 6, 10000, NumLibCpp::ExecutionPolicy::Parallel) == c_seq);
+    std::vector<double> c_simd =
+        NumLibCpp::polynomial_approximation(f_exp, -1.0, 1.0, 6, 10000, NumLibCpp::ExecutionPolicy::ParallelSimd);
+    for (size_t i = 0; i < c_seq.size(); ++i) ASSERT_NEAR(c_simd[i], c_seq[i], 1e-8);
+    ASSERT_THROW(NumLibCpp::polynomial_approximation(f_exp, -1.0, 1.0, 2, 99, NumLibCpp::ExecutionPolicy::Parallel),
+                 std::invalid_argument);
+    std::cout << "  polynomial_approximation (execution policies): PASSED" << std::endl;
 }
 
 // --- 4. Testy całkowania ---
@@ -67,6 +215,52 @@ void test_integration() {
     // Błędny przypadek (nieparzysta liczba przedziałów)
     ASSERT_THROW(NumLibCpp::simpson_integrate(func, 0.0, 1.0, 99), std::invalid_argument);
     std::cout << "  simpson_integrate (odd intervals): PASSED" << std::endl;
+
+    // Przeciążenia szablonowe: te same wyniki co wersje z std::function, bez kopiowania obiektu funkcji
+    std::function<double(double)> wrapped = [](double x) { return std::exp(-x * x); };
+    auto direct = [](double x) { return std::exp(-x * x); };
+    ASSERT_TRUE(NumLibCpp::simpson_integrate(direct, 0.0, 2.0, 200) == NumLibCpp::simpson_integrate(wrapped, 0.0, 2.0, 200));
+    ASSERT_TRUE(NumLibCpp::simpson_integrate(direct, 2.0, 0.0, 200) == NumLibCpp::simpson_integrate(wrapped, 2.0, 0.0, 200));
+    ASSERT_TRUE(NumLibCpp::central_difference(direct, 0.3, 1e-5) == NumLibCpp::central_difference(wrapped, 0.3, 1e-5));
+    ASSERT_TRUE(NumLibCpp::polynomial_approximation(direct, -1.0, 1.0, 4, 100) ==
+                NumLibCpp::polynomial_approximation(wrapped, -1.0, 1.0, 4, 100));
+    struct CountingFunction {
+        int calls = 0;
+        double operator()(double x) { ++calls; return x * x; }
+    } counting;
+    NumLibCpp::simpson_integrate(counting, 0.0, 1.0, 10);
+    ASSERT_TRUE(counting.calls == 11);
+    auto move_only = [scale = std::make_unique<double>(2.0)](double x) { return *scale * x; };
+    ASSERT_NEAR(NumLibCpp::simpson_integrate(move_only, 0.0, 1.0, 10), 1.0, 1e-14);
+    int evals_template = 0, evals_function = 0;
+    double r_template = NumLibCpp::brent_method([](double x) { return x * x * x - 2.0; }, 0.0, 2.0, 1e-12, 100, evals_template);
+    double r_function = NumLibCpp::brent_method(std::function<double(double)>([](double x) { return x * x * x - 2.0; }),
+                                                0.0, 2.0, 1e-12, 100, evals_function);
+    ASSERT_TRUE(r_template == r_function && evals_template == evals_function);
+    auto cubic = [](double x) { return x * x * x - 2.0; };
+    ASSERT_TRUE(NumLibCpp::secant_method(cubic, 1.0, 2.0, 1e-12, 100) ==
+                NumLibCpp::secant_method(std::function<double(double)>(cubic), 1.0, 2.0, 1e-12, 100));
+    auto rhs = [](double x, double y) { return -2.0 * x * y; };
+    std::function<double(double, double)> rhs_wrapped = rhs;
+    ASSERT_TRUE(NumLibCpp::rk4_solve(rhs, 0.0, 1.0, 1.0, 50) == NumLibCpp::rk4_solve(rhs_wrapped, 0.0, 1.0, 1.0, 50));
+    int observed = 0;
+    NumLibCpp::rk4_solve(rhs, 0.0, 1.0, 1.0, 50, [&observed](double, double) { ++observed; });
+    ASSERT_TRUE(observed == 51);
+    std::cout << "  template callable overloads: PASSED" << std::endl;
+
+    // Tryby równoległe: stały podział na fragmenty, wynik równy sekwencyjnemu z dokładnością do zaokrągleń
+    const int n_fine = 100002;
+    double seq = NumLibCpp::simpson_integrate(direct, 0.0, 2.0, n_fine);
+    double par = NumLibCpp::simpson_integrate(direct, 0.0, 2.0, n_fine, NumLibCpp::ExecutionPolicy::Parallel);
+    double simd = NumLibCpp::simpson_integrate(wrapped, 0.0, 2.0, n_fine, NumLibCpp::ExecutionPolicy::ParallelSimd);
+    ASSERT_NEAR(par, seq, 1e-13);
+    ASSERT_NEAR(simd, seq, 1e-13);
+    ASSERT_TRUE(NumLibCpp::simpson_integrate(direct, 0.0, 2.0, n_fine, NumLibCpp::ExecutionPolicy::Parallel) == par);
+    ASSERT_NEAR(NumLibCpp::simpson_integrate(direct, 2.0, 0.0, 10, NumLibCpp::ExecutionPolicy::ParallelSimd),
+                -NumLibCpp::simpson_integrate(direct, 0.0, 2.0, 10), 1e-15);
+    ASSERT_THROW(NumLibCpp::simpson_integrate(direct, 0.0, 1.0, 99, NumLibCpp::ExecutionPolicy::Parallel),
+                 std::invalid_argument);
+    std::cout << "  simpson_integrate (execution policies): PASSED" << std::endl;
 }
 
 // --- 5. Testy równań różniczkowych ---
@@ -80,6 +274,154 @@ void test_ode_solver() {
     // Błędny przypadek (zerowa liczba kroków)
     ASSERT_THROW(NumLibCpp::rk4_solve(f_exp, 0.0, 1.0, 1.0, 0), std::invalid_argument);
     std::cout << "  rk4_solve (zero steps): PASSED" << std::endl;
+
+    // Rodzina metod z tablic Butchera: rząd zbieżności dla y' = y
+    auto rk_error = [&](auto tableau, int steps) {
+        using Tableau = decltype(tableau);
+        return std::abs(NumLibCpp::explicit_rk_solve<Tableau>(f_exp, 0.0, 1.0, 1.0, steps) - std::exp(1.0));
+    };
+    auto check_order = [&](auto tableau, double expected_order) {
+        double observed = std::log2(rk_error(tableau, 10) / rk_error(tableau, 20));
+        ASSERT_NEAR(observed, expected_order, 0.35);
+    };
+    check_order(NumLibCpp::rk::Midpoint{}, 2.0);
+    check_order(NumLibCpp::rk::Heun{}, 2.0);
+    check_order(NumLibCpp::rk::Kutta3{}, 3.0);
+    check_order(NumLibCpp::rk::SSPRK3{}, 3.0);
+    check_order(NumLibCpp::rk::Classic4{}, 4.0);
+    check_order(NumLibCpp::rk::ThreeEighths4{}, 4.0);
+    check_order(NumLibCpp::rk::DormandPrince5{}, 5.0);
+    ASSERT_NEAR(NumLibCpp::explicit_rk_solve<NumLibCpp::rk::Classic4>(f_exp, 0.0, 1.0, 1.0, 100), result, 1e-13);
+    std::cout << "  explicit_rk_solve (convergence orders): PASSED" << std::endl;
+
+    // Układ: oscylator harmoniczny y'' = -y
+    auto oscillator = [](double, const std::vector<double>& y, std::vector<double>& dydx) {
+        dydx[0] = y[1];
+        dydx[1] = -y[0];
+    };
+    std::vector<double> osc = NumLibCpp::explicit_rk_solve_system<NumLibCpp::rk::DormandPrince5>(oscillator, 0.0, {1.0, 0.0}, M_PI, 50);
+    ASSERT_NEAR(osc[0], -1.0, 1e-8);
+    ASSERT_NEAR(osc[1], 0.0, 1e-8);
+    std::cout << "  explicit_rk_solve_system (oscillator): PASSED" << std::endl;
+
+    ASSERT_THROW(NumLibCpp::explicit_rk_solve<NumLibCpp::rk::Heun>(f_exp, 0.0, 1.0, 1.0, 0), std::invalid_argument);
+    std::cout << "  explicit_rk_solve (zero steps): PASSED" << std::endl;
+
+    // Funktor ze stanem przekazany jako l-wartość nie jest kopiowany
+    struct CountingRhs {
+        int calls = 0;
+        double operator()(double, double y) { ++calls; return y; }
+    } counting_rhs;
+    NumLibCpp::explicit_rk_solve<NumLibCpp::rk::Classic4>(counting_rhs, 0.0, 1.0, 1.0, 10);
+    ASSERT_TRUE(counting_rhs.calls == 40);
+    std::cout << "  explicit_rk_solve (stateful functor): PASSED" << std::endl;
+
+    // Obserwator kroków: pełna trajektoria w jednym wywołaniu
+    std::vector<double> xs, ys;
+    double y_obs = NumLibCpp::rk4_solve(f_exp, 0.0, 1.0, 1.0, 100, [&](double x, double y) {
+        xs.push_back(x);
+        ys.push_back(y);
+    });
+    ASSERT_TRUE(xs.size() == 101);
+    ASSERT_NEAR(y_obs, result, 1e-15);
+    ASSERT_NEAR(ys[50], std::exp(xs[50]), 1e-6);
+    std::cout << "  rk4_solve (step observer): PASSED" << std::endl;
+
+    // Punkty wyjściowe pomiędzy węzłami siatki (interpolacja Hermite'a)
+    std::vector<double> out_points = {0.0, 0.123, 0.5, 0.777, 1.0};
+    std::vector<double> out_values;
+    NumLibCpp::rk4_solve(f_exp, 0.0, 1.0, 1.0, 100, out_points, [&](double x, double y) {
+        ASSERT_NEAR(x, out_points[out_values.size()], 0.0);
+        out_values.push_back(y);
+    });
+    ASSERT_TRUE(out_values.size() == out_points.size());
+    for (size_t i = 0; i < out_points.size(); ++i) ASSERT_NEAR(out_values[i], std::exp(out_points[i]), 1e-7);
+    std::cout << "  rk4_solve (output points): PASSED" << std::endl;
+
+    ASSERT_THROW(NumLibCpp::rk4_solve(f_exp, 0.0, 1.0, 1.0, 10, std::vector<double>{0.5, 0.2},
+                                      [](double, double) {}), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::rk4_solve(f_exp, 0.0, 1.0, 1.0, 10, std::vector<double>{1.5},
+                                      [](double, double) {}), std::invalid_argument);
+    std::cout << "  rk4_solve (invalid output points): PASSED" << std::endl;
+
+    // Zespół trajektorii: chłodzenie Newtona z różnymi k, porównanie z rk4_solve
+    const std::size_t n_traj = 1000;
+    std::vector<double> k(n_traj), T0(n_traj);
+    for (std::size_t i = 0; i < n_traj; ++i) {
+        k[i] = 0.01 + 0.001 * i;
+        T0[i] = 50.0 + 0.1 * i;
+    }
+    auto rhs = [&](double, const double* T, double* dT, std::size_t first, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            dT[i] = -k[first + i] * (T[i] - 20.0);
+        }
+    };
+    std::vector<double> T_final = NumLibCpp::rk4_solve_ensemble(rhs, 0.0, T0, 10.0, 100);
+    ASSERT_TRUE(T_final.size() == n_traj);
+    for (std::size_t i = 0; i < n_traj; i += 97) {
+        auto f_i = [&](double, double T) { return -k[i] * (T - 20.0); };
+        ASSERT_NEAR(T_final[i], NumLibCpp::rk4_solve(f_i, 0.0, T0[i], 10.0, 100), 1e-10);
+    }
+    std::cout << "  rk4_solve_ensemble (correct): PASSED" << std::endl;
+
+    ASSERT_THROW(NumLibCpp::rk4_solve_ensemble(rhs, 0.0, T0, 1.0, 0), std::invalid_argument);
+    std::cout << "  rk4_solve_ensemble (zero steps): PASSED" << std::endl;
+
+    ASSERT_TRUE(NumLibCpp::rk4_solve_ensemble(rhs, 0.0, T0, 10.0, 100, NumLibCpp::ExecutionPolicy::Sequential) == T_final);
+    ASSERT_TRUE(NumLibCpp::rk4_solve_ensemble(rhs, 0.0, T0, 10.0, 100, NumLibCpp::ExecutionPolicy::ParallelSimd) == T_final);
+    std::cout << "  rk4_solve_ensemble (execution policies): PASSED" << std::endl;
+
+    // Sztywny układ Robertsona, wartości referencyjne dla x = 40
+    auto robertson = [](double, const std::vector<double>& y) {
+        return std::vector<double>{
+            -0.04 * y[0] + 1e4 * y[1] * y[2],
+             0.04 * y[0] - 1e4 * y[1] * y[2] - 3e7 * y[1] * y[1],
+             3e7 * y[1] * y[1]};
+    };
+    NumLibCpp::StiffSolverOptions opts;
+    opts.rtol = 1e-8;
+    opts.atol = 1e-12;
+    NumLibCpp::StiffSolverResult bdf = NumLibCpp::bdf_solve(robertson, 0.0, {1.0, 0.0, 0.0}, 40.0, opts);
+    ASSERT_NEAR(bdf.y[0], 0.7158270687, 1e-6);
+    ASSERT_NEAR(bdf.y[1], 9.185534765e-6, 1e-10);
+    ASSERT_NEAR(bdf.y[2], 0.2841637457, 1e-6);
+    ASSERT_TRUE(bdf.lu_decompositions < bdf.steps); // Rozkłady LU są używane ponownie
+    ASSERT_TRUE(bdf.jacobian_evaluations < bdf.steps);
+    std::cout << "  bdf_solve (Robertson): PASSED" << std::endl;
+
+    int observed_steps = 0;
+    opts.observer = [&](double, const std::vector<double>&) { ++observed_steps; };
+    NumLibCpp::StiffSolverResult observed = NumLibCpp::bdf_solve(robertson, 0.0, {1.0, 0.0, 0.0}, 1.0, opts);
+    ASSERT_TRUE(observed_steps == observed.steps + 1);
+    opts.observer = nullptr;
+    std::cout << "  bdf_solve (step observer): PASSED" << std::endl;
+
+    opts.rtol = 1e-6;
+    opts.atol = 1e-10;
+    NumLibCpp::StiffSolverResult ros = NumLibCpp::rosenbrock_solve(robertson, 0.0, {1.0, 0.0, 0.0}, 40.0, opts);
+    ASSERT_NEAR(ros.y[0], 0.7158270687, 1e-5);
+    ASSERT_NEAR(ros.y[2], 0.2841637457, 1e-5);
+    std::cout << "  rosenbrock_solve (Robertson): PASSED" << std::endl;
+
+    // y' = -1000 (y - cos x) z jakobianem użytkownika
+    auto stiff_linear = [](double x, const std::vector<double>& y) {
+        return std::vector<double>{-1000.0 * (y[0] - std::cos(x))};
+    };
+    opts.jacobian = [](double, const std::vector<double>&) {
+        return std::vector<std::vector<double>>{{-1000.0}};
+    };
+    opts.rtol = 1e-7;
+    opts.atol = 1e-10;
+    const double A_p = 1e6 / (1.0 + 1e6), B_p = 1e3 / (1.0 + 1e6);
+    const double y_exact = A_p * std::cos(2.0) + B_p * std::sin(2.0);
+    ASSERT_NEAR(NumLibCpp::bdf_solve(stiff_linear, 0.0, {A_p}, 2.0, opts).y[0], y_exact, 1e-6);
+    ASSERT_NEAR(NumLibCpp::rosenbrock_solve(stiff_linear, 0.0, {A_p}, 2.0, opts).y[0], y_exact, 1e-6);
+    std::cout << "  bdf_solve/rosenbrock_solve (user jacobian): PASSED" << std::endl;
+
+    ASSERT_THROW(NumLibCpp::bdf_solve(robertson, 0.0, {}, 1.0), std::invalid_argument);
+    opts.rtol = -1.0;
+    ASSERT_THROW(NumLibCpp::rosenbrock_solve(stiff_linear, 0.0, {1.0}, 1.0, opts), std::invalid_argument);
+    std::cout << "  bdf_solve/rosenbrock_solve (invalid args): PASSED" << std::endl;
 }
 
 // --- 6. Testy rozwiązywania równań nieliniowych ---
@@ -94,6 +436,149 @@ void test_nonlinear_solver() {
     auto func_no_real_root = [](double x){ return x*x + 1.0; };
     ASSERT_THROW(NumLibCpp::secant_method(func_no_real_root, -10.0, 10.0, 1e-5, 5), std::runtime_error);
     std::cout << "  secant_method (max iterations): PASSED" << std::endl;
+
+    // Jedno wywołanie funkcji na iterację
+    int calls = 0;
+    auto counted_sqrt2 = [&calls](double x) { ++calls; return x * x - 2.0; };
+    int evaluations = 0;
+    root = NumLibCpp::secant_method(counted_sqrt2, 1.0, 2.0, 1e-12, 100, evaluations);
+    ASSERT_NEAR(root, std::sqrt(2.0), 1e-12);
+    ASSERT_TRUE(evaluations == calls && evaluations <= 10);
+    std::cout << "  secant_method (evaluation count): PASSED" << std::endl;
+
+    calls = 0;
+    auto kepler = [&calls](double E) { ++calls; return E - 0.9 * std::sin(E) - 0.3; };
+    root = NumLibCpp::brent_method(kepler, 0.0, 3.0, 1e-13, 100, evaluations);
+    ASSERT_NEAR(root - 0.9 * std::sin(root), 0.3, 1e-12);
+    ASSERT_TRUE(evaluations == calls && evaluations <= 15);
+    // Funkcja, na której sieczne zawodzą (płaskie otoczenie), a bisekcja gwarantuje zbieżność
+    double cube_root = NumLibCpp::brent_method([](double x) { return std::cbrt(x - 1.0); }, -10.0, 3.0, 1e-12, 200);
+    ASSERT_NEAR(cube_root, 1.0, 1e-11);
+    ASSERT_NEAR(NumLibCpp::brent_method(func_sqrt2, 0.0, 2.0, 1e-12, 100), std::sqrt(2.0), 1e-12);
+    std::cout << "  brent_method (correct, evaluation count): PASSED" << std::endl;
+
+    ASSERT_THROW(NumLibCpp::brent_method(func_no_real_root, -1.0, 1.0, 1e-8, 100), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::brent_method(func_sqrt2, 0.0, 2.0, 0.0, 100), std::invalid_argument);
+    std::cout << "  brent_method (no sign change, invalid tol): PASSED" << std::endl;
+
+    // Równanie Keplera E - e sin(E) = M dla wielu par (e, M) - kilka bloków na różnych wątkach
+    const size_t batch = 10000;
+    std::vector<double> ecc(batch), mean(batch), lo(batch, 0.0), hi(batch, 2.0 * M_PI);
+    for (size_t i = 0; i < batch; ++i) {
+        ecc[i] = 0.95 * i / batch;
+        mean[i] = 2.0 * M_PI * ((i * 7919) % batch) / batch;
+    }
+    std::atomic<size_t> batch_calls{0};
+    auto kepler_batch = [&](const double* E, const size_t* idx, double* fx, size_t count) {
+        ++batch_calls;
+        for (size_t k = 0; k < count; ++k) fx[k] = E[k] - ecc[idx[k]] * std::sin(E[k]) - mean[idx[k]];
+    };
+    NumLibCpp::BatchRootOptions batch_opts;
+    batch_opts.block_size = 512;
+    NumLibCpp::BatchRootResult batch_res = NumLibCpp::chandrupatla_batch(kepler_batch, lo, hi, batch_opts);
+    int max_iterations = 0;
+    for (size_t i = 0; i < batch; ++i) {
+        ASSERT_TRUE(batch_res.status[i] == NumLibCpp::RootStatus::Converged);
+        const double E = batch_res.roots[i];
+        ASSERT_NEAR(E - ecc[i] * std::sin(E), mean[i], 1e-11);
+        max_iterations = std::max(max_iterations, batch_res.iterations[i]);
+    }
+    ASSERT_TRUE(max_iterations <= 20);
+    // Jedno wywołanie f na blok i iterację (plus dwa na końce przedziałów), nie na równanie
+    ASSERT_TRUE(batch_calls.load() <= (batch / 512 + 1) * (max_iterations + 2));
+    std::cout << "  chandrupatla_batch (Kepler, 10000 equations): PASSED" << std::endl;
+
+    // Stany zamiast wyjątków: brak zmiany znaku, NaN, limit iteracji
+    auto mixed = [](const double* x, const size_t* idx, double* fx, size_t count) {
+        for (size_t k = 0; k < count; ++k) {
+            if (idx[k] == 0) fx[k] = x[k] * x[k] + 1.0;
+            else if (idx[k] == 1) fx[k] = x[k] > 0.5 ? std::nan("") : x[k] - 0.75;
+            else fx[k] = x[k] - std::sqrt(2.0);
+        }
+    };
+    NumLibCpp::BatchRootResult mixed_res = NumLibCpp::chandrupatla_batch(mixed, {0.0, 0.0, 0.0}, {2.0, 2.0, 2.0});
+    ASSERT_TRUE(mixed_res.status[0] == NumLibCpp::RootStatus::NoBracket);
+    ASSERT_TRUE(std::isnan(mixed_res.roots[0]));
+    ASSERT_TRUE(mixed_res.status[1] == NumLibCpp::RootStatus::NotFinite);
+    ASSERT_TRUE(mixed_res.status[2] == NumLibCpp::RootStatus::Converged);
+    ASSERT_NEAR(mixed_res.roots[2], std::sqrt(2.0), 1e-12);
+    NumLibCpp::BatchRootOptions one_iter;
+    one_iter.max_iter = 1;
+    NumLibCpp::BatchRootResult limited = NumLibCpp::chandrupatla_batch(mixed, {0.0, 0.0, 0.0}, {2.0, 2.0, 2.0}, one_iter);
+    ASSERT_TRUE(limited.status[2] == NumLibCpp::RootStatus::MaxIterations);
+    ASSERT_THROW(NumLibCpp::chandrupatla_batch(mixed, {0.0}, {1.0, 2.0}), std::invalid_argument);
+    std::cout << "  chandrupatla_batch (per-element status): PASSED" << std::endl;
+
+    // Układ x^2 + y^2 = 4, e^x + y = 1 (rozwiązanie w pobliżu (-1.816, 0.837))
+    auto F2 = [](const std::vector<double>& v) {
+        return std::vector<double>{v[0] * v[0] + v[1] * v[1] - 4.0, std::exp(v[0]) + v[1] - 1.0};
+    };
+    for (auto solver : {NumLibCpp::newton_system, NumLibCpp::broyden_system}) {
+        NumLibCpp::NonlinearSystemResult res = solver(F2, {-2.0, 1.0}, NumLibCpp::NonlinearSystemOptions());
+        std::vector<double> r = F2(res.x);
+        ASSERT_NEAR(r[0], 0.0, 1e-9);
+        ASSERT_NEAR(r[1], 0.0, 1e-9);
+        ASSERT_TRUE(res.jacobian_evaluations >= 1 && res.function_evaluations > res.iterations);
+    }
+    std::cout << "  newton_system/broyden_system (2x2): PASSED" << std::endl;
+
+    // Trójdiagonalny układ Bratu: 2u_i - u_{i-1} - u_{i+1} - h^2 e^{u_i} = 0, u_0 = u_{n+1} = 0
+    const size_t n = 200;
+    const double h2 = 1.0 / ((n + 1.0) * (n + 1.0));
+    auto bratu = [&](const std::vector<double>& u) {
+        std::vector<double> r(n);
+        for (size_t i = 0; i < n; ++i) {
+            double left = i > 0 ? u[i - 1] : 0.0;
+            double right = i + 1 < n ? u[i + 1] : 0.0;
+            r[i] = 2.0 * u[i] - left - right - h2 * std::exp(u[i]);
+        }
+        return r;
+    };
+    NumLibCpp::NonlinearSystemOptions opts;
+    opts.sparsity.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = (i > 0 ? i - 1 : 0); j <= std::min(i + 1, n - 1); ++j) {
+            opts.sparsity[i].push_back(static_cast<int>(j));
+        }
+    }
+    NumLibCpp::NonlinearSystemResult sparse_res = NumLibCpp::newton_system(bratu, std::vector<double>(n, 0.0), opts);
+    NumLibCpp::NonlinearSystemResult dense_res = NumLibCpp::newton_system(bratu, std::vector<double>(n, 0.0));
+    ASSERT_TRUE(sparse_res.residual_norm < 1e-10);
+    ASSERT_NEAR(sparse_res.x[n / 2], dense_res.x[n / 2], 1e-9);
+    ASSERT_NEAR(sparse_res.x[n / 2], 0.1405, 1e-3); // Maksimum rozwiązania dla lambda = 1
+    // Trzy grupy kolumn zamiast n: 6 wywołań F na jakobian
+    ASSERT_TRUE(sparse_res.function_evaluations < dense_res.function_evaluations / 10);
+    ASSERT_TRUE(sparse_res.lu_decompositions <= sparse_res.iterations);
+
+    NumLibCpp::NonlinearSystemResult broyden_res = NumLibCpp::broyden_system(bratu, std::vector<double>(n, 0.0), opts);
+    ASSERT_TRUE(broyden_res.residual_norm < 1e-10);
+    ASSERT_NEAR(broyden_res.x[n / 2], sparse_res.x[n / 2], 1e-5); // Warunkowanie ~n^2
+    ASSERT_TRUE(broyden_res.jacobian_evaluations < broyden_res.iterations || broyden_res.iterations == 1);
+    std::cout << "  newton_system/broyden_system (sparse Bratu, n = 200): PASSED" << std::endl;
+
+    // Jakobian użytkownika: x_i^3 = i + 1
+    NumLibCpp::NonlinearSystemOptions exact;
+    exact.jacobian = [](const std::vector<double>& x) {
+        std::vector<std::vector<double>> J(x.size(), std::vector<double>(x.size(), 0.0));
+        for (size_t i = 0; i < x.size(); ++i) J[i][i] = 3.0 * x[i] * x[i];
+        return J;
+    };
+    auto cubes = [](const std::vector<double>& x) {
+        std::vector<double> r(x.size());
+        for (size_t i = 0; i < x.size(); ++i) r[i] = x[i] * x[i] * x[i] - (i + 1.0);
+        return r;
+    };
+    NumLibCpp::NonlinearSystemResult exact_res = NumLibCpp::newton_system(cubes, {1.0, 1.0, 1.0}, exact);
+    ASSERT_NEAR(exact_res.x[2], std::cbrt(3.0), 1e-9);
+    ASSERT_TRUE(exact_res.function_evaluations == exact_res.iterations + 1); // Pełne kroki, bez różnic skończonych
+    std::cout << "  newton_system (user Jacobian): PASSED" << std::endl;
+
+    ASSERT_THROW(NumLibCpp::newton_system(F2, {}), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::broyden_system([](const std::vector<double>& v) { return std::vector<double>{v[0]}; },
+                                           {1.0, 2.0}), std::invalid_argument);
+    auto no_root = [](const std::vector<double>& v) { return std::vector<double>{v[0] * v[0] + 1.0}; };
+    ASSERT_THROW(NumLibCpp::newton_system(no_root, {0.5}), std::runtime_error);
+    std::cout << "  newton_system/broyden_system (invalid args): PASSED" << std::endl;
 }
 
 // --- 7. Testy różniczkowania ---
@@ -107,9 +592,725 @@ void test_differentiation() {
     // Błędny przypadek (niepoprawny krok h)
     ASSERT_THROW(NumLibCpp::central_difference(cubic_func, 2.0, 0.0), std::invalid_argument);
     std::cout << "  central_difference (invalid h): PASSED" << std::endl;
+
+    // Macierz Jacobiego F(x, y) = (x*y, x + y^2)
+    auto F = [](const std::vector<double>& v) { return std::vector<double>{v[0] * v[1], v[0] + v[1] * v[1]}; };
+    auto J = NumLibCpp::numerical_jacobian(F, {2.0, 3.0}, 1e-6);
+    ASSERT_NEAR(J[0][0], 3.0, 1e-6);
+    ASSERT_NEAR(J[0][1], 2.0, 1e-6);
+    ASSERT_NEAR(J[1][0], 1.0, 1e-6);
+    ASSERT_NEAR(J[1][1], 6.0, 1e-6);
+    std::cout << "  numerical_jacobian (correct): PASSED" << std::endl;
+
+    ASSERT_THROW(NumLibCpp::numerical_jacobian(F, {2.0, 3.0}, 0.0), std::invalid_argument);
+    std::cout << "  numerical_jacobian (invalid h): PASSED" << std::endl;
+
+    // Wzorzec rzadkości: F_0 zależy od x_0, x_1; F_1 od x_1; F_2 od x_0, x_2 -> kolumny {0}, {1, 2}
+    int calls = 0;
+    auto G = [&calls](const std::vector<double>& v) {
+        ++calls;
+        return std::vector<double>{v[0] * v[1], std::sin(v[1]), v[0] + v[2] * v[2]};
+    };
+    auto Js = NumLibCpp::numerical_jacobian(G, {1.0, 2.0, 3.0}, 1e-6, {{0, 1}, {1}, {0, 2}});
+    ASSERT_NEAR(Js[0][0], 2.0, 1e-6);
+    ASSERT_NEAR(Js[0][1], 1.0, 1e-6);
+    ASSERT_NEAR(Js[1][1], std::cos(2.0), 1e-6);
+    ASSERT_NEAR(Js[2][0], 1.0, 1e-6);
+    ASSERT_NEAR(Js[2][2], 6.0, 1e-6);
+    ASSERT_NEAR(Js[1][2], 0.0, 0.0);
+    ASSERT_TRUE(calls == 4);
+    ASSERT_THROW(NumLibCpp::numerical_jacobian(G, {1.0, 2.0, 3.0}, 1e-6, {{0, 3}, {1}, {2}}), std::invalid_argument);
+    std::cout << "  numerical_jacobian (sparse, column groups): PASSED" << std::endl;
+
+    // Gradient funkcji Rosenbrocka w (1.5, 2): (-2(1 - x) - 400x(y - x^2), 200(y - x^2))
+    auto rosen_fd = [](const std::vector<double>& v) {
+        return (1.0 - v[0]) * (1.0 - v[0]) + 100.0 * (v[1] - v[0] * v[0]) * (v[1] - v[0] * v[0]);
+    };
+    const double gx = 1.0 + 600.0 * 0.25, gy = -50.0;
+    struct StencilCase { NumLibCpp::DifferenceStencil stencil; double tol; };
+    for (StencilCase sc : {StencilCase{NumLibCpp::DifferenceStencil::Forward, 1e-4},
+                           StencilCase{NumLibCpp::DifferenceStencil::Central, 1e-8},
+                           StencilCase{NumLibCpp::DifferenceStencil::FivePoint, 1e-9},
+                           StencilCase{NumLibCpp::DifferenceStencil::Richardson, 1e-9}}) {
+        NumLibCpp::DifferenceOptions opts;
+        opts.stencil = sc.stencil;
+        std::vector<double> gfd = NumLibCpp::numerical_gradient(rosen_fd, {1.5, 2.0}, opts);
+        ASSERT_NEAR(gfd[0], gx, sc.tol * std::abs(gx));
+        ASSERT_NEAR(gfd[1], gy, sc.tol * std::abs(gy));
+    }
+    std::cout << "  numerical_gradient (all stencils, automatic step): PASSED" << std::endl;
+
+    // Jakobian schematem w przód: F(x) liczone raz, n + 1 wywołań
+    std::atomic<int> fd_calls{0};
+    auto trig = [&fd_calls](const std::vector<double>& v) {
+        ++fd_calls;
+        std::vector<double> r(v.size());
+        for (size_t i = 0; i < v.size(); ++i) r[i] = std::sin(v[i]) * v[(i + 1) % v.size()];
+        return r;
+    };
+    std::vector<double> q(50);
+    for (size_t i = 0; i < q.size(); ++i) q[i] = 0.05 * i;
+    NumLibCpp::DifferenceOptions fwd;
+    fwd.stencil = NumLibCpp::DifferenceStencil::Forward;
+    auto Jf = NumLibCpp::numerical_jacobian(trig, q, fwd);
+    ASSERT_TRUE(fd_calls == 51);
+    ASSERT_NEAR(Jf[10][10], std::cos(q[10]) * q[11], 1e-7);
+    ASSERT_NEAR(Jf[10][11], std::sin(q[10]), 1e-7);
+    NumLibCpp::DifferenceOptions five;
+    five.stencil = NumLibCpp::DifferenceStencil::FivePoint;
+    five.parallel = false;
+    auto J5 = NumLibCpp::numerical_jacobian(trig, q, five);
+    ASSERT_NEAR(J5[49][0], std::sin(q[49]), 1e-11);
+    std::cout << "  numerical_jacobian (forward base reuse, five-point): PASSED" << std::endl;
+
+    // Hesjan Rosenbrocka: [[2 - 400(y - 3x^2), -400x], [-400x, 200]]
+    for (auto stencil : {NumLibCpp::DifferenceStencil::Forward, NumLibCpp::DifferenceStencil::Central}) {
+        NumLibCpp::DifferenceOptions opts;
+        opts.stencil = stencil;
+        auto Hfd = NumLibCpp::numerical_hessian(rosen_fd, {1.5, 2.0}, opts);
+        const double tol = stencil == NumLibCpp::DifferenceStencil::Forward ? 1e-3 : 1e-5;
+        ASSERT_NEAR(Hfd[0][0], 2.0 - 400.0 * (2.0 - 6.75), tol * 2000.0);
+        ASSERT_NEAR(Hfd[0][1], -600.0, tol * 600.0);
+        ASSERT_NEAR(Hfd[1][0], Hfd[0][1], 0.0);
+        ASSERT_NEAR(Hfd[1][1], 200.0, tol * 200.0);
+    }
+    ASSERT_THROW(NumLibCpp::numerical_hessian(rosen_fd, {1.0, 1.0}, five), std::invalid_argument);
+    std::cout << "  numerical_hessian (forward, central): PASSED" << std::endl;
+
+    // Krok zespolony: dokładność maszynowa bez doboru kroku
+    auto analytic = [](const std::vector<std::complex<double>>& z) { return std::exp(z[0]) * std::sin(z[1]) / z[2]; };
+    auto gcs = NumLibCpp::complex_step_gradient(analytic, {0.5, 1.0, 2.0});
+    ASSERT_NEAR(gcs[0], std::exp(0.5) * std::sin(1.0) / 2.0, 1e-15);
+    ASSERT_NEAR(gcs[1], std::exp(0.5) * std::cos(1.0) / 2.0, 1e-15);
+    ASSERT_NEAR(gcs[2], -std::exp(0.5) * std::sin(1.0) / 4.0, 1e-15);
+    auto Jcs = NumLibCpp::complex_step_jacobian(
+        [](const std::vector<std::complex<double>>& z) { return std::vector<std::complex<double>>{z[0] * z[1], std::log(z[1])}; },
+        {3.0, 2.0});
+    ASSERT_NEAR(Jcs[0][0], 2.0, 1e-15);
+    ASSERT_NEAR(Jcs[1][1], 0.5, 1e-15);
+    ASSERT_THROW(NumLibCpp::complex_step_gradient(analytic, {}), std::invalid_argument);
+    std::cout << "  complex_step_gradient/complex_step_jacobian: PASSED" << std::endl;
+
+    // Różniczkowanie automatyczne: pochodne dokładne do zaokrągleń
+    auto g = [](auto x) {
+        using std::exp; using std::sin; using std::sqrt; using std::pow;
+        return x * sin(x) + exp(-x * x) / sqrt(1.0 + x) + pow(x, 3.0);
+    };
+    const double x0 = 0.7;
+    const double dg = std::sin(x0) + x0 * std::cos(x0) - 2.0 * x0 * std::exp(-x0 * x0) / std::sqrt(1.0 + x0) -
+                      0.5 * std::exp(-x0 * x0) / std::pow(1.0 + x0, 1.5) + 3.0 * x0 * x0;
+    ASSERT_NEAR(NumLibCpp::derivative(g, x0), dg, 1e-14);
+    auto cubic_sin = [](auto x) { using std::sin; return sin(x) * x * x; };
+    ASSERT_NEAR(NumLibCpp::second_derivative(cubic_sin, x0),
+                2.0 * std::sin(x0) + 4.0 * x0 * std::cos(x0) - x0 * x0 * std::sin(x0), 1e-14);
+    std::cout << "  derivative/second_derivative (dual, hyper-dual): PASSED" << std::endl;
+
+    // Jakobian 20 x 20 w trzech wywołaniach (paczki po 8 kolumn) i Hessian Rosenbrocka
+    int ad_calls = 0;
+    auto chain = [&ad_calls](const auto& v) {
+        using std::exp;
+        using T = typename std::decay_t<decltype(v)>::value_type;
+        ++ad_calls;
+        std::vector<T> r(v.size());
+        for (size_t i = 0; i < v.size(); ++i) r[i] = v[i] * v[(i + 1) % v.size()] + exp(v[i]);
+        return r;
+    };
+    std::vector<double> p(20);
+    for (size_t i = 0; i < p.size(); ++i) p[i] = 0.1 * i;
+    auto J_ad = NumLibCpp::jacobian_ad(chain, p);
+    ASSERT_TRUE(ad_calls == 3);
+    ASSERT_NEAR(J_ad[4][4], p[5] + std::exp(p[4]), 1e-14);
+    ASSERT_NEAR(J_ad[4][5], p[4], 1e-14);
+    ASSERT_NEAR(J_ad[19][0], p[19], 1e-14);
+    ASSERT_NEAR(J_ad[4][6], 0.0, 0.0);
+    auto rosen = [](const auto& v) { return (1.0 - v[0]) * (1.0 - v[0]) + 100.0 * (v[1] - v[0] * v[0]) * (v[1] - v[0] * v[0]); };
+    auto grad = NumLibCpp::gradient_ad(rosen, {1.5, 2.0});
+    ASSERT_NEAR(grad[0], -2.0 * (1.0 - 1.5) - 400.0 * 1.5 * (2.0 - 2.25), 1e-12);
+    ASSERT_NEAR(grad[1], 200.0 * (2.0 - 2.25), 1e-12);
+    auto H = NumLibCpp::hessian_ad(rosen, {1.5, 2.0});
+    ASSERT_NEAR(H[0][0], 2.0 - 400.0 * (2.0 - 3.0 * 2.25), 1e-12);
+    ASSERT_NEAR(H[0][1], -600.0, 1e-12);
+    ASSERT_NEAR(H[1][0], -600.0, 1e-12);
+    ASSERT_NEAR(H[1][1], 200.0, 1e-12);
+    std::cout << "  jacobian_ad/gradient_ad/hessian_ad: PASSED" << std::endl;
+
+    // Solwery z jakobianem AD
+    double r = NumLibCpp::newton_method_ad([](auto x) { using std::cos; return cos(x) - x; }, 1.0, 1e-14, 20);
+    ASSERT_NEAR(r, 0.7390851332151607, 1e-15);
+    auto F2 = [](const auto& v) {
+        using std::exp;
+        using T = typename std::decay_t<decltype(v)>::value_type;
+        return std::vector<T>{v[0] * v[0] + v[1] * v[1] - 4.0, exp(v[0]) + v[1] - 1.0};
+    };
+    NumLibCpp::NonlinearSystemResult sys = NumLibCpp::newton_system_ad(F2, {-2.0, 1.0});
+    ASSERT_TRUE(sys.residual_norm < 1e-10 && sys.function_evaluations == sys.iterations + 1);
+    auto robertson = [](double, const auto& y) {
+        using T = typename std::decay_t<decltype(y)>::value_type;
+        return std::vector<T>{-0.04 * y[0] + 1e4 * y[1] * y[2],
+                              0.04 * y[0] - 1e4 * y[1] * y[2] - 3e7 * y[1] * y[1],
+                              3e7 * y[1] * y[1]};
+    };
+    NumLibCpp::StiffSolverOptions stiff_opts;
+    stiff_opts.rtol = 1e-6;
+    stiff_opts.atol = 1e-10;
+    auto bdf = NumLibCpp::bdf_solve_ad(robertson, 0.0, {1.0, 0.0, 0.0}, 40.0, stiff_opts);
+    auto ros = NumLibCpp::rosenbrock_solve_ad(robertson, 0.0, {1.0, 0.0, 0.0}, 40.0, stiff_opts);
+    ASSERT_NEAR(bdf.y[0], 0.7158, 1e-3);
+    ASSERT_NEAR(ros.y[0], 0.7158, 1e-3);
+    std::cout << "  newton_method_ad/newton_system_ad/bdf_solve_ad/rosenbrock_solve_ad: PASSED" << std::endl;
+
+    // Operatory różnicowe na siatkach
+    std::vector<double> fw = NumLibCpp::fornberg_weights(0.0, {-1.0, 0.0, 1.0}, 2);
+    ASSERT_NEAR(fw[0], 1.0, 1e-14);
+    ASSERT_NEAR(fw[1], -2.0, 1e-14);
+    ASSERT_NEAR(fw[2], 1.0, 1e-14);
+    std::cout << "  fornberg_weights: PASSED" << std::endl;
+
+    auto max_error = [](const std::vector<double>& a, const std::vector<double>& b) {
+        double e = 0.0;
+        for (size_t i = 0; i < a.size(); ++i) e = std::max(e, std::abs(a[i] - b[i]));
+        return e;
+    };
+    auto sampled = [](size_t n, double dx, double (*g)(double)) {
+        std::vector<double> v(n);
+        for (size_t i = 0; i < n; ++i) v[i] = g(static_cast<double>(i) * dx);
+        return v;
+    };
+    double (*fsin)(double) = [](double t) { return std::sin(t); };
+    double (*fcos)(double) = [](double t) { return std::cos(t); };
+    double (*fnsin)(double) = [](double t) { return -std::sin(t); };
+    // Błąd (łącznie z brzegami) maleje jak dx^p: podwojenie n zmniejsza go ok. 2^p razy
+    for (int p : {2, 4}) {
+        for (int m : {1, 2}) {
+            double (*exact)(double) = m == 1 ? fcos : fnsin;
+            const double e1 = max_error(NumLibCpp::grid_derivative(sampled(101, 0.02, fsin), 0.02, m, p),
+                                        sampled(101, 0.02, exact));
+            const double e2 = max_error(NumLibCpp::grid_derivative(sampled(201, 0.01, fsin), 0.01, m, p),
+                                        sampled(201, 0.01, exact));
+            ASSERT_TRUE(e1 / e2 > 0.8 * std::pow(2.0, p));
+            ASSERT_TRUE(e2 < (p == 2 ? 1e-3 : 1e-6));
+        }
+    }
+    std::cout << "  grid_derivative (uniform, orders 2 and 4): PASSED" << std::endl;
+
+    std::vector<double> xs(150), fx(150);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        const double s = static_cast<double>(i) / 149.0;
+        xs[i] = 3.0 * s * s;
+        fx[i] = std::sin(xs[i]);
+    }
+    std::vector<double> dfx = NumLibCpp::grid_derivative(fx, xs, 1, 4);
+    std::vector<double> d2fx = NumLibCpp::grid_derivative(fx, xs, 2, 4);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        ASSERT_NEAR(dfx[i], std::cos(xs[i]), 1e-5);
+        ASSERT_NEAR(d2fx[i], -std::sin(xs[i]), 1e-3);
+    }
+    // Wielomiany stopnia < m + p są różniczkowane dokładnie
+    std::vector<double> cube(xs.size());
+    for (size_t i = 0; i < xs.size(); ++i) cube[i] = xs[i] * xs[i] * xs[i];
+    std::vector<double> dcube = NumLibCpp::grid_derivative(cube, xs, 1, 4);
+    for (size_t i = 0; i < xs.size(); ++i) ASSERT_NEAR(dcube[i], 3.0 * xs[i] * xs[i], 1e-9);
+    std::cout << "  grid_derivative (non-uniform): PASSED" << std::endl;
+
+    NumLibCpp::FiniteDifferenceStencil d1(201, 0.01, 1, 4);
+    std::vector<double> u = sampled(201, 0.01, fsin);
+    std::vector<double> du = d1.apply(u);
+    d1.apply(u.data(), u.data());
+    ASSERT_TRUE(u == du);
+    std::cout << "  FiniteDifferenceStencil (in place): PASSED" << std::endl;
+
+    // f(x, y, z) = sin(x) * cos(2y) * z^2 na siatce nx x ny x nz
+    const size_t nx = 40, ny = 50, nz = 30;
+    const double hx = 0.05, hy = 0.04, hz = 0.1;
+    std::vector<double> field(nx * ny * nz);
+    for (size_t k = 0; k < nz; ++k)
+        for (size_t j = 0; j < ny; ++j)
+            for (size_t i = 0; i < nx; ++i)
+                field[(k * ny + j) * nx + i] = std::sin(i * hx) * std::cos(2.0 * j * hy) * (k * hz) * (k * hz);
+    NumLibCpp::FiniteDifferenceStencil sx(nx, hx, 1, 4), sy(ny, hy, 1, 4), sz(nz, hz, 1, 2);
+    std::vector<double> field_x(field.size()), field_y(field.size()), field_z = field;
+    NumLibCpp::grid_derivative_3d(sx, field.data(), field_x.data(), nx, ny, nz, 0);
+    NumLibCpp::grid_derivative_3d(sy, field.data(), field_y.data(), nx, ny, nz, 1);
+    NumLibCpp::grid_derivative_3d(sz, field_z.data(), field_z.data(), nx, ny, nz, 2);
+    for (size_t k = 0; k < nz; ++k) {
+        for (size_t j = 0; j < ny; ++j) {
+            for (size_t i = 0; i < nx; ++i) {
+                const size_t idx = (k * ny + j) * nx + i;
+                const double x = i * hx, y = j * hy, z = k * hz;
+                ASSERT_NEAR(field_x[idx], std::cos(x) * std::cos(2.0 * y) * z * z, 1e-4);
+                ASSERT_NEAR(field_y[idx], -2.0 * std::sin(x) * std::sin(2.0 * y) * z * z, 1e-4);
+                ASSERT_NEAR(field_z[idx], std::sin(x) * std::cos(2.0 * y) * 2.0 * z, 1e-10);
+            }
+        }
+    }
+    std::vector<double> plane(nx * ny), plane_y(nx * ny);
+    std::copy(field.begin() + 5 * nx * ny, field.begin() + 6 * nx * ny, plane.begin());
+    NumLibCpp::grid_derivative_2d(sy, plane.data(), plane_y.data(), nx, ny, 1);
+    for (size_t idx = 0; idx < plane.size(); ++idx) ASSERT_NEAR(plane_y[idx], field_y[5 * nx * ny + idx], 1e-15);
+    std::cout << "  grid_derivative_2d/grid_derivative_3d: PASSED" << std::endl;
+
+    ASSERT_THROW(NumLibCpp::FiniteDifferenceStencil(100, 0.1, 1, 3), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::FiniteDifferenceStencil(100, -0.1, 1, 2), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::FiniteDifferenceStencil(3, 0.1, 2, 2), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::FiniteDifferenceStencil({0.0, 1.0, 1.0, 2.0}, 1, 2), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::grid_derivative_2d(sx, plane.data(), plane_y.data(), nx, ny, 1), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::grid_derivative_3d(sx, field.data(), field_x.data(), nx, ny, nz, 3), std::invalid_argument);
+    std::cout << "  FiniteDifferenceStencil (invalid input): PASSED" << std::endl;
+}
+
+// --- 10. Testy równania przewodnictwa (metoda linii) ---
+void test_pde_solver() {
+    // 1-D, warunki Dirichleta: u = exp(-pi^2 a t) sin(pi x)
+    NumLibCpp::HeatProblem1D rod;
+    rod.nodes = 51;
+    rod.diffusivity = 0.5;
+    std::vector<double> u0(rod.nodes);
+    for (size_t i = 0; i < rod.nodes; ++i) u0[i] = std::sin(M_PI * i / 50.0);
+    const double decay = std::exp(-M_PI * M_PI * 0.5 * 0.2);
+    std::vector<double> u_cn = NumLibCpp::solve_heat_1d(rod, u0, 0.2, 200);
+    std::vector<double> u_rk = NumLibCpp::solve_heat_1d(rod, u0, 0.2, 400, NumLibCpp::TimeScheme::ExplicitRK4);
+    ASSERT_NEAR(u_cn[25], decay, 1e-3);
+    ASSERT_NEAR(u_rk[25], decay, 1e-3);
+    ASSERT_NEAR(u_cn[0], 0.0, 0.0);
+    std::cout << "  solve_heat_1d (Dirichlet): PASSED" << std::endl;
+
+    // 1-D, izolowane końce (Neumann): u = exp(-pi^2 t) cos(pi x)
+    rod.diffusivity = 1.0;
+    rod.left = {NumLibCpp::BoundaryType::Neumann, 0.0, 0.0};
+    rod.right = {NumLibCpp::BoundaryType::Neumann, 0.0, 0.0};
+    for (size_t i = 0; i < rod.nodes; ++i) u0[i] = std::cos(M_PI * i / 50.0);
+    u_cn = NumLibCpp::solve_heat_1d(rod, u0, 0.1, 100);
+    ASSERT_NEAR(u_cn[0], std::exp(-M_PI * M_PI * 0.1), 2e-3);
+    ASSERT_NEAR(u_cn[50], -std::exp(-M_PI * M_PI * 0.1), 2e-3);
+    std::cout << "  solve_heat_1d (Neumann): PASSED" << std::endl;
+
+    // 1-D, stan ustalony z konwekcją (Robin) na prawym końcu: u = 1 - x/2 dla c = 1, T_env = 0
+    rod.left = {NumLibCpp::BoundaryType::Dirichlet, 1.0, 0.0};
+    rod.right = {NumLibCpp::BoundaryType::Robin, 0.0, 1.0};
+    u_cn = NumLibCpp::solve_heat_1d(rod, std::vector<double>(rod.nodes, 0.0), 20.0, 400);
+    ASSERT_NEAR(u_cn[50], 0.5, 1e-6);
+    ASSERT_NEAR(u_cn[25], 0.75, 1e-6);
+    std::cout << "  solve_heat_1d (Robin steady state): PASSED" << std::endl;
+
+    // 2-D, warunki Dirichleta: u = exp(-2 pi^2 t) sin(pi x) sin(pi y)
+    NumLibCpp::HeatProblem2D plate;
+    plate.nodes_x = 41;
+    plate.nodes_y = 31;
+    std::vector<double> v0(plate.nodes_x * plate.nodes_y);
+    for (size_t j = 0; j < plate.nodes_y; ++j)
+        for (size_t i = 0; i < plate.nodes_x; ++i)
+            v0[j * plate.nodes_x + i] = std::sin(M_PI * i / 40.0) * std::sin(M_PI * j / 30.0);
+    const size_t centre = 15 * plate.nodes_x + 20;
+    const double decay2 = std::exp(-2.0 * M_PI * M_PI * 0.05);
+    std::vector<double> v_adi = NumLibCpp::solve_heat_2d(plate, v0, 0.05, 50);
+    std::vector<double> v_rk = NumLibCpp::solve_heat_2d(plate, v0, 0.05, 200, NumLibCpp::TimeScheme::ExplicitRK4);
+    ASSERT_NEAR(v_adi[centre], decay2, 2e-3);
+    ASSERT_NEAR(v_rk[centre], decay2, 2e-3);
+    std::cout << "  solve_heat_2d (Dirichlet, ADI and RK4): PASSED" << std::endl;
+
+    // 2-D, mieszane warunki: stan ustalony liniowy w x (izolowane brzegi y, konwekcja po prawej)
+    plate.left = {NumLibCpp::BoundaryType::Dirichlet, 1.0, 0.0};
+    plate.right = {NumLibCpp::BoundaryType::Robin, 0.0, 1.0};
+    plate.bottom = {NumLibCpp::BoundaryType::Neumann, 0.0, 0.0};
+    plate.top = {NumLibCpp::BoundaryType::Neumann, 0.0, 0.0};
+    v_adi = NumLibCpp::solve_heat_2d(plate, std::vector<double>(v0.size(), 0.0), 20.0, 400);
+    ASSERT_NEAR(v_adi[0 * plate.nodes_x + 40], 0.5, 1e-6);
+    ASSERT_NEAR(v_adi[30 * plate.nodes_x + 20], 0.75, 1e-6);
+    std::cout << "  solve_heat_2d (mixed boundaries steady state): PASSED" << std::endl;
+
+    // Błędne przypadki
+    ASSERT_THROW(NumLibCpp::solve_heat_1d(rod, u0, 1.0, 10, NumLibCpp::TimeScheme::ExplicitRK4), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::solve_heat_1d(rod, {1.0, 2.0}, 1.0, 10), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::solve_heat_2d(plate, v0, 1.0, 0), std::invalid_argument);
+    std::cout << "  solve_heat (invalid args): PASSED" << std::endl;
+}
+
+// --- 8. Testy puli wątków ---
+void test_thread_pool() {
+    // Poprawny przypadek (suma po zakresie liczona w wielu fragmentach)
+    NumLibCpp::ThreadPool pool(3);
+    std::vector<int> hits(10000, 0);
+    pool.parallel_for(0, hits.size(), 64, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i) hits[i] += 1;
+    });
+    for (int h : hits) ASSERT_TRUE(h == 1);
+    std::cout << "  parallel_for (every index once): PASSED" << std::endl;
+
+    // Zagnieżdżone wywołanie wykonuje się sekwencyjnie w bieżącym wątku
+    std::atomic<int> total{0};
+    pool.parallel_for(0, 8, 1, [&](std::size_t, std::size_t) {
+        pool.parallel_for(0, 100, 10, [&](std::size_t lo, std::size_t hi) { total += static_cast<int>(hi - lo); });
+    });
+    ASSERT_TRUE(total == 800);
+    std::cout << "  parallel_for (nested): PASSED" << std::endl;
+
+    // Błędny przypadek (wyjątek z zadania trafia do wywołującego)
+    ASSERT_THROW(pool.parallel_for(0, 100, 10, [](std::size_t lo, std::size_t) {
+        if (lo == 50) throw std::runtime_error("blad zadania");
+    }), std::runtime_error);
+    std::cout << "  parallel_for (exception propagation): PASSED" << std::endl;
+
+    ASSERT_THROW(pool.parallel_for(0, 10, 0, [](std::size_t, std::size_t) {}), std::invalid_argument);
+    std::cout << "  parallel_for (zero grain): PASSED" << std::endl;
+
+    // Pula przypięta do węzłów NUMA (bez topologii NUMA działa jak zwykła pula)
+    NumLibCpp::ThreadPool numa_pool(NumLibCpp::ThreadPoolOptions{2, true});
+    ASSERT_TRUE(numa_pool.size() == 2 && numa_pool.numa_nodes() <= 2);
+    std::vector<int> numa_hits(1000, 0);
+    numa_pool.parallel_for(0, numa_hits.size(), 10, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i) numa_hits[i] += 1;
+    });
+    for (int h : numa_hits) ASSERT_TRUE(h == 1);
+    std::cout << "  ThreadPoolOptions (numa_affinity): PASSED" << std::endl;
+
+    // Parametry globalnej puli można ustalić tylko przed jej utworzeniem
+    NumLibCpp::ThreadPool::global();
+    ASSERT_THROW(NumLibCpp::ThreadPool::configure_global(NumLibCpp::ThreadPoolOptions{2, false}), std::logic_error);
+    std::cout << "  configure_global (after first use): PASSED" << std::endl;
+
+#ifndef _WIN32
+    // NUMLIBCPP_NUM_THREADS: wartości niepoprawne dają liczbę wątków domyślną (0)
+    const char* saved_env = std::getenv("NUMLIBCPP_NUM_THREADS");
+    const std::string saved_threads = saved_env ? saved_env : "";
+    auto threads_from_env = [](const char* value) {
+        setenv("NUMLIBCPP_NUM_THREADS", value, 1);
+        return NumLibCpp::ThreadPool::options_from_environment().num_threads;
+    };
+    ASSERT_TRUE(threads_from_env("3") == 3);
+    ASSERT_TRUE(threads_from_env("0") == 0);
+    ASSERT_TRUE(threads_from_env("-1") == 0);
+    ASSERT_TRUE(threads_from_env("abc") == 0);
+    ASSERT_TRUE(threads_from_env("4x") == 0);
+    ASSERT_TRUE(threads_from_env("") == 0);
+    ASSERT_TRUE(threads_from_env("100000000") == 0);
+    ASSERT_TRUE(threads_from_env("99999999999999999999999") == 0);
+    if (saved_env) {
+        setenv("NUMLIBCPP_NUM_THREADS", saved_threads.c_str(), 1);
+    } else {
+        unsetenv("NUMLIBCPP_NUM_THREADS");
+    }
+    std::cout << "  options_from_environment (invalid values fall back to default): PASSED" << std::endl;
+#endif
+}
+
+// --- 9. Testy zapisu trajektorii ---
+void test_trajectory_writer() {
+    const std::string path = "numlib_test_trajectory.traj";
+
+    // Poprawny przypadek (double, mały bufor wymuszający wiele przekazań do wątku tła)
+    {
+        NumLibCpp::TrajectoryWriter writer(path, 2, NumLibCpp::TrajectoryPrecision::Float64, 16);
+        for (int i = 0; i < 1000; ++i) {
+            writer.write(0.01 * i, std::vector<double>{std::sin(0.01 * i), std::cos(0.01 * i)});
+        }
+        writer.close();
+        ASSERT_TRUE(writer.records_written() == 1000);
+    }
+    NumLibCpp::TrajectoryData data = NumLibCpp::read_trajectory(path);
+    ASSERT_TRUE(data.state_size == 2 && data.x.size() == 1000 && data.y.size() == 2000);
+    ASSERT_NEAR(data.x[999], 9.99, 0.0);
+    ASSERT_NEAR(data.y[2 * 500 + 1], std::cos(5.0), 0.0);
+    std::cout << "  TrajectoryWriter (float64 round trip): PASSED" << std::endl;
+
+    // Float32 z obserwatorem rk4_solve
+    {
+        NumLibCpp::TrajectoryWriter writer(path, 1, NumLibCpp::TrajectoryPrecision::Float32);
+        NumLibCpp::rk4_solve([](double, double y) { return -y; }, 0.0, 1.0, 2.0, 200,
+                             [&](double x, double y) { writer.write(x, y); });
+    } // Destruktor zamyka plik
+    data = NumLibCpp::read_trajectory(path);
+    ASSERT_TRUE(data.precision == NumLibCpp::TrajectoryPrecision::Float32 && data.x.size() == 201);
+    ASSERT_NEAR(data.y[200], std::exp(-2.0), 1e-6);
+    std::cout << "  TrajectoryWriter (float32 observer): PASSED" << std::endl;
+
+    // Błędne przypadki
+    ASSERT_THROW(NumLibCpp::TrajectoryWriter(path, 0), std::invalid_argument);
+    {
+        NumLibCpp::TrajectoryWriter writer(path, 2);
+        ASSERT_THROW(writer.write(0.0, 1.0), std::invalid_argument);
+        writer.close();
+        ASSERT_THROW(writer.write(0.0, std::vector<double>{1.0, 2.0}), std::runtime_error);
+    }
+    std::remove(path.c_str());
+    ASSERT_THROW(NumLibCpp::read_trajectory(path), std::runtime_error);
+    std::cout << "  TrajectoryWriter (invalid usage): PASSED" << std::endl;
+}
+
+// --- 11. Testy wartości własnych ---
+void test_eigen_solver() {
+    // Macierz sztywności łańcucha n mas: wartości 2 - 2cos(k pi / (n + 1))
+    const int n = 40;
+    std::vector<std::vector<double>> K(n, std::vector<double>(n, 0.0));
+    for (int i = 0; i < n; ++i) {
+        K[i][i] = 2.0;
+        if (i > 0) K[i][i - 1] = K[i - 1][i] = -1.0;
+    }
+    NumLibCpp::SymmetricEigenResult modes = NumLibCpp::symmetric_eigen(K);
+    for (int k = 0; k < n; ++k) {
+        ASSERT_NEAR(modes.values[k], 2.0 - 2.0 * std::cos((k + 1) * M_PI / (n + 1)), 1e-12);
+    }
+    // K v = lambda v oraz ortonormalność wektorów
+    for (int k = 0; k < n; k += 13) {
+        const double* v = modes.vectors.data() + k * n;
+        double norm = 0.0, overlap = 0.0;
+        for (int i = 0; i < n; ++i) {
+            double Kv = 0.0;
+            for (int j = 0; j < n; ++j) Kv += K[i][j] * v[j];
+            ASSERT_NEAR(Kv, modes.values[k] * v[i], 1e-12);
+            norm += v[i] * v[i];
+            overlap += v[i] * modes.vectors[((k + 1) % n) * n + i];
+        }
+        ASSERT_NEAR(norm, 1.0, 1e-12);
+        ASSERT_NEAR(overlap, 0.0, 1e-12);
+    }
+    NumLibCpp::SymmetricEigenResult values_only = NumLibCpp::symmetric_eigen(K, false);
+    ASSERT_TRUE(values_only.vectors.empty());
+    ASSERT_NEAR(values_only.values[n - 1], modes.values[n - 1], 1e-12);
+    std::cout << "  symmetric_eigen (spring chain): PASSED" << std::endl;
+
+    // Macierz niesymetryczna z parą zespoloną: obrót o 90 stopni i wartość 3
+    auto ev = NumLibCpp::general_eigenvalues({{0.0, -1.0, 0.0}, {1.0, 0.0, 0.0}, {1.0, 2.0, 3.0}});
+    ASSERT_TRUE(ev.size() == 3);
+    ASSERT_NEAR(ev[0].real(), 0.0, 1e-12);
+    ASSERT_NEAR(ev[0].imag(), -1.0, 1e-12);
+    ASSERT_NEAR(ev[1].imag(), 1.0, 1e-12);
+    ASSERT_NEAR(ev[2].real(), 3.0, 1e-12);
+    ASSERT_NEAR(ev[2].imag(), 0.0, 0.0);
+    // Macierz pełna: suma wartości własnych równa śladowi
+    std::vector<std::vector<double>> M(30, std::vector<double>(30));
+    double trace = 0.0;
+    for (int i = 0; i < 30; ++i) {
+        for (int j = 0; j < 30; ++j) M[i][j] = std::sin(1.0 + i * 30 + j);
+        trace += M[i][i];
+    }
+    std::complex<double> sum = 0.0;
+    for (const auto& lambda : NumLibCpp::general_eigenvalues(M)) sum += lambda;
+    ASSERT_NEAR(sum.real(), trace, 1e-10);
+    ASSERT_NEAR(sum.imag(), 0.0, 1e-10);
+    std::cout << "  general_eigenvalues (complex pair, trace): PASSED" << std::endl;
+
+    // (x - 1)(x - 2)(x - 3)(x^2 + 1) = x^5 - 6x^4 + 12x^3 - 12x^2 + 11x - 6
+    auto roots = NumLibCpp::polynomial_roots({-6.0, 11.0, -12.0, 12.0, -6.0, 1.0, 0.0});
+    ASSERT_TRUE(roots.size() == 5);
+    ASSERT_NEAR(roots[0].imag(), -1.0, 1e-14);
+    ASSERT_NEAR(roots[1].imag(), 1.0, 1e-14);
+    ASSERT_NEAR(roots[2].real(), 1.0, 1e-14);
+    ASSERT_NEAR(roots[3].real(), 2.0, 1e-14);
+    ASSERT_NEAR(roots[4].real(), 3.0, 1e-14);
+    // Ekstremum wielomianu aproksymującego: pochodna x^2 na [-1, 2] ma pierwiastek w 0
+    std::vector<double> c = NumLibCpp::polynomial_approximation([](double x) { return x * x; }, -1.0, 2.0, 2, 100);
+    auto extremum = NumLibCpp::polynomial_roots({c[1], 2.0 * c[2]});
+    ASSERT_NEAR(extremum[0].real(), 0.0, 1e-9);
+    ASSERT_TRUE(NumLibCpp::polynomial_roots({5.0}).empty());
+    std::cout << "  polynomial_roots (companion matrix): PASSED" << std::endl;
+
+    ASSERT_THROW(NumLibCpp::symmetric_eigen({{1.0, 2.0}}), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::general_eigenvalues({}), std::invalid_argument);
+    ASSERT_THROW(NumLibCpp::polynomial_roots({0.0, 0.0}), std::invalid_argument);
+    std::cout << "  eigen solvers (invalid args): PASSED" << std::endl;
 }
 
 // --- Główna funkcja uruchamiająca testy ---
+// --- 12. Testy instrumentacji ---
+void test_instrumentation() {
+    NumLibCpp::instrumentation_reset();
+    int evaluations = 0;
+    auto counted = [&evaluations](double x) { ++evaluations; return std::exp(x); };
+    NumLibCpp::simpson_integrate(counted, 0.0, 1.0, 100);
+    NumLibCpp::secant_method([](double x) { return x * x - 2.0; }, 1.0, 2.0, 1e-12, 50);
+    NumLibCpp::rk4_solve([](double, double y) { return -y; }, 0.0, 1.0, 1.0, 25);
+    NumLibCpp::gauss_elimination({{1.0, 2.0}, {3.0, 4.0}}, {1.0, 1.0});
+    NumLibCpp::InstrumentationSnapshot snap = NumLibCpp::instrumentation_snapshot();
+    if (NumLibCpp::instrumentation_enabled) {
+        const NumLibCpp::EntryPointStats* simpson = snap.find("simpson_integrate");
+        ASSERT_TRUE(simpson != nullptr && simpson->calls == 1);
+        ASSERT_TRUE(simpson->function_evaluations == static_cast<std::uint64_t>(evaluations));
+        const NumLibCpp::EntryPointStats* rk4 = snap.find("rk4_solve");
+        ASSERT_TRUE(rk4 != nullptr && rk4->iterations == 25 && rk4->function_evaluations == 100);
+        const NumLibCpp::EntryPointStats* secant = snap.find("secant_method");
+        ASSERT_TRUE(secant != nullptr && secant->function_evaluations == secant->iterations + 2);
+        const NumLibCpp::EntryPointStats* gauss = snap.find("gauss_elimination");
+        ASSERT_TRUE(gauss != nullptr && gauss->pivots == 1 && gauss->iterations == 2);
+
+        // Zagnieżdżenie: wywołania f liczone dla simpson_integrate wewnątrz polynomial_approximation
+        NumLibCpp::instrumentation_reset();
+        NumLibCpp::polynomial_approximation([](double x) { return x; }, 0.0, 1.0, 1, 10);
+        snap = NumLibCpp::instrumentation_snapshot();
+        ASSERT_TRUE(snap.find("polynomial_approximation")->calls == 1);
+        ASSERT_TRUE(snap.find("simpson_integrate")->calls == 6);
+        ASSERT_TRUE(snap.find("simpson_integrate")->function_evaluations == 66);
+        ASSERT_TRUE(snap.find("polynomial_approximation")->wall_time_ns >= snap.find("gauss_elimination")->wall_time_ns);
+    } else {
+        ASSERT_TRUE(snap.entries.empty());
+    }
+    std::cout << "  instrumentation_snapshot/instrumentation_reset: PASSED" << std::endl;
+
+    std::ostringstream trace_json;
+    {
+        NumLibCpp::TraceSession trace;
+        ASSERT_THROW(NumLibCpp::TraceSession(), std::runtime_error);
+        NumLibCpp::central_difference([](double x) { return x * x; }, 1.0, 1e-4);
+        trace.stop();
+        NumLibCpp::central_difference([](double x) { return x * x; }, 1.0, 1e-4); // Poza sesją
+        trace.write(trace_json);
+    }
+    const std::string json = trace_json.str();
+    ASSERT_TRUE(json.find("\"traceEvents\"") != std::string::npos);
+    const bool has_event = json.find("\"name\": \"central_difference\"") != std::string::npos;
+    ASSERT_TRUE(has_event == NumLibCpp::instrumentation_enabled);
+    if (NumLibCpp::instrumentation_enabled) {
+        ASSERT_TRUE(json.find("central_difference") == json.rfind("central_difference"));
+    }
+    std::cout << "  TraceSession: PASSED" << std::endl;
+}
+
+// --- 13. Testy areny roboczej (Workspace) ---
+void test_workspace() {
+    NumLibCpp::Workspace ws;
+    double* first = ws.allocate<double>(10);
+    ASSERT_TRUE(reinterpret_cast<std::uintptr_t>(first) % NumLibCpp::Workspace::alignment == 0);
+    {
+        NumLibCpp::Workspace::Frame frame(ws);
+        double* big = ws.allocate<double>(100000); // Nowy, większy blok
+        big[99999] = 1.0;
+        ASSERT_TRUE(ws.used() > 100000 * sizeof(double));
+    }
+    ASSERT_TRUE(ws.used() == 10 * sizeof(double));
+    ws.reset();
+    ASSERT_TRUE(ws.used() == 0 && ws.capacity() >= 100000 * sizeof(double));
+    std::cout << "  Workspace (frames, reset): PASSED" << std::endl;
+
+    // Rozgrzana pętla: te same wyniki co wersje alokujące, zero alokacji
+    const int n = 40;
+    std::vector<std::vector<double>> A(n, std::vector<double>(n));
+    std::vector<double> b(n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) A[i][j] = std::cos(0.3 * i + 0.7 * j);
+        A[i][i] += n;
+        b[i] = std::sin(0.2 * i);
+    }
+    std::vector<double> x;
+    NumLibCpp::gauss_elimination(A, b, x, ws);
+    ASSERT_TRUE(x == NumLibCpp::gauss_elimination(A, b));
+
+    auto f = [](double t) { return std::exp(t) * std::cos(t); };
+    std::vector<double> coeffs;
+    NumLibCpp::polynomial_approximation(f, -1.0, 1.0, 5, 200, coeffs, ws);
+    ASSERT_TRUE(coeffs == NumLibCpp::polynomial_approximation(f, -1.0, 1.0, 5, 200));
+
+    std::vector<double> x_nodes = {0.0, 0.5, 1.0, 1.5, 2.0}, y_nodes = {1.0, 2.0, 0.0, -1.0, 3.0};
+    std::vector<double> points(257), values;
+    for (std::size_t i = 0; i < points.size(); ++i) points[i] = 2.0 * i / (points.size() - 1);
+    NumLibCpp::lagrange_interpolate(x_nodes, y_nodes, points, values, ws);
+    ASSERT_TRUE(values == NumLibCpp::lagrange_interpolate(x_nodes, y_nodes, points));
+
+    std::vector<double> T0(300, 80.0), T(T0);
+    NumLibCpp::EnsembleRhs rhs = [](double, const double* y, double* dy, std::size_t first, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) dy[i] = -0.01 * (first + i + 1) * (y[i] - 20.0);
+    };
+    NumLibCpp::rk4_solve_ensemble_in_place(rhs, 0.0, T, 5.0, 50, NumLibCpp::ExecutionPolicy::Sequential);
+    ASSERT_TRUE(T == NumLibCpp::rk4_solve_ensemble(rhs, 0.0, T0, 5.0, 50));
+
+    const std::size_t before = heap_allocations.load();
+    for (int iter = 0; iter < 20; ++iter) {
+        NumLibCpp::gauss_elimination(A, b, x, ws);
+        NumLibCpp::polynomial_approximation(f, -1.0, 1.0, 5, 200, coeffs, ws);
+        NumLibCpp::lagrange_interpolate(x_nodes, y_nodes, points, values, ws);
+        std::copy(T0.begin(), T0.end(), T.begin());
+        NumLibCpp::rk4_solve_ensemble_in_place(rhs, 0.0, T, 5.0, 50, NumLibCpp::ExecutionPolicy::Sequential);
+    }
+    ASSERT_TRUE(heap_allocations.load() == before);
+    ASSERT_TRUE(ws.used() == 0);
+    std::cout << "  Workspace overloads (zero allocations when warm): PASSED" << std::endl;
+
+    // Błędne dane nie naruszają stanu areny
+    ASSERT_THROW(NumLibCpp::gauss_elimination({{0.0, 0.0}, {0.0, 0.0}}, {1.0, 1.0}, x, ws), std::runtime_error);
+    ASSERT_THROW(NumLibCpp::gauss_elimination_in_place(nullptr, nullptr, 0), std::invalid_argument);
+    ASSERT_TRUE(ws.used() == 0);
+    std::cout << "  Workspace overloads (invalid input): PASSED" << std::endl;
+}
+
+void test_scalar_types() {
+    // Domyślne tolerancje zależne od precyzji typu
+    ASSERT_TRUE(NumLibCpp::default_tolerance<float>() > 1e-6f && NumLibCpp::default_tolerance<float>() < 1e-5f);
+    ASSERT_TRUE(NumLibCpp::default_tolerance<double>() > 1e-12 && NumLibCpp::default_tolerance<double>() < 1e-11);
+    ASSERT_TRUE(NumLibCpp::default_tolerance<long double>() <= NumLibCpp::default_tolerance<double>());
+    ASSERT_TRUE(NumLibCpp::default_difference_step<float>() > NumLibCpp::default_difference_step<double>());
+    std::cout << "  default_tolerance / default_difference_step: PASSED" << std::endl;
+
+    // Układ liniowy: float i long double zgodne z double w granicach precyzji
+    std::vector<std::vector<double>> A = {{4.0, -2.0, 1.0}, {-2.0, 4.0, -2.0}, {1.0, -2.0, 4.0}};
+    std::vector<double> b = {11.0, -16.0, 17.0};
+    std::vector<double> x = NumLibCpp::gauss_elimination(A, b);
+    std::vector<std::vector<float>> A_f = {{4.0f, -2.0f, 1.0f}, {-2.0f, 4.0f, -2.0f}, {1.0f, -2.0f, 4.0f}};
+    std::vector<float> x_f = NumLibCpp::gauss_elimination<float>(A_f, {11.0f, -16.0f, 17.0f});
+    std::vector<std::vector<long double>> A_l = {{4.0L, -2.0L, 1.0L}, {-2.0L, 4.0L, -2.0L}, {1.0L, -2.0L, 4.0L}};
+    std::vector<long double> x_l = NumLibCpp::gauss_elimination<long double>(A_l, {11.0L, -16.0L, 17.0L});
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_NEAR(x_f[i], x[i], 1e-5);
+        ASSERT_NEAR(static_cast<double>(x_l[i]), x[i], 1e-12);
+    }
+    ASSERT_TRUE(NumLibCpp::gauss_elimination<double>(A, b) == x);
+    ASSERT_THROW(NumLibCpp::gauss_elimination<float>({{1.0f, 2.0f}, {2.0f, 4.0f}}, {1.0f, 2.0f}), std::runtime_error);
+    std::cout << "  gauss_elimination<float / long double>: PASSED" << std::endl;
+
+    // Interpolacja (punktowa i wsadowa)
+    std::vector<float> xn_f = {0.0f, 1.0f, 2.0f}, yn_f = {0.0f, 1.0f, 4.0f};
+    float y_f = NumLibCpp::lagrange_interpolate(xn_f, yn_f, 1.5f);
+    ASSERT_NEAR(y_f, 2.25, 1e-6);
+    std::vector<float> ys_f = NumLibCpp::lagrange_interpolate(xn_f, yn_f, std::vector<float>{0.5f, 1.0f, 1.5f});
+    ASSERT_NEAR(ys_f[0], 0.25, 1e-6);
+    ASSERT_TRUE(ys_f[1] == 1.0f);
+    ASSERT_NEAR(ys_f[2], 2.25, 1e-6);
+    std::cout << "  lagrange_interpolate<float>: PASSED" << std::endl;
+
+    // Całkowanie i aproksymacja
+    float integral_f = NumLibCpp::simpson_integrate([](float t) { return std::sin(t); }, 0.0f, 3.14159265f, 100);
+    ASSERT_NEAR(integral_f, 2.0, 1e-5);
+    long double integral_l = NumLibCpp::simpson_integrate([](long double t) { return std::exp(t); }, 0.0L, 1.0L, 1000,
+                                                          NumLibCpp::ExecutionPolicy::Parallel);
+    ASSERT_NEAR(static_cast<double>(integral_l), std::exp(1.0) - 1.0, 1e-13);
+    auto f = [](double t) { return std::exp(t) * std::cos(t); };
+    std::vector<double> coeffs = NumLibCpp::polynomial_approximation(f, -1.0, 1.0, 4, 200);
+    std::vector<long double> coeffs_l = NumLibCpp::polynomial_approximation(
+        [](long double t) { return std::exp(t) * std::cos(t); }, -1.0L, 1.0L, 4, 200);
+    for (std::size_t i = 0; i < coeffs.size(); ++i) {
+        ASSERT_NEAR(static_cast<double>(coeffs_l[i]), coeffs[i], 1e-9);
+    }
+    std::cout << "  simpson_integrate / polynomial_approximation (float, long double): PASSED" << std::endl;
+
+    // Pierwiastki z domyślną tolerancją typu
+    float root_f = NumLibCpp::brent_method([](float t) { return t * t - 2.0f; }, 0.0f, 2.0f);
+    ASSERT_NEAR(root_f, std::sqrt(2.0), 1e-5);
+    long double root_l = NumLibCpp::secant_method([](long double t) { return t * t - 2.0L; }, 1.0L, 2.0L);
+    ASSERT_NEAR(static_cast<double>(root_l), std::sqrt(2.0), 1e-13);
+    std::cout << "  brent_method / secant_method (default tolerance): PASSED" << std::endl;
+
+    // Pochodna z domyślnym krokiem: dla float krok 1e-5 daje błąd rzędu 1e-2
+    float deriv_f = NumLibCpp::central_difference([](float t) { return t * t * t; }, 2.0f);
+    ASSERT_NEAR(deriv_f, 12.0, 1e-3);
+    ASSERT_NEAR(NumLibCpp::central_difference([](double t) { return std::sin(t); }, 0.0), 1.0, 1e-10);
+    std::cout << "  central_difference (default step): PASSED" << std::endl;
+
+    // RK4: pojedyncze równanie i zespół trajektorii
+    float y_rk = NumLibCpp::rk4_solve([](float, float y) { return y; }, 0.0f, 1.0f, 1.0f, 100);
+    ASSERT_NEAR(y_rk, std::exp(1.0), 1e-5);
+    std::vector<float> T0_f(1000, 80.0f);
+    std::vector<double> T0(1000, 80.0);
+    auto rhs_f = [](float, const float* y, float* dy, std::size_t first, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) dy[i] = -0.001f * (first + i + 1) * (y[i] - 20.0f);
+    };
+    auto rhs = [](double, const double* y, double* dy, std::size_t first, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) dy[i] = -0.001 * (first + i + 1) * (y[i] - 20.0);
+    };
+    std::vector<float> T_f = NumLibCpp::rk4_solve_ensemble(rhs_f, 0.0f, T0_f, 2.0f, 40);
+    std::vector<double> T = NumLibCpp::rk4_solve_ensemble(rhs, 0.0, T0, 2.0, 40);
+    for (std::size_t i = 0; i < T.size(); i += 97) {
+        ASSERT_NEAR(T_f[i], T[i], 1e-3);
+    }
+    std::cout << "  rk4_solve / rk4_solve_ensemble<float>: PASSED" << std::endl;
+}
+
 int main() {
     struct TestCase {
         std::string name;
@@ -132,6 +1333,13 @@ int main() {
     ADD_TEST("ODESolver", test_ode_solver);
     ADD_TEST("NonlinearSolver", test_nonlinear_solver);
     ADD_TEST("Differentiation", test_differentiation);
+    ADD_TEST("ThreadPool", test_thread_pool);
+    ADD_TEST("TrajectoryWriter", test_trajectory_writer);
+    ADD_TEST("PDESolver", test_pde_solver);
+    ADD_TEST("EigenSolver", test_eigen_solver);
+    ADD_TEST("Instrumentation", test_instrumentation);
+    ADD_TEST("Workspace", test_workspace);
+    ADD_TEST("ScalarTypes", test_scalar_types);
 
     std::cout << "Running " << tests.size() << " test suites." << std::endl;
 